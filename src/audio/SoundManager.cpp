@@ -1,4 +1,5 @@
 #include "SoundManager.hpp"
+#include "../core/AssetPack.hpp"
 #include <iostream>
 
 SoundManager& SoundManager::instance() {
@@ -54,6 +55,17 @@ void SoundManager::quit() {
 
 bool SoundManager::loadSound(const std::string& id, const std::string& path) {
     if (!initialized) return false;
+    // Cooked PCM plays straight from the asset pack when it is already in the mixer's format
+    AssetPack::Sound cooked;
+    int freq = 0, channels = 0;
+    Uint16 format = 0;
+    if (AssetPack::instance().sound(path, cooked) && Mix_QuerySpec(&freq, &format, &channels) &&
+        freq == cooked.frequency && format == cooked.format && channels == cooked.channels) {
+        if (Mix_Chunk* chunk = Mix_QuickLoad_RAW(const_cast<Uint8*>(cooked.pcm), cooked.length)) {
+            sounds[id] = chunk;
+            return true;
+        }
+    }
     Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
     if (!chunk) {
         std::cerr << "Failed to load sound '" << path << "': " << Mix_GetError() << std::endl;
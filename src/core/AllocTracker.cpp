@@ -0,0 +1,78 @@
+#include "AllocTracker.hpp"
+#include "Profiler.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#ifdef STRANDED_ALLOC_TRACKING
+
+static std::atomic<uint64_t> totalAllocs{0};
+static std::atomic<uint64_t> totalBytes{0};
+// Plain integers: zero-initialized, so touching them from operator new never allocates
+static thread_local uint64_t threadAllocs = 0;
+static thread_local uint64_t threadBytes = 0;
+
+static void* trackedAlloc(std::size_t size) {
+    totalAllocs.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+    ++threadAllocs;
+    threadBytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+AllocCounts AllocTracker::total() {
+    return AllocCounts{totalAllocs.load(std::memory_order_relaxed), totalBytes.load(std::memory_order_relaxed)};
+}
+
+AllocCounts AllocTracker::thisThread() {
+    return AllocCounts{threadAllocs, threadBytes};
+}
+
+#else
+
+AllocCounts AllocTracker::total() { return AllocCounts{}; }
+AllocCounts AllocTracker::thisThread() { return AllocCounts{}; }
+
+#endif
+
+AllocTracker& AllocTracker::instance() {
+    static AllocTracker inst;
+    return inst;
+}
+
+void AllocTracker::beginFrame() {
+    frameStart = total();
+}
+
+void AllocTracker::endFrame(uint64_t frameIndex) {
+    lastFrame = total() - frameStart;
+    if (frameBudget == 0 || lastFrame.allocs <= frameBudget) return;
+    ++framesOverBudget;
+    ++unreportedOverBudget;
+    uint64_t now = Profiler::nowMicros();
+    if (lastReportMicros != 0 && now - lastReportMicros < 1000000) return;
+    std::cerr << "Warning: frame " << frameIndex << " made " << lastFrame.allocs << " allocations ("
+              << lastFrame.bytes << " bytes), budget " << frameBudget << "; "
+              << unreportedOverBudget << " frame(s) over budget since last report\n";
+    unreportedOverBudget = 0;
+    lastReportMicros = now;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+struct AllocCounts {
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+inline AllocCounts operator-(const AllocCounts& a, const AllocCounts& b) {
+    return AllocCounts{a.allocs - b.allocs, a.bytes - b.bytes};
+}
+
+// Heap allocation counters fed by the replacement global operator new in
+// AllocTracker.cpp. The hook only exists when STRANDED_ALLOC_TRACKING is
+// defined (CMake option of the same name, off by default); without it every
+// count stays zero and frames are never flagged.
+//
+// Counts are per thread (for profiler zones) and over all threads (for frames).
+// A frame that allocates more than the configured budget is reported on stderr,
+// at most once a second, so steady-state allocations can be driven to zero.
+class AllocTracker {
+public:
+    static constexpr bool enabled() {
+#ifdef STRANDED_ALLOC_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static AllocTracker& instance();
+
+    // Totals since startup, over every thread / on the calling thread only
+    static AllocCounts total();
+    static AllocCounts thisThread();
+
+    // Allocations allowed per frame before it is flagged; 0 disables the check
+    void setFrameBudget(uint64_t allocs) { frameBudget = allocs; }
+    uint64_t getFrameBudget() const { return frameBudget; }
+
+    // Bracket one frame on the main thread
+    void beginFrame();
+    void endFrame(uint64_t frameIndex);
+
+    AllocCounts getLastFrame() const { return lastFrame; }
+    uint64_t getFramesOverBudget() const { return framesOverBudget; }
+
+private:
+    AllocTracker() = default;
+
+    uint64_t frameBudget = 0;
+    AllocCounts frameStart;
+    AllocCounts lastFrame;
+    uint64_t framesOverBudget = 0;
+    uint64_t unreportedOverBudget = 0;
+    uint64_t lastReportMicros = 0;
+};
@@ -0,0 +1,177 @@
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string entryKey(const std::string& name, uint32_t type, uint32_t minClusterSize = 0) {
+    std::string k = name;
+    k.push_back('\0');
+    k.push_back(static_cast<char>('0' + type));
+    if (type == ASSET_HITBOXES) k += std::to_string(minClusterSize);
+    return k;
+}
+
+} // namespace
+
+AssetPack& AssetPack::instance() {
+    static AssetPack inst;
+    return inst;
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+std::string AssetPack::key(const std::string& path) {
+    std::string k;
+    k.reserve(path.size());
+    for (char c : path) {
+        k.push_back(c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    while (k.compare(0, 2, "./") == 0) k.erase(0, 2);
+    return k;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!view) {
+        std::cerr << "Warning: could not map asset pack '" << path << "'\n";
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // the mapping stays valid
+    if (view == MAP_FAILED) {
+        std::cerr << "Warning: could not map asset pack '" << path << "'\n";
+        return false;
+    }
+    base = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(st.st_size);
+#endif
+
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(base);
+    bool valid = mappedSize >= sizeof(AssetPackHeader) && header->magic == ASSET_PACK_MAGIC &&
+                 header->version == ASSET_PACK_VERSION &&
+                 header->entryCount <= (mappedSize - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry);
+    if (valid) {
+        const AssetPackEntry* table = reinterpret_cast<const AssetPackEntry*>(base + sizeof(AssetPackHeader));
+        for (uint32_t i = 0; i < header->entryCount && valid; ++i) {
+            const AssetPackEntry& e = table[i];
+            valid = std::memchr(e.name, '\0', ASSET_PACK_NAME_SIZE) != nullptr &&
+                    e.offset <= mappedSize && e.size <= mappedSize - e.offset;
+            if (e.type == ASSET_SPRITE) valid = valid && e.size >= static_cast<uint64_t>(e.params[0]) * e.params[1] * 4;
+            if (valid) entries[entryKey(e.name, e.type, e.type == ASSET_HITBOXES ? e.params[2] : 0)] = &e;
+        }
+    }
+    if (!valid) {
+        std::cerr << "Warning: '" << path << "' is not a valid asset pack (version " << ASSET_PACK_VERSION << "), loading loose files\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    entries.clear();
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(base), mappedSize);
+#endif
+    base = nullptr;
+    mappedSize = 0;
+}
+
+const AssetPackEntry* AssetPack::find(const std::string& path, AssetPackType type) const {
+    auto it = entries.find(entryKey(key(path), type));
+    return it != entries.end() ? it->second : nullptr;
+}
+
+SDL_Surface* AssetPack::sprite(const std::string& path) const {
+    const AssetPackEntry* e = find(path, ASSET_SPRITE);
+    if (!e) return nullptr;
+    int w = static_cast<int>(e->params[0]), h = static_cast<int>(e->params[1]);
+    // SDL only reads the pixels of a surface it did not allocate unless asked to draw into it
+    void* pixels = const_cast<uint8_t*>(base + e->offset);
+    return SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, 32, w * 4, SDL_PIXELFORMAT_ARGB8888);
+}
+
+bool AssetPack::hitboxes(const std::string& path, int minClusterSize, Hitboxes& out) const {
+    auto it = entries.find(entryKey(key(path), ASSET_HITBOXES, static_cast<uint32_t>(minClusterSize)));
+    if (it == entries.end()) return false;
+    const AssetPackEntry* e = it->second;
+    out.boxes = reinterpret_cast<const float*>(base + e->offset);
+    out.count = static_cast<uint32_t>(e->size / (4 * sizeof(float)));
+    out.surfaceWidth = static_cast<int>(e->params[0]);
+    out.surfaceHeight = static_cast<int>(e->params[1]);
+    return true;
+}
+
+bool AssetPack::sound(const std::string& path, Sound& out) const {
+    const AssetPackEntry* e = find(path, ASSET_SOUND);
+    if (!e) return false;
+    out.pcm = base + e->offset;
+    out.length = static_cast<uint32_t>(e->size);
+    out.frequency = static_cast<int>(e->params[0]);
+    out.format = static_cast<uint16_t>(e->params[1]);
+    out.channels = static_cast<int>(e->params[2]);
+    return true;
+}
+
+std::vector<std::string> AssetPack::spriteNames() const {
+    std::vector<std::string> names;
+    if (!base) return names;
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(base);
+    const AssetPackEntry* table = reinterpret_cast<const AssetPackEntry*>(base + sizeof(AssetPackHeader));
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        if (table[i].type == ASSET_SPRITE) names.emplace_back(table[i].name);
+    }
+    return names;
+}
+
+SDL_Surface* loadSpriteSurface(const char* path) {
+    if (SDL_Surface* packed = AssetPack::instance().sprite(path)) return packed;
+    return SDL_LoadBMP(path);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Cooked assets in one file, written by StrandedAssetCooker (tools/assetcooker)
+// and memory-mapped at startup. Everything is stored ready to use, so loading
+// an asset from the pack reads no file and decodes nothing:
+//   sprite    ARGB8888 pixels, rows of width * 4 bytes
+//   hitboxes  ICollidable::autoDetectHitboxes of a sprite, float x0 y0 x1 y1 per box
+//   sound     PCM in the mixer's output format
+//
+// Layout: AssetPackHeader, AssetPackEntry[entryCount], then the data of each
+// entry at its offset (16-byte aligned). Names are the asset path lowercased,
+// with '/' separators and no leading "./" (see AssetPack::key), so lookups
+// match the case-insensitive paths the game uses on Windows.
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4B415053; // 'SPAK'
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr size_t ASSET_PACK_NAME_SIZE = 64;
+
+enum AssetPackType : uint32_t {
+    ASSET_SPRITE = 1,
+    ASSET_HITBOXES = 2,
+    ASSET_SOUND = 3,
+};
+
+#pragma pack(push, 1)
+struct AssetPackHeader {
+    uint32_t magic; // 'SPAK'
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct AssetPackEntry {
+    char name[ASSET_PACK_NAME_SIZE]; // NUL-terminated
+    uint32_t type;                   // AssetPackType
+    uint64_t offset;                 // from the start of the file
+    uint64_t size;
+    // sprite: width, height; hitboxes: surface width, height, minClusterSize;
+    // sound: frequency, SDL audio format, channels
+    uint32_t params[3];
+};
+#pragma pack(pop)
+
+// The pack opened for this run; nothing is packed until open() succeeds.
+// Lookups are safe from any thread once open() has returned.
+class AssetPack {
+public:
+    struct Hitboxes {
+        const float* boxes = nullptr; // x0 y0 x1 y1 per box
+        uint32_t count = 0;
+        int surfaceWidth = 0;
+        int surfaceHeight = 0;
+    };
+
+    struct Sound {
+        const uint8_t* pcm = nullptr;
+        uint32_t length = 0;
+        int frequency = 0;
+        uint16_t format = 0;
+        int channels = 0;
+    };
+
+    static AssetPack& instance();
+
+    // False when the file is missing; warns when it exists but is not a valid pack
+    bool open(const std::string& path);
+    // Data handed out before stays mapped until this is called
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // A surface over the packed pixels (no copy, read-only), nullptr when not
+    // packed. Free it with SDL_FreeSurface; the pixels belong to the pack.
+    SDL_Surface* sprite(const std::string& path) const;
+    bool hitboxes(const std::string& path, int minClusterSize, Hitboxes& out) const;
+    bool sound(const std::string& path, Sound& out) const;
+
+    // Names of every packed sprite, in pack order
+    std::vector<std::string> spriteNames() const;
+
+    // Pack name of an asset path: "./sprites/Fish.bmp" -> "sprites/fish.bmp"
+    static std::string key(const std::string& path);
+
+private:
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    const AssetPackEntry* find(const std::string& path, AssetPackType type) const;
+
+    const uint8_t* base = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    // key + type -> entry; hitboxes also carry their minClusterSize in the key
+    std::unordered_map<std::string, const AssetPackEntry*> entries;
+};
+
+// Loads a sprite from the open pack, or from the BMP file when it is not packed.
+// Callers free the surface with SDL_FreeSurface. Safe from any thread.
+SDL_Surface* loadSpriteSurface(const char* path);
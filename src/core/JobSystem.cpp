@@ -0,0 +1,170 @@
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+
+// Index of the queue the current thread owns; 0 for threads outside the pool
+static thread_local size_t workerQueueIndex = 0;
+
+JobSystem& JobSystem::instance() {
+    static JobSystem inst;
+    return inst;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::start(int workerCount) {
+    shutdown();
+    if (workerCount < 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? static_cast<int>(hw) - 1 : 0;
+    }
+    stopping = false;
+    queues.clear();
+    for (int i = 0; i <= workerCount; ++i) queues.push_back(std::make_unique<Worker>());
+    for (int i = 1; i <= workerCount; ++i) {
+        workers.emplace_back([this, i] { workerLoop(static_cast<size_t>(i)); });
+    }
+}
+
+void JobSystem::shutdown() {
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+    workers.clear();
+    // Anything still queued runs here so no waiter is left hanging
+    if (!queues.empty()) {
+        while (Handle job = take(0)) run(job);
+    }
+}
+
+size_t JobSystem::currentQueue() {
+    if (workerQueueIndex != 0) return workerQueueIndex;
+    // Outside the pool: spread submissions so workers find them without stealing
+    if (workers.empty()) return 0;
+    return nextExternal.fetch_add(1, std::memory_order_relaxed) % queues.size();
+}
+
+JobSystem::Handle JobSystem::submit(std::function<void()> fn, const std::vector<Handle>& dependsOn) {
+    if (queues.empty()) queues.push_back(std::make_unique<Worker>()); // not started: run on waiters
+    Handle job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+    for (const Handle& dep : dependsOn) {
+        if (!dep) continue;
+        std::lock_guard<std::mutex> guard(dep->lock);
+        if (dep->finished) continue;
+        job->unresolved.fetch_add(1);
+        dep->continuations.push_back(job);
+    }
+    if (job->unresolved.fetch_sub(1) == 1) schedule(job);
+    return job;
+}
+
+void JobSystem::schedule(Handle job) {
+    Worker& w = *queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> guard(w.lock);
+        w.queue.push_back(std::move(job));
+    }
+    queued.fetch_add(1);
+    if (!workers.empty()) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_one();
+    }
+}
+
+JobSystem::Handle JobSystem::take(size_t self) {
+    {
+        Worker& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.queue.empty()) {
+            Handle job = std::move(own.queue.back());
+            own.queue.pop_back();
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    // Steal the oldest job of the next non-empty queue
+    for (size_t i = 1; i < queues.size(); ++i) {
+        Worker& victim = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.queue.empty()) {
+            Handle job = std::move(victim.queue.front());
+            victim.queue.pop_front();
+            queued.fetch_sub(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::run(const Handle& job) {
+    {
+        PROFILE_ZONE("job");
+        job->fn();
+    }
+    job->fn = nullptr; // release captures now, handles may outlive the frame
+    std::vector<Handle> ready;
+    {
+        std::lock_guard<std::mutex> guard(job->lock);
+        job->finished = true;
+        ready.swap(job->continuations);
+    }
+    for (Handle& next : ready) {
+        if (next->unresolved.fetch_sub(1) == 1) schedule(std::move(next));
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    workerQueueIndex = index;
+    PROFILE_THREAD_NAME("worker " + std::to_string(index));
+    while (true) {
+        if (Handle job = take(index)) {
+            run(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping) return;
+    }
+}
+
+bool JobSystem::isDone(const Handle& job) {
+    return !job || job->finished.load();
+}
+
+void JobSystem::wait(const Handle& job) {
+    size_t self = workerQueueIndex;
+    while (!isDone(job)) {
+        // Help out instead of blocking; the awaited job may be sitting in a queue
+        if (Handle other = take(self)) run(other);
+        else std::this_thread::yield();
+    }
+}
+
+void JobSystem::waitAll(const std::vector<Handle>& jobs) {
+    for (const Handle& job : jobs) wait(job);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+    std::vector<Handle> slices;
+    slices.reserve((count + grain - 1) / grain);
+    for (size_t begin = grain; begin < count; begin += grain) {
+        size_t end = std::min(count, begin + grain);
+        slices.push_back(submit([&fn, begin, end] { fn(begin, end); }));
+    }
+    fn(0, std::min(count, grain)); // first slice on the calling thread
+    waitAll(slices);
+}
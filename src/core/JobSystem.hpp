@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool for per-frame engine work (chunk planning,
+// collision tests, particle updates). Each worker owns a deque: it pushes and
+// pops at the back (newest first, cache-warm), idle workers steal from the
+// front of other deques. Jobs may depend on other jobs; a job only becomes
+// runnable once everything it depends on has finished.
+//
+// Jobs must not touch SDL rendering, the game object list or the network;
+// they compute results that the main thread applies after wait(). A thread
+// that waits runs queued jobs meanwhile, so with zero workers everything
+// still completes on the calling thread.
+class JobSystem {
+    struct Job;
+
+public:
+    using Handle = std::shared_ptr<Job>;
+
+    static JobSystem& instance();
+
+    // workerCount < 0 picks hardware threads - 1 (the main thread also runs jobs);
+    // 0 runs every job on the threads that wait for it
+    void start(int workerCount = -1);
+    void shutdown();
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    Handle submit(std::function<void()> fn, const std::vector<Handle>& dependsOn = {});
+    void wait(const Handle& job);
+    void waitAll(const std::vector<Handle>& jobs);
+    static bool isDone(const Handle& job);
+
+    // Calls fn(begin, end) over [0, count) in slices of at most grain items and
+    // returns once every slice ran. Small ranges run inline.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    ~JobSystem();
+
+private:
+    JobSystem() = default;
+
+    struct Job {
+        std::function<void()> fn;
+        std::atomic<int> unresolved{1}; // unfinished dependencies + 1 while being submitted
+        std::atomic<bool> finished{false};
+        std::mutex lock; // guards continuations against a racing finish
+        std::vector<Handle> continuations;
+    };
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<Handle> queue;
+    };
+
+    void schedule(Handle job);
+    Handle take(size_t self);
+    void run(const Handle& job);
+    void workerLoop(size_t index);
+    size_t currentQueue();
+
+    // Queue 0 belongs to the threads that are not workers (the main thread)
+    std::vector<std::unique_ptr<Worker>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> queued{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<unsigned> nextExternal{0};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+};
@@ -0,0 +1,105 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+Profiler& Profiler::instance() {
+    static Profiler inst;
+    return inst;
+}
+
+Profiler::ThreadRing& Profiler::ringForThisThread() {
+    // The registry keeps the ring alive after its thread exits so dumps can still read it
+    static thread_local ThreadRing* ring = nullptr;
+    if (!ring) {
+        std::lock_guard<std::mutex> guard(registryLock);
+        auto created = std::make_shared<ThreadRing>();
+        created->tid = static_cast<uint32_t>(rings.size() + 1);
+        created->name = "thread " + std::to_string(created->tid);
+        rings.push_back(created);
+        ring = created.get();
+    }
+    return *ring;
+}
+
+static uint32_t clampU32(uint64_t v) {
+    return static_cast<uint32_t>(std::min<uint64_t>(v, UINT32_MAX));
+}
+
+void Profiler::record(const char* name, uint64_t startUs, uint64_t endUs, AllocCounts allocs) {
+    ThreadRing& ring = ringForThisThread();
+    uint64_t index = ring.head.load(std::memory_order_relaxed);
+    ring.events[index % RING_CAPACITY] = Event{name, startUs, clampU32(endUs - startUs), clampU32(allocs.allocs), clampU32(allocs.bytes)};
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadRing& ring = ringForThisThread();
+    std::lock_guard<std::mutex> guard(registryLock);
+    ring.name = name;
+}
+
+static void writeJsonString(FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::vector<std::shared_ptr<ThreadRing>> snapshot;
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        snapshot = rings;
+    }
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        std::cerr << "Warning: could not write trace '" << path << "'\n";
+        return false;
+    }
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    size_t written = 0;
+    for (const auto& ring : snapshot) {
+        std::string name;
+        {
+            std::lock_guard<std::mutex> guard(registryLock);
+            name = ring->name;
+        }
+        std::fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", ring->tid);
+        writeJsonString(f, name.c_str());
+        std::fprintf(f, "}}");
+        first = false;
+
+        // The owning thread may keep recording: copy what is published, then drop
+        // anything it could have overwritten while we copied, including the slot
+        // at headAfter it may be writing right now
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        std::vector<Event> copy;
+        copy.reserve(static_cast<size_t>(head - begin));
+        for (uint64_t i = begin; i < head; ++i) copy.push_back(ring->events[i % RING_CAPACITY]);
+        uint64_t headAfter = ring->head.load(std::memory_order_acquire);
+        size_t skip = headAfter + 1 > RING_CAPACITY + begin ? static_cast<size_t>(headAfter + 1 - RING_CAPACITY - begin) : 0;
+
+        for (size_t i = std::min(skip, copy.size()); i < copy.size(); ++i) {
+            const Event& e = copy[i];
+            std::fprintf(f, ",\n{\"ph\":\"X\",\"name\":");
+            writeJsonString(f, e.name);
+            std::fprintf(f, ",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u", ring->tid,
+                static_cast<unsigned long long>(e.startUs), e.durationUs);
+            if (AllocTracker::enabled()) std::fprintf(f, ",\"args\":{\"allocs\":%u,\"bytes\":%u}", e.allocs, e.allocBytes);
+            std::fprintf(f, "}");
+            ++written;
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    bool ok = std::ferror(f) == 0;
+    std::fclose(f);
+    if (ok) std::cout << "Wrote " << written << " trace events to " << path << "\n";
+    return ok;
+}
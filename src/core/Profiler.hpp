@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AllocTracker.hpp"
+
+// Scoped frame profiler. PROFILE_ZONE("name") times the enclosing scope and
+// stores it in a ring buffer owned by the calling thread (no locks on the hot
+// path). writeChromeTrace() dumps what the rings still hold as Chrome
+// trace_event JSON, which chrome://tracing and ui.perfetto.dev open directly.
+//
+// Zones only exist when STRANDED_PROFILE is defined (CMake option
+// STRANDED_PROFILER, off in Release builds); otherwise the macro is empty.
+// Zone names must be string literals, only the pointer is stored.
+// With STRANDED_ALLOC_TRACKING each zone also records the heap allocations its
+// thread made inside it, shown as args in the trace viewer.
+class Profiler {
+public:
+    // Events kept per thread; older ones are overwritten (about 20 s of frames at 60 fps)
+    static constexpr size_t RING_CAPACITY = 1 << 16;
+
+    static Profiler& instance();
+
+    static uint64_t nowMicros() {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    void record(const char* name, uint64_t startUs, uint64_t endUs, AllocCounts allocs = AllocCounts{});
+    // Names the calling thread in traces ("main", "worker 3")
+    void setThreadName(const std::string& name);
+
+    // Returns false when the file could not be written
+    bool writeChromeTrace(const std::string& path);
+
+private:
+    Profiler() = default;
+
+    struct Event {
+        const char* name;
+        uint64_t startUs;
+        uint32_t durationUs;
+        uint32_t allocs;
+        uint32_t allocBytes;
+    };
+
+    // Written only by its own thread; head is published with release so a dump sees complete events
+    struct ThreadRing {
+        uint32_t tid = 0;
+        std::string name;
+        std::vector<Event> events = std::vector<Event>(RING_CAPACITY);
+        std::atomic<uint64_t> head{0};
+    };
+
+    ThreadRing& ringForThisThread();
+
+    std::mutex registryLock; // guards rings and names, never taken by record() after the first call per thread
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name(name), startAllocs(AllocTracker::thisThread()), startUs(Profiler::nowMicros()) {}
+    ~ProfileZone() { end(); }
+
+    // Ends the zone before the scope does (for ranges of statements that are not a block)
+    void end() {
+        if (!name) return;
+        uint64_t endUs = Profiler::nowMicros();
+        Profiler::instance().record(name, startUs, endUs, AllocTracker::thisThread() - startAllocs);
+        name = nullptr;
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    AllocCounts startAllocs;
+    uint64_t startUs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef STRANDED_PROFILE
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_ZONE_NAMED(var, name) ProfileZone var(name)
+#define PROFILE_ZONE_END(var) var.end()
+#define PROFILE_THREAD_NAME(name) Profiler::instance().setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_ZONE_NAMED(var, name) ((void)0)
+#define PROFILE_ZONE_END(var) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
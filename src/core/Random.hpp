@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Every gameplay RNG is seeded from one session seed so a recorded session
+// (see NetRecorder) replays identically. Set the seed once at startup, before
+// any game objects exist; RNGs then take nextRandomSeed() in creation order.
+
+inline uint32_t& sessionSeedState() {
+    static uint32_t seed = 0x5EED5EEDu;
+    return seed;
+}
+
+inline uint64_t& sessionSeedCounter() {
+    static uint64_t counter = 0;
+    return counter;
+}
+
+inline void setSessionSeed(uint32_t seed) {
+    sessionSeedState() = seed;
+    sessionSeedCounter() = 0;
+}
+
+inline uint32_t getSessionSeed() {
+    return sessionSeedState();
+}
+
+// Next seed in the session's deterministic sequence (splitmix64 over seed + counter)
+inline uint32_t nextRandomSeed() {
+    uint64_t z = (static_cast<uint64_t>(sessionSeedState()) << 32) + (++sessionSeedCounter()) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
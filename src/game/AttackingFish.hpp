@@ -2,11 +2,17 @@
 
 #include "ICollidable.hpp"
 #include "FishProjectile.hpp"
+#include "ObjectPool.hpp"
+#include "Registered.hpp"
+#include "SpriteCache.hpp"
+#include "UpdatePhase.hpp"
+#include "World.hpp"
 #include "Vector2.hpp"
 #include <SDL.h>
 #include <SDL_net.h>
 #include <algorithm>
 #include <random>
+#include "../core/Random.hpp"
 
 // AttackingFish: spawns, waits a short randomized delay, then throws a FishProjectile
 // that chases the player. After throwing, the fish switches to "AttackingFish2.bmp".
@@ -18,19 +24,19 @@ extern void hostBroadcastFishProjectile(uint32_t projectileId, uint32_t ownerEnt
 extern Player* getOrCreateRemotePlayer(uint32_t id);
 extern uint32_t clientId;
 
-class AttackingFish : public ICollidable {
+class AttackingFish : public ICollidable, public Registered<AttackingFish>, public Pooled<AttackingFish> {
 private:
     SDL_Renderer* renderer = nullptr;
     float nextFireTimer = 2.0f; // time until next shot
     int shotsRemaining = 10; // number of shots this fish can fire (can be tuned)
     uint32_t entityId = 0;
     uint32_t ownerPlayerId = 0; // player who triggered/spawned this fish
-    std::mt19937 rng{static_cast<uint32_t>(SDL_GetTicks())};
+    std::mt19937 rng{nextRandomSeed()};
     bool spriteChangedAfterFirstThrow = false;
 public:
     AttackingFish(const Vector2& pos, SDL_Renderer* renderer, uint32_t entityId = 0, uint32_t ownerId = 0, int zIndex = 4)
-        : ICollidable(pos, {2.0f, 2.0f}, "./sprites/AttackingFish1.bmp", renderer, true, zIndex), renderer(renderer), entityId(entityId), ownerPlayerId(ownerId)
-         ,GameObject(pos, {2.0f, 2.0f}, "./sprites/AttackingFish1.bmp", renderer, zIndex)
+        : ICollidable(pos, {2.0f, 2.0f}, SpriteCache::instance().texture(renderer, "./sprites/AttackingFish1.bmp"), "./sprites/AttackingFish1.bmp", renderer, true, zIndex), renderer(renderer), entityId(entityId), ownerPlayerId(ownerId)
+         ,GameObject(pos, {2.0f, 2.0f}, SpriteCache::instance().texture(renderer, "./sprites/AttackingFish1.bmp"), renderer, zIndex)
     {
         // Randomize initial fire delay slightly
         std::uniform_real_distribution<float> dist(0.5f, 1.8f);
@@ -42,41 +48,48 @@ public:
         setPosition({ pos.x - sz.x / 2.0f, pos.y - sz.y / 2.0f });
     }
 
+    bool updatesInParallel() const override { return true; }
+
     void update(float dt) override {
         if (shotsRemaining <= 0) return;
         nextFireTimer -= dt;
         if (nextFireTimer <= 0.0f && shotsRemaining > 0) {
-            // Fire a chasing fish projectile at the global player if present
-            extern Player* player; // declared in main.cpp
+            // Spawning, player lookup and the broadcast touch shared state: run them after the update phase.
+            // Only `this` is captured so the command is stored without allocating; nothing moves the
+            // fish before the buffers run, and shotsRemaining is already decremented by then.
+            UpdatePhase::defer([this] {
+                // Start projectile from the fish center (mouth)
+                Vector2 start = { getWorldPosition().x + getSize()->x / 2.0f, getWorldPosition().y + getSize()->y / 2.0f };
+                int shotsLeft = shotsRemaining;
 
-            // Start projectile from the fish center (mouth)
-            Vector2 start = { getWorldPosition().x + getSize()->x / 2.0f, getWorldPosition().y + getSize()->y / 2.0f };
-            // Determine target player by ownerPlayerId
-            Player* targetPlayer = nullptr;
-            if (ownerPlayerId == clientId) targetPlayer = player;
-            else targetPlayer = getOrCreateRemotePlayer(ownerPlayerId);
+                // Fire a chasing fish projectile at the global player if present
+                extern Player* player; // declared in main.cpp
 
-            // Only host (or single-player where udpSocket==NULL) should create authoritative projectile and broadcast it
-            extern std::vector<GameObject*> gameObjects;
-            if (isHost || udpSocket == nullptr) {
-                FishProjectile* fp = new FishProjectile(start, {1.0f,1.0f}, "./sprites/FishProjectile.bmp", renderer, 4);
-                fp->fire(start, targetPlayer ? targetPlayer : player);
-                if (std::find(gameObjects.begin(), gameObjects.end(), fp) == gameObjects.end()) {
-                    gameObjects.push_back(fp);
-                }
-                // If host, broadcast spawn to clients
-                if (isHost && udpSocket) {
-                    extern uint32_t nextProjectileId;
-                    uint32_t pid = nextProjectileId++;
-                    uint32_t targetPid = getPlayerId(targetPlayer ? targetPlayer : player);
-                    hostBroadcastFishProjectile(pid, entityId, targetPid, start.x, start.y);
+                // Determine target player by ownerPlayerId
+                Player* targetPlayer = nullptr;
+                if (ownerPlayerId == clientId) targetPlayer = player;
+                else targetPlayer = getOrCreateRemotePlayer(ownerPlayerId);
+
+                // Only host (or single-player where udpSocket==NULL) should create authoritative projectile and broadcast it
+                extern World gameObjects;
+                if (isHost || udpSocket == nullptr) {
+                    FishProjectile* fp = new FishProjectile(start, {1.0f,1.0f}, "./sprites/FishProjectile.bmp", renderer, 4);
+                    fp->fire(start, targetPlayer ? targetPlayer : player);
+                    gameObjects.add(fp);
+                    // If host, broadcast spawn to clients
+                    if (isHost && udpSocket) {
+                        extern uint32_t nextProjectileId;
+                        uint32_t pid = nextProjectileId++;
+                        uint32_t targetPid = getPlayerId(targetPlayer ? targetPlayer : player);
+                        hostBroadcastFishProjectile(pid, entityId, targetPid, start.x, start.y);
+                    }
+                    SDL_Log("AttackingFish: host created projectile at (%.2f,%.2f) targetOwner=%u shotsLeft=%d", start.x, start.y, ownerPlayerId, shotsLeft);
                 }
-                SDL_Log("AttackingFish: host created projectile at (%.2f,%.2f) targetOwner=%u shotsLeft=%d", start.x, start.y, ownerPlayerId, shotsRemaining - 1);
-            }
+            });
 
-            // Change sprite on the first throw
+            // Change sprite on the first throw (the sprite cache is main thread only)
             if (!spriteChangedAfterFirstThrow) {
-                setSprite("./sprites/AttackingFish2.bmp", renderer);
+                UpdatePhase::defer([this] { setSprite(SpriteCache::instance().texture(renderer, "./sprites/AttackingFish2.bmp")); });
                 spriteChangedAfterFirstThrow = true;
             }
 
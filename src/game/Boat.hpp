@@ -16,7 +16,7 @@ class Boat : public IAnimatable,public IInteractable {
     float lastDeltaTime;
     public:
     Boat(Vector2 pos,Vector2 sizeMultiplier,const char* spritePath[], int frameCount, SDL_Renderer* renderer,float animationStep, int zIndex,std::set<SDL_Keycode> interactKeys, bool* navUIPtr )
-        : GameObject(pos, sizeMultiplier, spritePath[0], renderer, zIndex),
+        : GameObject(pos, sizeMultiplier, static_cast<SDL_Texture*>(nullptr), renderer, zIndex), // IAnimatable sets the frame
           IAnimatable(pos, sizeMultiplier, spritePath, frameCount, renderer, animationStep, zIndex),
           ICollidable(pos,sizeMultiplier,spritePath[0],renderer,true,zIndex),
           IInteractable(pos,sizeMultiplier,spritePath[0],renderer,true,zIndex,interactKeys),
@@ -44,18 +44,16 @@ class Boat : public IAnimatable,public IInteractable {
     
     void boardBoat(Player* player) {
         if (player && player->getParent() != this) {
-            // Store player's current world position
+            // Store player's current world transform
             Vector2 worldPos = player->getWorldPosition();
-            
-            // Store boat's world position before adding child
-            Vector2 boatWorld = getWorldPosition();
+            float worldRot = player->getWorldRotation();
             
             // Add player as child
             addChild(player);
             
-            // Calculate local position (world position - boat's world position)
-            player->getPosition()->x = worldPos.x - boatWorld.x;
-            player->getPosition()->y = worldPos.y - boatWorld.y;
+            // Same place and heading in the boat's frame, which may be turned
+            player->setPosition(player->worldToLocal(worldPos));
+            player->setRotation(worldRot - getWorldRotation());
             
             SDL_Log("Player boarded the boat");
         }
@@ -63,15 +61,16 @@ class Boat : public IAnimatable,public IInteractable {
     
     void leaveBoat(Player* player) {
         if (player && player->getParent() == this) {
-            // Store player's current world position
+            // Store player's current world transform
             Vector2 worldPos = player->getWorldPosition();
+            float worldRot = player->getWorldRotation();
             
             // Remove player as child
             removeChild(player);
             
-            // Set to absolute world position
-            player->getPosition()->x = worldPos.x;
-            player->getPosition()->y = worldPos.y;
+            // Set to absolute world position and heading
+            player->setPosition(worldPos);
+            player->setRotation(worldRot);
             
             SDL_Log("Player left the boat");
         }
@@ -90,8 +89,7 @@ class Boat : public IAnimatable,public IInteractable {
     }
     
     void setBoatState(float x, float y, float rot, float navDirX, float navDirY, bool moving) {
-        getPosition()->x = x;
-        getPosition()->y = y;
+        setPosition({x, y});
         setRotation(rot);
         navigationDirection.x = navDirX;
         navigationDirection.y = navDirY;
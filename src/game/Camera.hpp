@@ -7,8 +7,10 @@
 #include "GameObject.hpp"
 #include <algorithm>
 #include "UIGameObject.hpp"
+#include "TileLayer.hpp"
 #include "Player.hpp"
-#include "Lighthouse.hpp"
+#include "Lighting.hpp"
+#include "PerfHud.hpp"
 #include <unordered_map>
 
 // Externs from main.cpp used to draw healthbars and scene lighting
@@ -16,27 +18,24 @@ extern Player* player;
 extern std::unordered_map<uint32_t, Player*> remotePlayers;
 extern float g_sunIntensity;
 
-// Lighthouse glow configuration (tweakable at runtime)
-extern float g_lighthouseGlowBaseRadius;      // base radius (pixels) when it's bright
-extern float g_lighthouseGlowExtraRadius;     // extra radius added when fully dark
-extern float g_lighthouseGlowIntensityMultiplier; // multiplier applied to alpha/intensity
-extern float g_dayTimeSeconds; // for subtle pulsing of lights
-
 
 class Camera{
     private:
         Vector2 position;
         Vector2 displaySize;
-        GameObject* toFollow;
+        GameObject* toFollow = nullptr;
         float zoomLevel;
+        // Draw order of the last render; reused so rendering does not allocate
+        std::vector<GameObject*> drawOrder;
+        Lightmap lightmap;
 
 
-    std::vector<GameObject*> sortByZIndex(std::vector<GameObject*> objs){
-        std::vector<GameObject*> sorted = objs;
-        std::sort(sorted.begin(), sorted.end(), [](GameObject* a, GameObject* b) {
+    const std::vector<GameObject*>& sortByZIndex(const std::vector<GameObject*>& objs){
+        drawOrder.assign(objs.begin(), objs.end());
+        std::sort(drawOrder.begin(), drawOrder.end(), [](GameObject* a, GameObject* b) {
             return a->getZIndex() < b->getZIndex();
         });
-        return sorted;
+        return drawOrder;
     }
 
     public:
@@ -49,7 +48,7 @@ class Camera{
         if(!obj->getVisible()) return;
         
         Vector2 worldPos = obj->getWorldPosition();
-        Vector2* objSize = obj->getSize();
+        const Vector2* objSize = obj->getSize();
         
         // Apply zoom to position and size
         SDL_Rect destRect = {
@@ -65,9 +64,14 @@ class Camera{
             static_cast<int>(objSize->y * zoomLevel / 2)
         };
         
-        // Render the object's sprite with rotation
-        SDL_RenderCopyEx(renderer, obj->getSprite(), nullptr, &destRect, 
-                        obj->getRotation(), &center, SDL_FLIP_NONE);
+        if (TileLayer* layer = obj->asTileLayer()) {
+            // A whole map from one atlas; only the cells in view
+            layer->drawCells(renderer, position, zoomLevel, displaySize);
+        } else {
+            // Render the object's sprite with rotation
+            SDL_RenderCopyEx(renderer, obj->getSprite(), obj->getSourceRect(), &destRect, 
+                            obj->getWorldRotation(), &center, SDL_FLIP_NONE);
+        }
         
         // Render children
         for (GameObject* child : obj->getChildren()) {
@@ -75,7 +79,7 @@ class Camera{
         }
     }
 
-    void render(SDL_Renderer* renderer,std::vector<GameObject*> gameObjects){
+    void render(SDL_Renderer* renderer,const std::vector<GameObject*>& objects){
         // Example rendering logic for the camera
         if(toFollow){
             Vector2 followWorldPos = toFollow->getWorldPosition();
@@ -94,98 +98,19 @@ class Camera{
             255);
         SDL_RenderClear(renderer);
 
-        gameObjects = sortByZIndex(gameObjects);
+        const std::vector<GameObject*>& gameObjects = sortByZIndex(objects);
 
         for(GameObject* obj: gameObjects){
-            if(dynamic_cast<UIGameObject*>(obj)) {
-                    // Draw UI GameObjects without camera transformation
-                    Vector2 worldPos = obj->getWorldPosition();
-            Vector2* objSize = obj->getSize();
-            
-            // Apply zoom to position and size
-            SDL_Rect destRect = {
-                static_cast<int>(worldPos.x),
-                static_cast<int>(worldPos.y),
-                static_cast<int>(objSize->x),
-                static_cast<int>(objSize->y)
-            };
-            
-            // Calculate rotation center (center of the object)
-            SDL_Point center = {
-                static_cast<int>(objSize->x / 2),
-                static_cast<int>(objSize->y / 2)
-            };
-            
-            // Render the object's sprite with rotation
-            SDL_RenderCopyEx(renderer, obj->getSprite(), nullptr, &destRect, 
-                            obj->getRotation(), &center, SDL_FLIP_NONE);
-            
+            if(UIGameObject* ui = obj->asUI()) {
+                // Draw UI GameObjects without camera transformation
+                ui->drawUI(renderer);
             }else{
                 renderObject(renderer, obj);
             }
         }
 
-        // Draw lighthouse glow at night (radial gradient, additive)
-        if (g_sunIntensity < 0.95f) {
-            static SDL_Texture* glowTex = nullptr;
-            static const int BASE_TEX_SIZE = 256; // base texture size (square)
-            if (!glowTex) {
-                // Create a square RGBA surface with radial alpha gradient (red)
-                SDL_Surface* surf = SDL_CreateRGBSurfaceWithFormat(0, BASE_TEX_SIZE, BASE_TEX_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
-                if (surf) {
-                    int cx = BASE_TEX_SIZE / 2;
-                    int cy = BASE_TEX_SIZE / 2;
-                    float invRadius = 1.0f / static_cast<float>(BASE_TEX_SIZE / 2);
-                    for (int y = 0; y < BASE_TEX_SIZE; ++y) {
-                        Uint32* row = reinterpret_cast<Uint32*>((Uint8*)surf->pixels + y * surf->pitch);
-                        for (int x = 0; x < BASE_TEX_SIZE; ++x) {
-                            float dx = static_cast<float>(x - cx);
-                            float dy = static_cast<float>(y - cy);
-                            float d = std::sqrt(dx*dx + dy*dy) * invRadius; // 0..~1.414
-                            float t = std::clamp(1.0f - d, 0.0f, 1.0f);
-                            // Softer falloff for a stronger, tighter center
-                            float alphaF = std::pow(t, 1.2f);
-                            alphaF = std::min(1.0f, alphaF * 1.15f); // boost center a bit
-                            Uint8 a = static_cast<Uint8>(alphaF * 255.0f);
-                            Uint32 pixel = SDL_MapRGBA(surf->format, 255, 80, 80, a);
-                            row[x] = pixel;
-                        }
-                    }
-                    glowTex = SDL_CreateTextureFromSurface(renderer, surf);
-                    SDL_FreeSurface(surf);
-                    if (glowTex) SDL_SetTextureBlendMode(glowTex, SDL_BLENDMODE_ADD);
-                }
-            }
-
-            if (glowTex) {
-                // Draw the glow for each lighthouse; size and alpha scale with darkness
-                float darkness = (1.0f - g_sunIntensity); // 0..1
-                // Increase intensity (more opaque at night) using configurable multiplier
-                Uint8 baseAlpha = static_cast<Uint8>(std::clamp(darkness * 255.0f * g_lighthouseGlowIntensityMultiplier, 0.0f, 255.0f));
-                // Subtle pulse to make it feel alive (low amplitude)
-                float pulse = 0.95f + 0.05f * std::sin(g_dayTimeSeconds * 2.0f);
-
-                for (GameObject* obj : gameObjects) {
-                    Lighthouse* lh = dynamic_cast<Lighthouse*>(obj);
-                    if (!lh) continue;
-                    Vector2 worldPos = lh->getWorldPosition();
-                    Vector2* sz = lh->getSize();
-                    float topX = worldPos.x + sz->x * 0.5f;
-                    float topY = worldPos.y + sz->y * 0.12f;
-                    int sx = static_cast<int>((topX - position.x) * zoomLevel);
-                    int sy = static_cast<int>((topY - position.y) * zoomLevel);
-
-                        // Radius computed from configurable base and extra radius values
-                    float radiusPx = (g_lighthouseGlowBaseRadius + g_lighthouseGlowExtraRadius * darkness) * zoomLevel * pulse;
-                    int dstW = static_cast<int>(radiusPx * 2.0f);
-                    int dstH = dstW;
-                    SDL_Rect dst = { sx - dstW/2, sy - dstH/2, dstW, dstH };
-
-                    SDL_SetTextureAlphaMod(glowTex, baseAlpha);
-                    SDL_RenderCopy(renderer, glowTex, nullptr, &dst);
-                }
-            }
-        }
+        // Night darkening and every registered light, composited over the world only
+        lightmap.render(renderer, position, zoomLevel, displaySize, g_sunIntensity);
 
         // Draw player health bars on top of the scene
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -217,6 +142,11 @@ class Camera{
         // Note: SDL_RenderPresent is called at the end of the main game loop
     }
 
+    // Debug overlays drawn over everything else, after the UI
+    void renderOverlays(SDL_Renderer* renderer){
+        PerfHud::instance().render(renderer, static_cast<int>(displaySize.x));
+    }
+
     void follow(GameObject* obj){
         this->toFollow = obj;
     }
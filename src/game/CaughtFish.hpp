@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "GameObject.hpp"
+#include "ObjectPool.hpp"
+#include "SpriteCache.hpp"
+#include "UIGameObject.hpp"
+#include "Vector2.hpp"
+
+// A caught fish swimming to the player, until it reaches the inventory
+class CaughtFish : public GameObject, public Pooled<CaughtFish> {
+public:
+    static constexpr const char* SPRITE = "./sprites/fish.bmp";
+
+    CaughtFish(Vector2 pos, SDL_Renderer* renderer)
+        : GameObject(pos, {2.0f, 2.0f}, SpriteCache::instance().texture(renderer, SPRITE), renderer, LAYER_PARTICLE) {}
+};
+
+// The fish's icon in an inventory slot
+class FishIcon : public UIGameObject, public Pooled<FishIcon> {
+public:
+    FishIcon(Vector2 screenPos, SDL_Renderer* renderer)
+        : UIGameObject(screenPos, {1.0f, 1.0f}, SpriteCache::instance().texture(renderer, CaughtFish::SPRITE), renderer, LAYER_UI) {}
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "GameObject.hpp"
+#include "ICollidable.hpp"
+#include "Rectangle.hpp"
+#include "../core/JobSystem.hpp"
+
+// Colliders currently touching, smaller pointer first
+using CollisionPairSet = std::set<std::pair<ICollidable*, ICollidable*>>;
+
+// Helper function to check collision between two collision shapes (handles single and multi-rectangle)
+inline bool checkCollision(const std::vector<Rectangle>& shapeA,
+                           const std::vector<Rectangle>& shapeB) {
+    // Check all combinations of rectangles
+    for (const auto& rectA : shapeA) {
+        for (const auto& rectB : shapeB) {
+            if (rectA.intersects(rectB)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Working storage of runCollisionPhase, kept between ticks so a steady scene
+// does not allocate. Lists only grow; entries past the current count are spare.
+struct CollisionScratch {
+    std::vector<ICollidable*> colliders;
+    std::vector<std::vector<Rectangle>> boxes;
+    std::vector<Rectangle> bounds;
+    std::vector<std::vector<uint32_t>> touching; // j > i, ascending
+    std::vector<std::pair<ICollidable*, uint32_t>> colliderIndex; // sorted by pointer
+    std::vector<std::pair<uint32_t, uint32_t>> candidatePairs;
+};
+
+// Tests every live collider against every other and raises enter/stay/leave
+// callbacks against last tick's pairs. Boxes are taken once and the pair tests
+// run on the job system; the callbacks run on the calling thread in pair order.
+// Main thread only (the scratch storage is shared).
+inline void runCollisionPhase(const std::vector<GameObject*>& objects, CollisionPairSet& collisionPairs) {
+    static CollisionScratch scratch;
+    std::vector<ICollidable*>& colliders = scratch.colliders;
+    colliders.clear();
+    for(GameObject* obj: objects){
+        if(ICollidable* collider = obj->asCollidable()){
+            if(!collider->isAlive()) continue;
+            colliders.push_back(collider);
+        }
+    }
+    const size_t count = colliders.size();
+    // Collision boxes of children read their parent's world transform from every worker
+    GameObject::refreshWorldTransforms(objects);
+
+    for (auto pit = collisionPairs.begin(); pit != collisionPairs.end();) {
+        // One of the colliders is dead, remove the pair
+        if (!pit->first->isAlive() || !pit->second->isAlive()) pit = collisionPairs.erase(pit);
+        else ++pit;
+    }
+
+    auto& boxes = scratch.boxes;
+    auto& bounds = scratch.bounds;
+    auto& touching = scratch.touching;
+    if (boxes.size() < count) boxes.resize(count);
+    if (bounds.size() < count) bounds.resize(count);
+    if (touching.size() < count) touching.resize(count);
+    JobSystem::instance().parallelFor(count, 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            colliders[i]->getCollisionBox(boxes[i]);
+            touching[i].clear();
+            if (boxes[i].empty()) continue;
+            Rectangle b = boxes[i][0];
+            for (const Rectangle& r : boxes[i]) {
+                b.begin.x = std::min(b.begin.x, r.begin.x); b.begin.y = std::min(b.begin.y, r.begin.y);
+                b.end.x = std::max(b.end.x, r.end.x); b.end.y = std::max(b.end.y, r.end.y);
+            }
+            bounds[i] = b;
+        }
+    });
+    JobSystem::instance().parallelFor(count, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (boxes[i].empty()) continue;
+            for (size_t j = i + 1; j < count; ++j) {
+                if (boxes[j].empty() || !bounds[i].intersects(bounds[j])) continue;
+                if (checkCollision(boxes[i], boxes[j])) touching[i].push_back(static_cast<uint32_t>(j));
+            }
+        }
+    });
+
+    // Only pairs that touch now or touched last tick can raise a callback
+    auto& colliderIndex = scratch.colliderIndex;
+    colliderIndex.clear();
+    for (size_t i = 0; i < count; ++i) colliderIndex.push_back({colliders[i], static_cast<uint32_t>(i)});
+    std::sort(colliderIndex.begin(), colliderIndex.end());
+    auto indexOf = [&colliderIndex](ICollidable* c) -> const std::pair<ICollidable*, uint32_t>* {
+        auto it = std::lower_bound(colliderIndex.begin(), colliderIndex.end(), std::make_pair(c, uint32_t{0}));
+        return (it != colliderIndex.end() && it->first == c) ? &*it : nullptr;
+    };
+    auto& candidatePairs = scratch.candidatePairs;
+    candidatePairs.clear();
+    for (size_t i = 0; i < count; ++i) {
+        for (uint32_t j : touching[i]) candidatePairs.push_back({static_cast<uint32_t>(i), j});
+    }
+    for (const auto& pair : collisionPairs) {
+        auto ia = indexOf(pair.first);
+        auto ib = indexOf(pair.second);
+        if (!ia || !ib) continue;
+        candidatePairs.push_back({std::min(ia->second, ib->second), std::max(ia->second, ib->second)});
+    }
+    std::sort(candidatePairs.begin(), candidatePairs.end());
+    candidatePairs.erase(std::unique(candidatePairs.begin(), candidatePairs.end()), candidatePairs.end());
+
+    for (const auto& [i, j] : candidatePairs) {
+        ICollidable* collider = colliders[i];
+        ICollidable* otherCollider = colliders[j];
+
+        bool isColliding = std::binary_search(touching[i].begin(), touching[i].end(), j);
+
+        // Use consistent pair ordering (smaller pointer first)
+        auto pair = (collider < otherCollider) ?
+            std::make_pair(collider, otherCollider) :
+            std::make_pair(otherCollider, collider);
+
+        bool wasColliding = collisionPairs.find(pair) != collisionPairs.end();
+
+        if(wasColliding){
+            if(!isColliding){
+                // Collision ended
+                collider->onCollisionLeave(otherCollider);
+                otherCollider->onCollisionLeave(collider);
+                collisionPairs.erase(pair);
+            } else {
+                // Collision continuing
+                collider->onCollisionStay(otherCollider);
+                otherCollider->onCollisionStay(collider);
+            }
+        } else if(isColliding){
+            // New collision
+            collider->onCollisionEnter(otherCollider);
+            otherCollider->onCollisionEnter(collider);
+            collisionPairs.insert(pair);
+        }
+    }
+}
@@ -2,14 +2,19 @@
 
 #include "ICollidable.hpp"
 #include "Vector2.hpp"
+#include "Lighting.hpp"
+#include "ObjectPool.hpp"
+#include "Registered.hpp"
+#include "SpriteCache.hpp"
 #include <SDL.h>
 #include <cmath>
 #include "Player.hpp"
+#include "UpdatePhase.hpp"
 
 // Forward declaration of onHurt implemented in main.cpp
 extern void onHurt(Player* p);
 
-class FishProjectile : public ICollidable {
+class FishProjectile : public ICollidable, public Registered<FishProjectile>, public Pooled<FishProjectile> {
 private:
     Vector2 velocity{0.0f,0.0f};
     // Reduce speed so the projectile is less punishing
@@ -18,17 +23,17 @@ private:
     bool active = false;
     Player* target = nullptr;
     SDL_Renderer* renderer = nullptr;
+    Light glow{this, {0.5f, 0.5f}, 36.0f, SDL_Color{120, 255, 190, 255}, 0.8f};
 public:
     FishProjectile(const Vector2& pos, const Vector2& sizeMultiplier, const char* spritePath,  SDL_Renderer* renderer, int zIndex = 4)
-        : ICollidable(pos, sizeMultiplier, spritePath, renderer, true, zIndex), renderer(renderer),
-         GameObject(pos, sizeMultiplier, spritePath, renderer, zIndex)
+        : ICollidable(pos, sizeMultiplier, SpriteCache::instance().texture(renderer, spritePath), spritePath, renderer, true, zIndex), renderer(renderer),
+         GameObject(pos, sizeMultiplier, SpriteCache::instance().texture(renderer, spritePath), renderer, zIndex)
     {
         setVisible(false);
     }
 
     void fire(const Vector2& start, Player* targetPlayer) {
-        Vector2* p = getPosition();
-        p->x = start.x; p->y = start.y;
+        setPosition(start);
         target = targetPlayer;
         active = true;
         setVisible(true);
@@ -36,10 +41,13 @@ public:
     }
 
     bool getIsActive() const { return active; }
+    Player* getTarget() const { return target; }
+
+    bool updatesInParallel() const override { return true; }
 
     void update(float dt) override {
         if (!active) return;
-        Vector2* p = getPosition();
+        const Vector2* p = getPosition();
         if (target) {
             Vector2 tp = target->getCenteredPosition();
             Vector2 dir = { tp.x - p->x, tp.y - p->y };
@@ -48,8 +56,7 @@ public:
             velocity.x = dir.x * speed;
             velocity.y = dir.y * speed;
         }
-        p->x += velocity.x * dt;
-        p->y += velocity.y * dt;
+        changePosition(velocity.x * dt, velocity.y * dt);
 
         // Proximity check to avoid tunneling: if the projectile gets very close to the target
         // but missed collision due to large dt, apply the collision behavior manually.
@@ -61,15 +68,12 @@ public:
             // Base hit radius (pixels). Scale conservatively to avoid false positives.
             float hitRadius = 12.0f;
             // Allow projectile size to influence radius (use half-diagonal roughly)
-            Vector2* sz = getSize();
+            const Vector2* sz = getSize();
             float sizeInfluence = std::sqrt((sz->x*sz->x + sz->y*sz->y)) * 0.25f;
             hitRadius = std::max(hitRadius, sizeInfluence);
             if (dist2 <= hitRadius * hitRadius) {
                 // Simulate collision with the target
-                ICollidable* coll = dynamic_cast<ICollidable*>(target);
-                if (coll) {
-                    onCollisionEnter(coll);
-                }
+                onCollisionEnter(target);
                 // Ensure we don't continue updating a now-deactivated projectile
                 if (!active) return;
             }
@@ -88,7 +92,7 @@ public:
         // If we hit a player, call the hurt handler and mark for deletion
         Player* p = dynamic_cast<Player*>(other);
         if (p) {
-            onHurt(p);
+            UpdatePhase::defer([p] { onHurt(p); });
             active = false;
             setVisible(false);
             markForDeletion();
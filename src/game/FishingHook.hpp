@@ -5,6 +5,7 @@
 #include "GameObject.hpp"
 #include "ParticleSystem.hpp"
 #include <random>
+#include "../core/Random.hpp"
 #include "../audio/SoundManager.hpp"
 #include <functional>
 
@@ -48,7 +49,7 @@ private:
     std::vector<Vector2> debugPositions;
     float debugDrawDuration = 3.0f;
     float debugTimer = 0.0f;
-    std::mt19937 rng{std::random_device{}()};
+    std::mt19937 rng{nextRandomSeed()};
     int lastAttractAliveCount = 0;
     // Callback invoked when attract particles have finished arriving
     std::function<void()> onAttractArrival = nullptr;
@@ -107,9 +108,7 @@ public:
     void cast(Vector2 startPos, Vector2 direction, Vector2 mousePos, float castSpeed = 200.0f, bool playAttractSound = true) {
         // Cancel any pending retract (we're recasting so it must stay visible)
         pendingRetractTimer = 0.0f;
-        Vector2* pos = getPosition();
-        pos->x = startPos.x;
-        pos->y = startPos.y;
+        setPosition(startPos);
         // Store the origin point for line rendering (world coordinates)
         lineOrigin = startPos;
         // Set the target position (world coordinates)
@@ -154,9 +153,8 @@ public:
         velocity.y += gravity * dt;
 
         // Update position
-        Vector2* pos = getPosition();
-        pos->x += velocity.x * dt;
-        pos->y += velocity.y * dt;
+        changePosition(velocity.x * dt, velocity.y * dt);
+        const Vector2* pos = getPosition();
 
         // Check if hook has reached or passed the target position (mouse)
         float distToTarget = std::sqrt((pos->x - targetPos.x) * (pos->x - targetPos.x) + (pos->y - targetPos.y) * (pos->y - targetPos.y));
@@ -165,8 +163,7 @@ public:
             ((velocity.x > 0 && pos->x >= targetPos.x) || (velocity.x < 0 && pos->x <= targetPos.x)) &&
             ((velocity.y > 0 && pos->y >= targetPos.y) || (velocity.y < 0 && pos->y <= targetPos.y))) {
             // Snap to target and stop
-            pos->x = targetPos.x;
-            pos->y = targetPos.y;
+            setPosition(targetPos);
             destReached = true;
             velocity = {0.0f, 0.0f};
         }
@@ -386,7 +383,7 @@ public:
         if (!isActive) return;
 
         Vector2 hookPos = getWorldPosition();
-        Vector2* hookSize = getSize();
+        const Vector2* hookSize = getSize();
         Vector2 hookCenter = {
             hookPos.x + hookSize->x / 2.0f,
             hookPos.y + hookSize->y / 2.0f
@@ -435,9 +432,7 @@ public:
 
     // Set the hook state to arrived at the given world position (authoritative)
     void setArrivedAt(const Vector2& pos) {
-        Vector2* p = getPosition();
-        p->x = pos.x;
-        p->y = pos.y;
+        setPosition(pos);
         targetPos = pos;
         destReached = true;
         isActive = true; // remains visible until retracted
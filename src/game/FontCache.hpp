@@ -0,0 +1,266 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector2.hpp"
+
+// Glyphs of one font at one size, rasterized once into a shared texture and
+// drawn as batched quads with SDL_RenderGeometry. Text colour comes from the
+// vertex colour, so the same glyphs serve every colour. Printable ASCII is
+// rasterized up front, anything else the first time it is drawn or measured.
+// Main thread only.
+class GlyphAtlas {
+public:
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr int MAX_ATLAS_HEIGHT = 4096;
+    static constexpr int GLYPH_PADDING = 1;
+
+    GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font) : renderer(renderer), font(font) {
+        lineHeight = TTF_FontHeight(font);
+        if (!resize(256)) return;
+        for (uint32_t cp = 32; cp < 127; ++cp) glyph(cp);
+    }
+
+    ~GlyphAtlas() {
+        if (texture) SDL_DestroyTexture(texture);
+        if (pixels) SDL_FreeSurface(pixels);
+    }
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    int getLineHeight() const { return lineHeight; }
+
+    // Size the string takes when drawn, same box TTF_SizeUTF8 would give
+    Vector2 measure(const std::string& utf8) {
+        float right = 0.0f, pen = 0.0f;
+        uint32_t prev = 0;
+        size_t i = 0;
+        while (i < utf8.size()) {
+            uint32_t cp = decodeUtf8(utf8, i);
+            const Glyph* g = glyph(cp);
+            if (!g) continue;
+            if (prev) pen += static_cast<float>(TTF_GetFontKerningSizeGlyphs32(font, prev, cp));
+            right = std::max(right, pen + g->offsetX + g->src.w);
+            pen += static_cast<float>(g->advance);
+            prev = cp;
+        }
+        return {std::max(pen, right), static_cast<float>(lineHeight)};
+    }
+
+    // Draws the string with its top-left corner at (x, y), one draw call per string
+    void draw(const std::string& utf8, float x, float y, SDL_Color color) {
+        if (!texture || utf8.empty()) return;
+        vertices.clear();
+        indices.clear();
+        const float invW = 1.0f / ATLAS_WIDTH;
+        const float invH = 1.0f / atlasHeight;
+        float pen = x;
+        uint32_t prev = 0;
+        size_t i = 0;
+        while (i < utf8.size()) {
+            uint32_t cp = decodeUtf8(utf8, i);
+            const Glyph* g = glyph(cp);
+            if (!g) continue;
+            if (prev) pen += static_cast<float>(TTF_GetFontKerningSizeGlyphs32(font, prev, cp));
+            prev = cp;
+            if (g->src.w > 0 && g->src.h > 0) {
+                float x0 = pen + g->offsetX, y0 = y;
+                float x1 = x0 + g->src.w, y1 = y0 + g->src.h;
+                float u0 = g->src.x * invW, v0 = g->src.y * invH;
+                float u1 = (g->src.x + g->src.w) * invW, v1 = (g->src.y + g->src.h) * invH;
+                int base = static_cast<int>(vertices.size());
+                vertices.push_back({{x0, y0}, color, {u0, v0}});
+                vertices.push_back({{x1, y0}, color, {u1, v0}});
+                vertices.push_back({{x1, y1}, color, {u1, v1}});
+                vertices.push_back({{x0, y1}, color, {u0, v1}});
+                for (int k : {0, 1, 2, 0, 2, 3}) indices.push_back(base + k);
+            }
+            pen += static_cast<float>(g->advance);
+        }
+        if (vertices.empty()) return;
+        SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size()));
+    }
+
+private:
+    struct Glyph {
+        SDL_Rect src;   // cell in the atlas (as TTF renders the single glyph, font height tall)
+        int offsetX;    // where the cell starts relative to the pen
+        int advance;
+    };
+
+    static uint32_t decodeUtf8(const std::string& s, size_t& i) {
+        auto byte = [&](size_t at) { return static_cast<uint8_t>(s[at]); };
+        uint8_t c = byte(i);
+        int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0 || i + extra >= s.size()) {
+            ++i;
+            return 0xFFFD;
+        }
+        uint32_t cp = extra == 0 ? c : (c & (0x3F >> extra));
+        for (int k = 1; k <= extra; ++k) {
+            uint8_t cont = byte(i + k);
+            if ((cont & 0xC0) != 0x80) {
+                i += k;
+                return 0xFFFD;
+            }
+            cp = (cp << 6) | (cont & 0x3F);
+        }
+        i += 1 + extra;
+        return cp;
+    }
+
+    const Glyph* glyph(uint32_t cp) {
+        auto it = glyphs.find(cp);
+        if (it != glyphs.end()) return it->second.advance < 0 ? nullptr : &it->second;
+        Glyph& g = glyphs[cp];
+        g = Glyph{{0, 0, 0, 0}, 0, -1}; // missing until rasterized
+
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (!pixels || TTF_GlyphMetrics32(font, cp, &minx, &maxx, &miny, &maxy, &advance) != 0) return nullptr;
+        SDL_Surface* rendered = TTF_RenderGlyph32_Blended(font, cp, SDL_Color{255, 255, 255, 255});
+        if (!rendered) return nullptr;
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(rendered);
+        if (!converted) return nullptr;
+
+        SDL_Rect cell{0, 0, converted->w, converted->h};
+        if (!place(cell)) {
+            SDL_FreeSurface(converted);
+            if (!warnedFull) {
+                std::cerr << "Warning: glyph atlas full, some characters will not be drawn\n";
+                warnedFull = true;
+            }
+            return nullptr;
+        }
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(converted, nullptr, pixels, &cell);
+        SDL_FreeSurface(converted);
+        upload(&cell);
+
+        g = Glyph{cell, std::min(0, minx), advance};
+        return &g;
+    }
+
+    // Shelf packing: left to right, a new row when the current one is full
+    bool place(SDL_Rect& cell) {
+        if (cell.w + GLYPH_PADDING > ATLAS_WIDTH) return false;
+        if (penX + cell.w + GLYPH_PADDING > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+        while (penY + cell.h > atlasHeight) {
+            if (atlasHeight * 2 > MAX_ATLAS_HEIGHT || !resize(atlasHeight * 2)) return false;
+        }
+        cell.x = penX;
+        cell.y = penY;
+        penX += cell.w + GLYPH_PADDING;
+        rowHeight = std::max(rowHeight, cell.h);
+        return true;
+    }
+
+    // Grows the atlas (existing glyphs keep their cells) and re-uploads it
+    bool resize(int height) {
+        SDL_Surface* grown = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, ATLAS_WIDTH, height);
+        if (!grown || !tex) {
+            std::cerr << "Warning: could not create glyph atlas: " << SDL_GetError() << "\n";
+            if (grown) SDL_FreeSurface(grown);
+            if (tex) SDL_DestroyTexture(tex);
+            return false;
+        }
+        SDL_FillRect(grown, nullptr, 0);
+        if (pixels) {
+            SDL_SetSurfaceBlendMode(pixels, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(pixels, nullptr, grown, nullptr);
+            SDL_FreeSurface(pixels);
+        }
+        if (texture) SDL_DestroyTexture(texture);
+        pixels = grown;
+        texture = tex;
+        atlasHeight = height;
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        upload(nullptr);
+        return true;
+    }
+
+    void upload(const SDL_Rect* area) {
+        const uint8_t* src = static_cast<const uint8_t*>(pixels->pixels);
+        if (area) src += area->y * pixels->pitch + area->x * 4;
+        SDL_UpdateTexture(texture, area, src, pixels->pitch);
+    }
+
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SDL_Surface* pixels = nullptr; // CPU copy, so the atlas can grow without reading back the texture
+    SDL_Texture* texture = nullptr;
+    int atlasHeight = 0;
+    int lineHeight = 0;
+    int penX = 0, penY = 0, rowHeight = 0;
+    bool warnedFull = false;
+    std::unordered_map<uint32_t, Glyph> glyphs;
+    std::vector<SDL_Vertex> vertices; // reused by draw()
+    std::vector<int> indices;
+};
+
+// Opens each (font file, size) once and keeps one GlyphAtlas per renderer for it.
+// Text objects share what they get from here instead of owning a TTF_Font each.
+class FontCache {
+public:
+    static FontCache& instance() {
+        static FontCache inst;
+        return inst;
+    }
+
+    // nullptr if the font cannot be opened (warned about once per font and size)
+    TTF_Font* font(const char* path, int size) {
+        auto key = std::make_pair(std::string(path), size);
+        auto it = fonts.find(key);
+        if (it != fonts.end()) return it->second;
+        TTF_Font* opened = TTF_OpenFont(path, size);
+        if (!opened) {
+            std::cerr << "Warning: Failed to open font '" << path << "': " << TTF_GetError() << "\n";
+        }
+        fonts[key] = opened;
+        return opened;
+    }
+
+    GlyphAtlas* atlas(SDL_Renderer* renderer, const char* path, int size) {
+        auto key = std::make_tuple(renderer, std::string(path), size);
+        auto it = atlases.find(key);
+        if (it != atlases.end()) return it->second.get();
+        TTF_Font* f = renderer ? font(path, size) : nullptr;
+        std::unique_ptr<GlyphAtlas> created = f ? std::make_unique<GlyphAtlas>(renderer, f) : nullptr;
+        GlyphAtlas* result = created.get();
+        atlases[key] = std::move(created);
+        return result;
+    }
+
+    // Frees atlases and fonts; call before destroying the renderer and TTF_Quit.
+    // Text objects still alive must not draw afterwards.
+    void clear() {
+        atlases.clear();
+        for (auto& [key, f] : fonts) {
+            if (f) TTF_CloseFont(f);
+        }
+        fonts.clear();
+    }
+
+private:
+    FontCache() = default;
+
+    std::map<std::pair<std::string, int>, TTF_Font*> fonts;
+    std::map<std::tuple<SDL_Renderer*, std::string, int>, std::unique_ptr<GlyphAtlas>> atlases;
+};
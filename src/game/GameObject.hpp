@@ -1,17 +1,46 @@
 #pragma once
 
 #include <SDL.h>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include "Vector2.hpp"
 #include "Rectangle.hpp"
+#include "SpriteCache.hpp"
 
 
 class ICollidable;
+class IInteractable;
+class UIGameObject;
+class TileLayer;
+class World;
+
+// Names an object in the World without keeping it alive: World::get returns
+// nullptr once the object has left the world, even if its memory was reused.
+struct EntityHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 never names an object
+
+    explicit operator bool() const { return generation != 0; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
 
 using json = nlohmann::json;
 
+// zIndex values used by the game, drawn lowest first
+enum RENDER_LAYERS {
+    LAYER_ENVIRONMENT = 0,
+    LAYER_BOAT = 1,
+    LAYER_LIGHTHOUSE = 2,
+    LAYER_PLAYER = 3,
+    LAYER_PARTICLE = 4,
+    LAYER_UI = 5,
+    LAYER_DEBUG = 6,
+};
+
 class GameObject{
     private:
     Vector2 position; // Local position relative to parent
@@ -19,17 +48,74 @@ class GameObject{
     Vector2 size;
     float rotation;
     SDL_Texture* sprite;
+    SDL_Rect sourceRect{0, 0, 0, 0}; // part of the sprite drawn, when hasSourceRect
+    bool hasSourceRect = false;
     int zIndex;
     GameObject* parent;
     std::vector<GameObject*> children;
     bool isVisible = true;
     bool isDeleted = false;
+    EntityHandle handle; // set while the object is in the World
+
+    friend class World;
+
+    // Capabilities, set by the constructors of the interfaces this object implements.
+    // Checked instead of dynamic_cast, which is slow through the virtual bases.
+    ICollidable* collidable = nullptr;
+    IInteractable* interactable = nullptr;
+    UIGameObject* ui = nullptr;
+    TileLayer* tileLayer = nullptr;
+
+    // World transform cache. Filled on the first read after this object or an
+    // ancestor moved; a dirty object always has dirty descendants.
+    mutable Vector2 worldPosition{0.0f, 0.0f};
+    mutable float worldRotation = 0.0f;
+    mutable bool transformDirty = true;
+
+    void markTransformDirty() {
+        if (transformDirty) return;
+        transformDirty = true;
+        for (GameObject* child : children) child->markTransformDirty();
+    }
+
+    // Reparenting can leave a clean child under a dirty parent, so no early out here
+    void invalidateTransformTree() {
+        transformDirty = true;
+        for (GameObject* child : children) child->invalidateTransformTree();
+    }
+
+    void refreshWorldTransform() const {
+        if (!transformDirty) return;
+        if (!parent) {
+            worldPosition = position;
+            worldRotation = rotation;
+        } else {
+            parent->refreshWorldTransform();
+            const Vector2& parentPos = parent->worldPosition;
+            float parentRot = parent->worldRotation;
+            if (parentRot == 0.0f) {
+                worldPosition = {parentPos.x + position.x, parentPos.y + position.y};
+            } else {
+                // Children turn with the parent around its centre, the pivot sprites are drawn with
+                float rad = parentRot * 3.14159265f / 180.0f;
+                float c = std::cos(rad), s = std::sin(rad);
+                float ox = position.x + size.x / 2.0f - parent->size.x / 2.0f;
+                float oy = position.y + size.y / 2.0f - parent->size.y / 2.0f;
+                worldPosition = {parentPos.x + parent->size.x / 2.0f + ox * c - oy * s - size.x / 2.0f,
+                                 parentPos.y + parent->size.y / 2.0f + ox * s + oy * c - size.y / 2.0f};
+            }
+            worldRotation = parentRot + rotation;
+        }
+        transformDirty = false;
+    }
     
 
 
     
 
     public:
+    virtual ~GameObject() = default;
+
     GameObject(Vector2 pos,const char* spritePath, SDL_Renderer* renderer,int zIndex = 0)
         : GameObject(pos, {1, 1}, spritePath, renderer, zIndex)
     {
@@ -53,38 +139,24 @@ class GameObject{
         }
     }
 
+    // Draws the part of the sprite between cutoutBegin and cutoutEnd, sharing the sprite's texture
     GameObject(Vector2 pos,Vector2 sizeMultiplier,const char* spritePath, SDL_Renderer* renderer,Vector2 cutoutBegin,Vector2 cutoutEnd,int zIndex = 0){
-        // Initialize position, sizeMultiplier, rotation
         this->position = pos;
         this->sizeMultiplier = sizeMultiplier;
         this->rotation = 0.0f;
         this->parent = nullptr;
-        // Load sprite texture from file
-        SDL_Surface* surface = SDL_LoadBMP(spritePath);
-        if (!surface) {
-            sprite = nullptr;
+        this->zIndex = zIndex;
+        sprite = SpriteCache::instance().texture(renderer, spritePath);
+        if (!sprite) {
             this->size = {0.0f, 0.0f};
-            this->zIndex = zIndex;
             return;
         }
-        // Cutout the surface
-        SDL_Rect cutoutRect;
-        cutoutRect.x = static_cast<int>(cutoutBegin.x);
-        cutoutRect.y = static_cast<int>(cutoutBegin.y);
-        cutoutRect.w = static_cast<int>(cutoutEnd.x - cutoutBegin.x);
-        cutoutRect.h = static_cast<int>(cutoutEnd.y - cutoutBegin.y);
-        SDL_Surface* cutoutSurface = SDL_CreateRGBSurface(0, cutoutRect.w, cutoutRect.h, 32, 0, 0, 0, 0);
-        if (cutoutSurface) {
-            SDL_BlitSurface(surface, &cutoutRect, cutoutSurface, nullptr);
-            sprite = SDL_CreateTextureFromSurface(renderer, cutoutSurface);
-            this->size = {static_cast<float>(cutoutSurface->w) * sizeMultiplier.x, static_cast<float>(cutoutSurface->h) * sizeMultiplier.y};
-            SDL_FreeSurface(cutoutSurface);
-        } else {
-            sprite = nullptr;
-            this->size = {0.0f, 0.0f};
-        }
-        SDL_FreeSurface(surface);
-        this->zIndex = zIndex;
+        sourceRect.x = static_cast<int>(cutoutBegin.x);
+        sourceRect.y = static_cast<int>(cutoutBegin.y);
+        sourceRect.w = static_cast<int>(cutoutEnd.x - cutoutBegin.x);
+        sourceRect.h = static_cast<int>(cutoutEnd.y - cutoutBegin.y);
+        hasSourceRect = true;
+        this->size = {static_cast<float>(sourceRect.w) * sizeMultiplier.x, static_cast<float>(sourceRect.h) * sizeMultiplier.y};
     }
 
     GameObject(Vector2 pos,Vector2 sizeMultiplier,const char* spritePath, SDL_Renderer* renderer,int zIndex = 0){
@@ -92,16 +164,12 @@ class GameObject{
         this->sizeMultiplier = sizeMultiplier;
         this->rotation = 0.0f;
         this->parent = nullptr;
-        // Load sprite texture from file
-        SDL_Surface* surface = SDL_LoadBMP(spritePath);
-        if (surface) {
-            sprite = SDL_CreateTextureFromSurface(renderer, surface);
-            SDL_FreeSurface(surface);
-        } else {
-            sprite = nullptr;
-        }
-        if (surface) {
-            this->size = {static_cast<float>(surface->w) * sizeMultiplier.x, static_cast<float>(surface->h) * sizeMultiplier.y};
+        // Shared with every object drawing the same file
+        sprite = SpriteCache::instance().texture(renderer, spritePath);
+        if (sprite) {
+            int w, h;
+            SDL_QueryTexture(sprite, nullptr, nullptr, &w, &h);
+            this->size = {static_cast<float>(w) * sizeMultiplier.x, static_cast<float>(h) * sizeMultiplier.y};
         } else {
             this->size = {0.0f, 0.0f};
         }
@@ -114,14 +182,34 @@ class GameObject{
 
     void setSprite(SDL_Texture* newSprite){
         this->sprite = newSprite;
+        hasSourceRect = false;
         // Update size based on the new texture
         if (newSprite) {
             int w, h;
             SDL_QueryTexture(newSprite, nullptr, nullptr, &w, &h);
             this->size = {static_cast<float>(w) * sizeMultiplier.x, static_cast<float>(h) * sizeMultiplier.y};
+            invalidateTransformTree(); // rotated parents pivot on the size
         }
     }
 
+    // Draws only `region` of the texture (one frame of an atlas). The size follows
+    // the region without querying the texture.
+    void setSpriteRegion(SDL_Texture* texture, const SDL_Rect& region) {
+        sprite = texture;
+        sourceRect = region;
+        hasSourceRect = true;
+        Vector2 regionSize = {static_cast<float>(region.w) * sizeMultiplier.x, static_cast<float>(region.h) * sizeMultiplier.y};
+        if (regionSize.x != size.x || regionSize.y != size.y) {
+            size = regionSize;
+            invalidateTransformTree(); // rotated parents pivot on the size
+        }
+    }
+
+    // Part of the sprite to draw, nullptr for all of it
+    const SDL_Rect* getSourceRect() const {
+        return hasSourceRect ? &sourceRect : nullptr;
+    }
+
     void show() {
         isVisible = true;
     }
@@ -142,28 +230,30 @@ class GameObject{
         return !isDeleted;
     }
 
-    // Mark object for deletion. Actual deletion happens during the main loop cleanup pass.
+    // Mark object for deletion. The world frees it at the end of the frame, so only
+    // mark objects the world owns. Safe from a parallel update of this object.
     void markForDeletion() { isDeleted = true; 
                                 hide(); }
     bool isMarkedForDeletion() const { return isDeleted; }
 
+    // Null while the object is not in the World
+    EntityHandle getHandle() const { return handle; }
+
     void setSprite(const char* spritePath, SDL_Renderer* renderer){
-        SDL_Surface* surface = SDL_LoadBMP(spritePath);
-        if (surface) {
-            // Store size before freeing surface
-            float w = static_cast<float>(surface->w);
-            float h = static_cast<float>(surface->h);
-            SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer, surface);
-            SDL_FreeSurface(surface);
-            this->sprite = newTexture;
-            this->size = {w * sizeMultiplier.x, h * sizeMultiplier.y};
-        }
+        if (SDL_Texture* shared = SpriteCache::instance().texture(renderer, spritePath)) setSprite(shared);
     }
 
     virtual void update(float dt){
         // To be implemented in subclasses
     }
 
+    // True when update() only changes this object and reads nothing another update
+    // moves, except players and the boat (updated first). Such objects update on
+    // worker threads and route any other side effect through UpdatePhase::defer.
+    virtual bool updatesInParallel() const {
+        return false;
+    }
+
     virtual void onKeyDown(SDL_Keycode key){
         // To be implemented in subclasses
     }
@@ -172,109 +262,58 @@ class GameObject{
         // To be implemented in subclasses
     }
 
-    static std::vector<GameObject*> fromTileset(const char* tilemapPath, const char* tilesetPath, SDL_Renderer* renderer) {
-        std::vector<GameObject*> tiles;
-        std::ifstream file(tilemapPath);
-        if (!file.is_open()) {
-            SDL_Log("Failed to open tilemap file: %s", tilemapPath);
-            return tiles;
-        }
-
-        json data;
-        try {
-            file >> data;
-        } catch (const std::exception& e) {
-            SDL_Log("Failed to parse tilemap JSON: %s", e.what());
-            return tiles;
-        }
-
-        // Extract metadata
-        int tileWidth = data["tileWidth"].get<int>();
-        int tileHeight = data["tileHeight"].get<int>();
-        int mapWidth = data["mapWidth"].get<int>();
-        int mapHeight = data["mapHeight"].get<int>();
-
-        // Load tiles
-        const auto& tilesArray = data["tiles"];
-        for (int y = 0; y < mapHeight; y++) {
-            const auto& row = tilesArray[y];
-            for (int x = 0; x < mapWidth; x++) {
-                const auto& tile = row[x];
-                
-                if (tile.is_null()) continue;
-                
-                int tileX = tile["x"].get<int>();
-                int tileY = tile["y"].get<int>();
-                
-                // Create a tileset sprite with the correct tile coordinates
-                Vector2 pos = {
-                    static_cast<float>(x * tileWidth),
-                    static_cast<float>(y * tileHeight)
-                };
-                
-                Vector2 cutoutBegin = {
-                    static_cast<float>(tileX * tileWidth),
-                    static_cast<float>(tileY * tileHeight)
-                };
-                Vector2 cutoutEnd = {
-                    static_cast<float>((tileX + 1) * tileWidth),
-                    static_cast<float>((tileY + 1) * tileHeight)
-                };
-                
-                SDL_Surface* surface = SDL_LoadBMP(tilesetPath);
-                SDL_Rect cutoutRect;
-                cutoutRect.x = static_cast<int>(cutoutBegin.x);
-                cutoutRect.y = static_cast<int>(cutoutBegin.y);
-                cutoutRect.w = static_cast<int>(cutoutEnd.x - cutoutBegin.x);
-                cutoutRect.h = static_cast<int>(cutoutEnd.y - cutoutBegin.y);
-                SDL_Surface* cutoutSurface = SDL_CreateRGBSurface(0, cutoutRect.w, cutoutRect.h, 32, 0, 0, 0, 0);
-
-                if (cutoutSurface) {
-                    SDL_BlitSurface(surface, &cutoutRect, cutoutSurface, nullptr);
-                    SDL_FreeSurface(surface);
-                } 
-
-                GameObject* tileObj = new GameObject(
-                    pos,
-                    {1.0f, 1.0f},
-                    tilesetPath,
-                    renderer,
-                    cutoutBegin,
-                    cutoutEnd,
-                    0
-                );
-                tiles.push_back(tileObj);
-
-            }
-        }
-        return tiles;
-    }
-
-
-
     int getZIndex(){
         return zIndex;
     }
 
-    Vector2* getPosition() {
+    // Local position; move the object with setPosition/changePosition so children follow
+    const Vector2* getPosition() const {
         return &position;
     }
 
     Vector2 getWorldPosition() const {
-        if (parent) {
-            Vector2 parentWorld = parent->getWorldPosition();
-            return {parentWorld.x + position.x, parentWorld.y + position.y};
-        }
-        return position;
+        refreshWorldTransform();
+        return worldPosition;
+    }
+
+    // Own rotation plus that of every ancestor, in degrees
+    float getWorldRotation() const {
+        refreshWorldTransform();
+        return worldRotation;
+    }
+
+    // Local position that puts this object at worldPos under its current parent,
+    // the inverse of refreshWorldTransform (undoes the parent's turn around its centre)
+    Vector2 worldToLocal(Vector2 worldPos) const {
+        if (!parent) return worldPos;
+        parent->refreshWorldTransform();
+        const Vector2& parentPos = parent->worldPosition;
+        float parentRot = parent->worldRotation;
+        if (parentRot == 0.0f) return {worldPos.x - parentPos.x, worldPos.y - parentPos.y};
+        float rad = parentRot * 3.14159265f / 180.0f;
+        float c = std::cos(rad), s = std::sin(rad);
+        float wx = worldPos.x + size.x / 2.0f - parentPos.x - parent->size.x / 2.0f;
+        float wy = worldPos.y + size.y / 2.0f - parentPos.y - parent->size.y / 2.0f;
+        return {wx * c + wy * s - size.x / 2.0f + parent->size.x / 2.0f,
+                -wx * s + wy * c - size.y / 2.0f + parent->size.y / 2.0f};
+    }
+
+    // Fills the transform cache of every object. Call on the main thread before
+    // work that reads world transforms from several threads, so no reader has to
+    // fill a shared cache.
+    static void refreshWorldTransforms(const std::vector<GameObject*>& objects) {
+        for (GameObject* obj : objects) obj->refreshWorldTransform();
     }
 
     void changePosition(float dx, float dy) {
         position.x += dx;
         position.y += dy;
+        markTransformDirty();
     }
 
     void setPosition(Vector2 newPos) {
         position = newPos;
+        markTransformDirty();
     }
 
     Vector2 getCenteredPosition() {
@@ -282,12 +321,26 @@ class GameObject{
         return {worldPos.x + size.x / 2.0f, worldPos.y + size.y / 2.0f};
     }
 
-    Vector2* getSize()  {
+    // Drawn size; change it with setSize so children of a rotated object follow
+    const Vector2* getSize() const {
         return &size;
     }
 
+    void setSize(Vector2 newSize) {
+        if (newSize.x == size.x && newSize.y == size.y) return;
+        size = newSize;
+        invalidateTransformTree(); // rotated parents pivot on the size
+    }
+
+    // This object as the given interface, or nullptr when it does not implement it
+    ICollidable* asCollidable() const { return collidable; }
+    IInteractable* asInteractable() const { return interactable; }
+    UIGameObject* asUI() const { return ui; }
+    TileLayer* asTileLayer() const { return tileLayer; }
+
     void rotate(float angle) {
         rotation += angle;
+        markTransformDirty();
     }
 
     float getRotation() const {
@@ -296,6 +349,7 @@ class GameObject{
 
     void setRotation(float angle) {
         rotation = angle;
+        markTransformDirty();
     }
 
     void addChild(GameObject* child) {
@@ -306,6 +360,7 @@ class GameObject{
             }
             children.push_back(child);
             child->parent = this;
+            child->invalidateTransformTree();
         }
     }
 
@@ -314,6 +369,7 @@ class GameObject{
         if (it != children.end()) {
             children.erase(it);
             child->parent = nullptr;
+            child->invalidateTransformTree();
         }
     }
 
@@ -333,4 +389,10 @@ class GameObject{
         }
     }
 
+    protected:
+    void setCapability(ICollidable* self) { collidable = self; }
+    void setCapability(IInteractable* self) { interactable = self; }
+    void setCapability(UIGameObject* self) { ui = self; }
+    void setCapability(TileLayer* self) { tileLayer = self; }
+
 };
\ No newline at end of file
@@ -1,37 +1,36 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include "GameObject.hpp"
+#include "SpriteCache.hpp"
 
+// Plays a shared AnimationClip by drawing one frame of the clip's atlas at a
+// time. An instance keeps only the clip, the time into it and the frame shown,
+// so many animated objects cost little more than one.
 class IAnimatable : virtual public GameObject{
     private:
-    std::map<int, SDL_Texture*> animationFrames;
-    int currentFrame;
-    float animationStep;
-    float elapsed;
+    const AnimationClip* clip = nullptr;
+    float elapsed = 0.0f; // time into the clip, less than its duration
+    int currentFrame = 0;
     bool isAnimating = true;
+
+    void showFrame(int frame) {
+        currentFrame = frame;
+        this->setSpriteRegion(clip->atlas, clip->frames[frame]);
+    }
+
     public:
     IAnimatable(Vector2 pos,Vector2 sizeMultiplier,const char* spritePath[], int frameCount, SDL_Renderer* renderer,float animationStep, int zIndex = 0)
-        : GameObject(pos, sizeMultiplier, spritePath[0], renderer, zIndex)
+        : GameObject(pos, sizeMultiplier, static_cast<SDL_Texture*>(nullptr), renderer, zIndex)
     {
-        for(int i = 0; i < frameCount; i++){
-            SDL_Surface* surface = SDL_LoadBMP(spritePath[i]);
-            if (surface) {
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-                animationFrames[i] = texture;
-                SDL_FreeSurface(surface);
-            } else {
-                animationFrames[i] = nullptr;
-            }
-        }
-        currentFrame = 0;
-        this->animationStep = animationStep;
-        this->elapsed = 0.0f;
+        clip = SpriteCache::instance().clip(renderer, spritePath, frameCount, animationStep);
+        if (!clip->frames.empty()) showFrame(0);
     }
 
     void stopAnimation(){
         isAnimating = false;
-        this->setSprite(animationFrames[0]);
+        if (!clip->frames.empty()) showFrame(0);
     }
 
     void toggleAnimation(){
@@ -48,17 +47,14 @@ class IAnimatable : virtual public GameObject{
 
 
     void update(float dt) override {
-        if (animationFrames.empty() || !isAnimating) return;
+        if (clip->frames.empty() || clip->step <= 0.0f || !isAnimating) return;
 
+        const int frameCount = static_cast<int>(clip->frames.size());
         elapsed += dt;
-        while (elapsed >= animationStep) {
-            elapsed -= animationStep;
-            currentFrame = (currentFrame + 1) % static_cast<int>(animationFrames.size());
-        }
+        float duration = clip->step * frameCount;
+        if (elapsed >= duration) elapsed = std::fmod(elapsed, duration);
 
-        SDL_Texture* currentTexture = animationFrames[currentFrame];
-        if (currentTexture) {
-            this->setSprite(currentTexture);
-        }
+        int frame = std::min(static_cast<int>(elapsed / clip->step), frameCount - 1);
+        if (frame != currentFrame) showFrame(frame);
     }
-};
\ No newline at end of file
+};
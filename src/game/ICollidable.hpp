@@ -2,23 +2,33 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 #include <SDL.h>
 #include <SDL_image.h>
 #include "GameObject.hpp"
 #include "Rectangle.hpp"
+#include "../core/AssetPack.hpp"
+#include "../core/JobSystem.hpp"
 
 struct RowSpan{
     int minX;
     int maxX;
 };
 
+// Hitboxes detected in a sprite, in the pixels of the image they came from
+struct CollisionShape {
+    std::vector<Rectangle> rectangles;
+    float surfaceWidth = 0.0f;
+    float surfaceHeight = 0.0f;
+};
+
 class ICollidable : virtual public GameObject {
     private:
-    std::vector<Rectangle> collisionRectangles;
+    const CollisionShape* shape = nullptr; // shared by every collider made from the same file
     bool isComplex;
-    float originalSurfaceWidth;
-    float originalSurfaceHeight;
     public:
 
     static std::vector<Rectangle> autoDetectHitboxes(SDL_Surface* surface, int minClusterSize = 50) {
@@ -71,28 +81,31 @@ class ICollidable : virtual public GameObject {
             return a > 128;
         };
 
-        // Scan each row to find horizontal spans of opaque pixels
+        // Scan each row to find horizontal spans of opaque pixels (rows are independent,
+        // so bands of rows are scanned on the job system)
         std::vector<std::vector<RowSpan>> rowSpans(height);
         
-        for (int y = 0; y < height; y++) {
-            int spanStart = -1;
-            for (int x = 0; x < width; x++) {
-                if (isOpaque(x, y)) {
-                    if (spanStart == -1) {
-                        spanStart = x;
-                    }
-                } else {
-                    if (spanStart != -1) {
-                        rowSpans[y].push_back({spanStart, x - 1});
-                        spanStart = -1;
+        JobSystem::instance().parallelFor(static_cast<size_t>(height), 32, [&](size_t rowBegin, size_t rowEnd) {
+            for (int y = static_cast<int>(rowBegin); y < static_cast<int>(rowEnd); y++) {
+                int spanStart = -1;
+                for (int x = 0; x < width; x++) {
+                    if (isOpaque(x, y)) {
+                        if (spanStart == -1) {
+                            spanStart = x;
+                        }
+                    } else {
+                        if (spanStart != -1) {
+                            rowSpans[y].push_back({spanStart, x - 1});
+                            spanStart = -1;
+                        }
                     }
                 }
+                // Close span at end of row if needed
+                if (spanStart != -1) {
+                    rowSpans[y].push_back({spanStart, width - 1});
+                }
             }
-            // Close span at end of row if needed
-            if (spanStart != -1) {
-                rowSpans[y].push_back({spanStart, width - 1});
-            }
-        }
+        });
 
         // Group consecutive rows with similar widths into rectangles
         int startY = 0;
@@ -162,44 +175,83 @@ class ICollidable : virtual public GameObject {
 
     
 
+    // Hitboxes of a sprite file, read from the asset pack or detected the first time
+    // they are asked for, and kept for the rest of the run; nullptr if the file
+    // cannot be loaded. Main thread only.
+    static const CollisionShape* sharedShape(const char* spritePath, int minClusterSize = 50) {
+        static std::map<std::pair<std::string, int>, std::unique_ptr<CollisionShape>> shapes;
+        auto key = std::make_pair(AssetPack::key(spritePath), minClusterSize);
+        auto it = shapes.find(key);
+        if (it != shapes.end()) return it->second.get();
+        std::unique_ptr<CollisionShape> detected;
+        AssetPack::Hitboxes cooked;
+        if (AssetPack::instance().hitboxes(spritePath, minClusterSize, cooked)) {
+            detected = std::make_unique<CollisionShape>();
+            detected->surfaceWidth = static_cast<float>(cooked.surfaceWidth);
+            detected->surfaceHeight = static_cast<float>(cooked.surfaceHeight);
+            detected->rectangles.reserve(cooked.count);
+            for (uint32_t i = 0; i < cooked.count; ++i) {
+                const float* box = cooked.boxes + i * 4;
+                detected->rectangles.push_back(Rectangle{{box[0], box[1]}, {box[2], box[3]}});
+            }
+        } else if (SDL_Surface* surface = IMG_Load(spritePath)) {
+            detected = std::make_unique<CollisionShape>();
+            detected->surfaceWidth = static_cast<float>(surface->w);
+            detected->surfaceHeight = static_cast<float>(surface->h);
+            detected->rectangles = autoDetectHitboxes(surface, minClusterSize);
+            SDL_FreeSurface(surface);
+        } else {
+            std::cerr << "Failed to load surface for hitbox detection: " << SDL_GetError() << "\n";
+        }
+        const CollisionShape* result = detected.get();
+        shapes[key] = std::move(detected);
+        return result;
+    }
+
     ICollidable(Vector2 pos,Vector2 sizeMultiplier,const char* spritePath, SDL_Renderer* renderer,bool isComplex,int zIndex = 0, int minClusterSize = 50)
         : GameObject(pos, sizeMultiplier, spritePath, renderer, zIndex)
     {
+        setCapability(this);
         this->isComplex = isComplex;
-        this->originalSurfaceWidth = 0.0f;
-        this->originalSurfaceHeight = 0.0f;
-
-        if (isComplex) {
-            SDL_Surface* surface = IMG_Load(spritePath);
-            if (!surface) {
-                std::cerr << "Failed to load surface for hitbox detection: " << SDL_GetError() << "\n";
-                return;
-            }
+        if (isComplex) shape = sharedShape(spritePath, minClusterSize);
+    }
 
-            this->originalSurfaceWidth = static_cast<float>(surface->w);
-            this->originalSurfaceHeight = static_cast<float>(surface->h);
-            collisionRectangles = autoDetectHitboxes(surface, minClusterSize);
-            SDL_FreeSurface(surface);
-        }
+    // Drawing an already loaded (usually shared) texture; spritePath is only read for the hitboxes
+    ICollidable(Vector2 pos,Vector2 sizeMultiplier,SDL_Texture* texture,const char* spritePath, SDL_Renderer* renderer,bool isComplex,int zIndex = 0, int minClusterSize = 50)
+        : GameObject(pos, sizeMultiplier, texture, renderer, zIndex)
+    {
+        setCapability(this);
+        this->isComplex = isComplex;
+        if (isComplex) shape = sharedShape(spritePath, minClusterSize);
     }
 
     
     std::vector<Rectangle> getCollisionBox(){
+        std::vector<Rectangle> box;
+        getCollisionBox(box);
+        return box;
+    }
+
+    // Same as above into caller-owned storage, so per-tick callers can reuse its capacity
+    void getCollisionBox(std::vector<Rectangle>& out){
+        out.clear();
         Vector2 worldPos = this->getWorldPosition();
-        Vector2* size = this->getSize();
+        const Vector2* size = this->getSize();
         
         if(!isComplex){
-            return {Rectangle{worldPos, {worldPos.x + size->x, worldPos.y + size->y}}};
+            out.push_back(Rectangle{worldPos, {worldPos.x + size->x, worldPos.y + size->y}});
+            return;
         }
         
+        if (!shape) return;
+
         // Transform collision rectangles to world coordinates
-        std::vector<Rectangle> transformed;
-        transformed.reserve(collisionRectangles.size());
+        out.reserve(shape->rectangles.size());
         
         // Get the original surface dimensions to calculate scale
-        Vector2 scale = {size->x / originalSurfaceWidth, size->y / originalSurfaceHeight};
+        Vector2 scale = {size->x / shape->surfaceWidth, size->y / shape->surfaceHeight};
         
-        for (const auto& rect : collisionRectangles) {
+        for (const auto& rect : shape->rectangles) {
             Rectangle worldRect;
             worldRect.begin = {
                 worldPos.x + rect.begin.x * scale.x,
@@ -209,10 +261,8 @@ class ICollidable : virtual public GameObject {
                 worldPos.x + rect.end.x * scale.x,
                 worldPos.y + rect.end.y * scale.y
             };
-            transformed.push_back(worldRect);
+            out.push_back(worldRect);
         }
-        
-        return transformed;
     } 
     
     virtual void onCollisionEnter(ICollidable* other){
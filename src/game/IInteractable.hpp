@@ -2,9 +2,10 @@
 #include <SDL.h>
 #include "GameObject.hpp"
 #include "ICollidable.hpp"
+#include "Registered.hpp"
 #include <set>
 
-class IInteractable : virtual public ICollidable {
+class IInteractable : virtual public ICollidable, public Registered<IInteractable> {
     private:
     std::set<SDL_Keycode> interactKeys;
     public:
@@ -12,11 +13,12 @@ class IInteractable : virtual public ICollidable {
         : ICollidable(pos, sizeMultiplier, spritePath, renderer, isComplex, zIndex), interactKeys(interactKeys)
         , GameObject(pos, sizeMultiplier, spritePath, renderer, zIndex)
     {
+        setCapability(this);
     }
     virtual void onInteract(SDL_Keycode key){
      // To be implemented in subclasses
     }
-    std::set<SDL_Keycode> getInteractKeys(){
+    const std::set<SDL_Keycode>& getInteractKeys() const {
         return interactKeys;
     }
 };
\ No newline at end of file
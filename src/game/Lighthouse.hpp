@@ -1,8 +1,18 @@
 #pragma once
 #include "IInteractable.hpp"
+#include "Lighting.hpp"
 #include "SDL.h"
+#include <algorithm>
+#include <cmath>
 
 extern void openLighthouseShop();
+extern float g_sunIntensity;
+
+// Lighthouse glow configuration (tweakable at runtime)
+extern float g_lighthouseGlowBaseRadius;      // base radius (pixels) when it's bright
+extern float g_lighthouseGlowExtraRadius;     // extra radius added when fully dark
+extern float g_lighthouseGlowIntensityMultiplier; // multiplier applied to alpha/intensity
+extern float g_dayTimeSeconds; // for subtle pulsing of lights
 class Lighthouse : public IInteractable {
 public:
     Lighthouse(Vector2 pos, Vector2 sizeMultiplier, SDL_Renderer* renderer, int zIndex = 0)
@@ -12,8 +22,14 @@ public:
     {
     }
 
-    // Declare the shop toggle implemented in main.cpp
-    
+    // Glow grows with darkness and pulses slightly to feel alive
+    void update(float dt) override {
+        float darkness = 1.0f - g_sunIntensity;
+        float pulse = 0.95f + 0.05f * std::sin(g_dayTimeSeconds * 2.0f);
+        glow.radius = (g_lighthouseGlowBaseRadius + g_lighthouseGlowExtraRadius * darkness) * pulse;
+        glow.intensity = std::clamp(darkness * g_lighthouseGlowIntensityMultiplier, 0.0f, 1.0f);
+    }
+
     void onInteract(SDL_Keycode key) override {
         SDL_Log("Lighthouse interacted with key: %d", key);
         if (key == SDLK_e) {
@@ -21,4 +37,8 @@ public:
             openLighthouseShop();
         }
     }
+
+private:
+    // Red beacon light near the top of the tower
+    Light glow{this, {0.5f, 0.12f}, 0.0f, SDL_Color{255, 110, 100, 255}, 0.0f};
 };
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "GameObject.hpp"
+#include "Registered.hpp"
+#include "Vector2.hpp"
+
+// A light that follows a GameObject. Owners keep one as a member; it registers
+// itself on construction (see Registered), so the lighting pass never has to
+// search the scene. Created, changed and destroyed on the main thread only.
+class Light : public Registered<Light> {
+public:
+    Light(GameObject* owner, Vector2 anchor, float radius, SDL_Color color, float intensity = 1.0f)
+        : owner(owner), anchor(anchor), radius(radius), color(color), intensity(intensity) {}
+
+    Light(const Light&) = delete;
+    Light& operator=(const Light&) = delete;
+
+    GameObject* owner;
+    Vector2 anchor;    // centre of the light as a fraction of the owner's size
+    float radius;      // world pixels
+    SDL_Color color;
+    float intensity;   // 0..1
+    bool enabled = true;
+};
+
+// Night lighting. Every enabled Light of a visible owner is added into a
+// low-resolution render target cleared to the ambient level, and the result is
+// multiplied over the world in one copy. All lights go out in a single
+// SDL_RenderGeometry call, so the pass costs about the same for one light or
+// hundreds. Without render target support it falls back to darkening the
+// screen uniformly.
+class Lightmap {
+public:
+    static constexpr int DOWNSCALE = 4;       // screen pixels per lightmap pixel, per axis
+    static constexpr int FALLOFF_SIZE = 128;
+    static constexpr float MAX_DARKNESS = 220.0f; // how much of 255 is taken away at midnight
+
+    Lightmap() = default;
+    ~Lightmap() {
+        if (target) SDL_DestroyTexture(target);
+        if (falloff) SDL_DestroyTexture(falloff);
+    }
+
+    Lightmap(const Lightmap&) = delete;
+    Lightmap& operator=(const Lightmap&) = delete;
+
+    // Darkens the frame drawn so far for the given sun intensity; nothing to do in daylight
+    void render(SDL_Renderer* renderer, Vector2 cameraPos, float zoom, Vector2 displaySize, float sunIntensity) {
+        Uint8 nightAlpha = static_cast<Uint8>((1.0f - sunIntensity) * MAX_DARKNESS);
+        if (nightAlpha <= 2) return;
+        const int screenW = static_cast<int>(displaySize.x), screenH = static_cast<int>(displaySize.y);
+
+        if (!ensureTextures(renderer, screenW, screenH)) {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, nightAlpha);
+            SDL_Rect screenRect = {0, 0, screenW, screenH};
+            SDL_RenderFillRect(renderer, &screenRect);
+            return;
+        }
+
+        vertices.clear();
+        indices.clear();
+        const float scale = zoom / DOWNSCALE;
+        for (const Light* light : Light::all()) {
+            if (!light->enabled || light->intensity <= 0.0f || !light->owner->getVisible()) continue;
+            Vector2 worldPos = light->owner->getWorldPosition();
+            const Vector2* sz = light->owner->getSize();
+            float cx = (worldPos.x + sz->x * light->anchor.x - cameraPos.x) * scale;
+            float cy = (worldPos.y + sz->y * light->anchor.y - cameraPos.y) * scale;
+            float r = light->radius * scale;
+            if (cx + r < 0.0f || cy + r < 0.0f || cx - r > mapW || cy - r > mapH) continue;
+
+            SDL_Color c = light->color;
+            c.a = static_cast<Uint8>(std::clamp(light->intensity, 0.0f, 1.0f) * 255.0f);
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back({{cx - r, cy - r}, c, {0.0f, 0.0f}});
+            vertices.push_back({{cx + r, cy - r}, c, {1.0f, 0.0f}});
+            vertices.push_back({{cx + r, cy + r}, c, {1.0f, 1.0f}});
+            vertices.push_back({{cx - r, cy + r}, c, {0.0f, 1.0f}});
+            for (int k : {0, 1, 2, 0, 2, 3}) indices.push_back(base + k);
+        }
+
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, target);
+        Uint8 ambient = static_cast<Uint8>(255 - nightAlpha);
+        SDL_SetRenderDrawColor(renderer, ambient, ambient, ambient, 255);
+        SDL_RenderClear(renderer);
+        if (!vertices.empty()) {
+            SDL_RenderGeometry(renderer, falloff, vertices.data(), static_cast<int>(vertices.size()),
+                               indices.data(), static_cast<int>(indices.size()));
+        }
+        SDL_SetRenderTarget(renderer, previousTarget);
+        SDL_RenderCopy(renderer, target, nullptr, nullptr);
+    }
+
+private:
+    bool ensureTextures(SDL_Renderer* renderer, int screenW, int screenH) {
+        if (unsupported) return false;
+        if (!SDL_RenderTargetSupported(renderer)) {
+            unsupported = true;
+            return false;
+        }
+        if (!falloff) {
+            falloff = createFalloff(renderer);
+            if (!falloff) {
+                unsupported = true;
+                return false;
+            }
+        }
+        int w = std::max(1, (screenW + DOWNSCALE - 1) / DOWNSCALE);
+        int h = std::max(1, (screenH + DOWNSCALE - 1) / DOWNSCALE);
+        if (target && w == mapW && h == mapH) return true;
+        if (target) SDL_DestroyTexture(target);
+        target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!target) {
+            std::cerr << "Warning: could not create lightmap, using flat night overlay: " << SDL_GetError() << "\n";
+            unsupported = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(target, SDL_BLENDMODE_MOD);
+        SDL_SetTextureScaleMode(target, SDL_ScaleModeLinear);
+        mapW = w;
+        mapH = h;
+        return true;
+    }
+
+    // White disc with alpha falling off from the centre; drawn additively, tinted by vertex colour
+    static SDL_Texture* createFalloff(SDL_Renderer* renderer) {
+        SDL_Surface* surf = SDL_CreateRGBSurfaceWithFormat(0, FALLOFF_SIZE, FALLOFF_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surf) return nullptr;
+        const float c = FALLOFF_SIZE / 2.0f;
+        for (int y = 0; y < FALLOFF_SIZE; ++y) {
+            Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surf->pixels) + y * surf->pitch);
+            for (int x = 0; x < FALLOFF_SIZE; ++x) {
+                float dx = x + 0.5f - c, dy = y + 0.5f - c;
+                float t = std::clamp(1.0f - std::sqrt(dx * dx + dy * dy) / c, 0.0f, 1.0f);
+                float alphaF = std::min(1.0f, std::pow(t, 1.2f) * 1.15f);
+                row[x] = SDL_MapRGBA(surf->format, 255, 255, 255, static_cast<Uint8>(alphaF * 255.0f));
+            }
+        }
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+        SDL_FreeSurface(surf);
+        if (tex) {
+            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_ADD);
+            SDL_SetTextureScaleMode(tex, SDL_ScaleModeLinear);
+        }
+        return tex;
+    }
+
+    SDL_Texture* target = nullptr;
+    SDL_Texture* falloff = nullptr;
+    int mapW = 0, mapH = 0;
+    bool unsupported = false;
+    std::vector<SDL_Vertex> vertices; // reused by render()
+    std::vector<int> indices;
+};
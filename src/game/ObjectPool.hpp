@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Storage for objects of one class, recycled through a free list. Blocks come
+// in chunks and are never given back to the heap, so once the pool is warm
+// new and delete of T cost a pointer swap. Classes opt in by deriving from
+// Pooled<T>. Main thread only.
+template <typename T>
+class ObjectPool {
+public:
+    static ObjectPool& instance() {
+        static ObjectPool pool;
+        return pool;
+    }
+
+    // Makes room for `count` live objects without further heap allocation
+    void reserve(size_t count) {
+        if (count > capacity) grow(count - capacity);
+    }
+
+    void* allocate(size_t size) {
+        if (size != sizeof(T)) return ::operator new(size); // a class derived from T
+        if (!freeList) grow(capacity > 0 ? capacity : 16);
+        Block* block = freeList;
+        freeList = block->next;
+        ++live;
+        return block->storage;
+    }
+
+    void deallocate(void* p, size_t size) {
+        if (!p) return;
+        if (size != sizeof(T)) {
+            ::operator delete(p);
+            return;
+        }
+        Block* block = reinterpret_cast<Block*>(p);
+        block->next = freeList;
+        freeList = block;
+        --live;
+    }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getLive() const { return live; }
+
+private:
+    union Block {
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    ObjectPool() = default;
+
+    void grow(size_t count) {
+        chunks.push_back(std::make_unique<Block[]>(count));
+        Block* chunk = chunks.back().get();
+        for (size_t i = count; i-- > 0;) {
+            chunk[i].next = freeList;
+            freeList = &chunk[i];
+        }
+        capacity += count;
+    }
+
+    std::vector<std::unique_ptr<Block[]>> chunks;
+    Block* freeList = nullptr;
+    size_t capacity = 0;
+    size_t live = 0;
+};
+
+// Routes new/delete of T through ObjectPool<T>. T needs a virtual destructor
+// (GameObject has one), so deleting through a base pointer returns the block.
+template <typename T>
+class Pooled {
+public:
+    static void* operator new(size_t size) { return ObjectPool<T>::instance().allocate(size); }
+    static void operator delete(void* p, size_t size) { ObjectPool<T>::instance().deallocate(p, size); }
+
+protected:
+    Pooled() = default;
+};
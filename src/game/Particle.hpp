@@ -2,6 +2,7 @@
 #include <SDL.h>
 #include "GameObject.hpp"
 #include <random>
+#include "../core/Random.hpp"
 #include <cmath>
 
 class Particle : public GameObject {
@@ -23,7 +24,7 @@ public:
 
     Particle(Vector2 pos,Vector2 endPos, float lifetime, SDL_Renderer* renderer, SDL_Color color, int zIndex)
         : GameObject(pos, {1.0f, 1.0f}, createParticleTexture(renderer, color), renderer, zIndex), pos(pos), endPos(endPos), color(color) ,startPos(pos), lifetime(lifetime) {
-        static thread_local std::mt19937 rng(std::random_device{}());
+        static thread_local std::mt19937 rng(nextRandomSeed());
         std::uniform_real_distribution<float> phaseDist(0.0f, 2.0f * 3.14159265f);
         std::uniform_real_distribution<float> freqDist(1.0f, 3.0f);
         std::uniform_real_distribution<float> ampDist(2.0f, 12.0f);
@@ -42,6 +43,8 @@ public:
         return texture;
     }
 
+    bool updatesInParallel() const override { return true; }
+
     void update(float dt) override {
         age += dt;
         t = age / lifetime;
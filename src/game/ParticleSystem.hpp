@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
+#include <algorithm>
 #include <random>
+#include "../core/Random.hpp"
+#include "../core/JobSystem.hpp"
 #include <SDL.h>
 #include "Vector2.hpp"
 
@@ -9,7 +12,26 @@
 class ParticleSystem  {
 
 public:
-    ParticleSystem(SDL_Renderer* renderer) : rng(std::random_device{}()), renderer(renderer) {}
+    ParticleSystem(SDL_Renderer* renderer) : rng(nextRandomSeed()), renderer(renderer) {
+        registry().push_back(this);
+    }
+
+    ~ParticleSystem() {
+        auto& systems = registry();
+        systems.erase(std::remove(systems.begin(), systems.end(), this), systems.end());
+    }
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // Alive particles over every system in existence (perf HUD counter)
+    static size_t countAlive() {
+        size_t alive = 0;
+        for (ParticleSystem* system : registry()) {
+            for (const Particle& p : system->particles) if (p.alive) ++alive;
+        }
+        return alive;
+    }
     
     void emit(const Vector2& start, const Vector2& end, int count, SDL_Color color,float duration, int zIndex,float spread = 10.0f) {
         std::uniform_real_distribution<float> noise(-spread, spread);
@@ -40,10 +62,13 @@ public:
         emitFromStarts(starts, end, duration, color, zIndex);
     }
 
+    // Particle::update only moves the particle itself, so large bursts are split across the job system
     void update(float dt) {
-        for (auto& p : particles) {
-            p.update(dt);
-        }
+        JobSystem::instance().parallelFor(particles.size(), 256, [this, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                particles[i].update(dt);
+            }
+        });
     }
 
     void render(SDL_Renderer* renderer, const Vector2& camPos, float zoom) {
@@ -52,7 +77,7 @@ public:
             SDL_Texture* tex = p.getSprite();
             if (!tex) continue;
             Vector2 worldPos = p.pos; // Particle stores world position
-            Vector2* sz = p.getSize();
+            const Vector2* sz = p.getSize();
             SDL_Rect dstRect = {
                 static_cast<int>((worldPos.x - camPos.x) * zoom),
                 static_cast<int>((worldPos.y - camPos.y) * zoom),
@@ -72,6 +97,11 @@ public:
    
 
 private:
+    static std::vector<ParticleSystem*>& registry() {
+        static std::vector<ParticleSystem*> systems;
+        return systems;
+    }
+
     std::vector<Particle> particles;
     std::mt19937 rng;
     SDL_Renderer* renderer;
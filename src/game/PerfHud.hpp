@@ -0,0 +1,274 @@
+#pragma once
+
+#include <SDL.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include "Text.hpp"
+#include "../core/AllocTracker.hpp"
+#include "../core/Profiler.hpp"
+#include "../net/NetStats.hpp"
+
+// Parts of the frame the HUD reports CPU time for
+enum class PerfSection : uint8_t {
+    Input,
+    Network,
+    Chunks,
+    Update,
+    Collision,
+    Render,
+    UI,
+    Present,
+    Count
+};
+
+inline const char* perfSectionName(PerfSection section) {
+    static const char* names[] = {"input", "network", "chunks", "update", "collision", "render", "ui", "present"};
+    return names[static_cast<int>(section)];
+}
+
+// World totals shown under the timings; filled in by the game when the text refreshes
+struct PerfCounters {
+    size_t gameObjects = 0;
+    size_t colliders = 0;
+    size_t particles = 0;
+    size_t chunks = 0;
+    size_t textures = 0;
+};
+
+// Performance overlay toggled in game (F4): a frame time graph of the last
+// FRAME_HISTORY frames, CPU time per PerfSection, world counters and network
+// bandwidth. Unlike the profiler it is compiled into every build, so it can be
+// used on player machines. Lines are re-formatted every REFRESH_SECONDS so the
+// numbers stay readable; drawing a frame does not allocate.
+class PerfHud {
+public:
+    static constexpr int FRAME_HISTORY = 240;
+    static constexpr float REFRESH_SECONDS = 0.5f;
+    static constexpr float GRAPH_HEIGHT = 60.0f;
+    static constexpr float GRAPH_MAX_MS = 50.0f; // frame time at the top of the graph
+
+    static PerfHud& instance() {
+        static PerfHud inst;
+        return inst;
+    }
+
+    // Times a scope into the current frame's section (ticks that run twice add up)
+    class Scope {
+    public:
+        explicit Scope(PerfSection section) : section(section), start(SDL_GetPerformanceCounter()) {}
+        ~Scope() { end(); }
+
+        // Ends the scope early (for ranges of statements that are not a block)
+        void end() {
+            if (ended) return;
+            PerfHud::instance().addTime(section, SDL_GetPerformanceCounter() - start);
+            ended = true;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PerfSection section;
+        Uint64 start;
+        bool ended = false;
+    };
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    void setCounterSource(std::function<PerfCounters()> source) { counterSource = std::move(source); }
+
+    void addTime(PerfSection section, Uint64 counts) {
+        frameCounts[static_cast<int>(section)] += counts;
+    }
+
+    // Call once at the top of every frame with the time the previous frame took
+    void beginFrame(double frameSeconds) {
+        frameMs[frameHead] = static_cast<float>(frameSeconds * 1000.0);
+        frameHead = (frameHead + 1) % FRAME_HISTORY;
+        frameFilled = std::min(frameFilled + 1, FRAME_HISTORY);
+        for (int i = 0; i < SECTION_COUNT; ++i) {
+            windowCounts[i] += frameCounts[i];
+            frameCounts[i] = 0;
+        }
+        ++windowFrames;
+        refreshTimer += static_cast<float>(frameSeconds);
+    }
+
+    // Drawn by Camera::renderOverlays in the top-right corner of a view screenWidth wide
+    void render(SDL_Renderer* renderer, int screenWidth) {
+        if (!visible) return;
+        if (lines[0] == nullptr || refreshTimer >= REFRESH_SECONDS) refreshText(renderer);
+
+        const int panelW = FRAME_HISTORY + 16;
+        const int panelX = screenWidth - panelW - 8;
+        const int panelY = 8;
+        int textH = 0;
+        for (Text* t : lines) if (t) textH += LINE_HEIGHT;
+        SDL_Rect bg = {panelX, panelY, panelW, static_cast<int>(GRAPH_HEIGHT) + textH + 24};
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+        SDL_RenderFillRect(renderer, &bg);
+
+        // Frame graph, oldest on the left; green under 60 fps budget, yellow under 30, red above
+        const int graphX = panelX + 8;
+        const int graphBottom = panelY + 8 + static_cast<int>(GRAPH_HEIGHT);
+        int okCount = 0, slowCount = 0, hitchCount = 0;
+        for (int i = 0; i < frameFilled; ++i) {
+            float ms = frameMs[(frameHead - frameFilled + i + FRAME_HISTORY) % FRAME_HISTORY];
+            int h = std::max(1, static_cast<int>(std::min(ms, GRAPH_MAX_MS) / GRAPH_MAX_MS * GRAPH_HEIGHT));
+            SDL_Rect bar = {graphX + FRAME_HISTORY - frameFilled + i, graphBottom - h, 1, h};
+            if (ms <= 1000.0f / 60.0f + 0.5f) okBars[okCount++] = bar;
+            else if (ms <= 1000.0f / 30.0f + 0.5f) slowBars[slowCount++] = bar;
+            else hitchBars[hitchCount++] = bar;
+        }
+        SDL_SetRenderDrawColor(renderer, 80, 200, 80, 255);
+        SDL_RenderFillRects(renderer, okBars.data(), okCount);
+        SDL_SetRenderDrawColor(renderer, 220, 200, 60, 255);
+        SDL_RenderFillRects(renderer, slowBars.data(), slowCount);
+        SDL_SetRenderDrawColor(renderer, 220, 60, 60, 255);
+        SDL_RenderFillRects(renderer, hitchBars.data(), hitchCount);
+        // Budget lines at 60 and 30 fps
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 90);
+        for (float budget : {1000.0f / 60.0f, 1000.0f / 30.0f}) {
+            int y = graphBottom - static_cast<int>(budget / GRAPH_MAX_MS * GRAPH_HEIGHT);
+            SDL_RenderDrawLine(renderer, graphX, y, graphX + FRAME_HISTORY - 1, y);
+        }
+
+        int y = graphBottom + 8;
+        for (Text* t : lines) {
+            if (!t) continue;
+            t->setPosition({static_cast<float>(graphX), static_cast<float>(y)});
+            t->drawUI(renderer);
+            y += LINE_HEIGHT;
+        }
+    }
+
+private:
+    static constexpr int SECTION_COUNT = static_cast<int>(PerfSection::Count);
+    static constexpr int LINE_COUNT = SECTION_COUNT + 5; // frame, sections, two counter lines, network, allocations
+    static constexpr int LINE_HEIGHT = 16;
+
+    PerfHud() = default;
+
+    void refreshText(SDL_Renderer* renderer) {
+        char buf[128];
+        int line = 0;
+        auto setLine = [&](const char* text) {
+            if (!lines[line]) {
+                lineText[line] = text;
+                lines[line] = new Text({0.0f, 0.0f}, lineText[line], "./fonts/font.ttf", 14, renderer, SDL_Color{255,255,255,255}, LAYER_UI);
+            } else if (lineText[line] != text) {
+                lineText[line] = text;
+                lines[line]->setText(lineText[line]);
+            }
+            ++line;
+        };
+
+        float sum = 0.0f, worst = 0.0f;
+        for (int i = 0; i < frameFilled; ++i) {
+            float ms = frameMs[(frameHead - 1 - i + FRAME_HISTORY) % FRAME_HISTORY];
+            sum += ms;
+            worst = std::max(worst, ms);
+        }
+        float avg = frameFilled > 0 ? sum / frameFilled : 0.0f;
+        std::snprintf(buf, sizeof(buf), "frame %.1f ms (%.0f fps)  max %.1f ms", avg, avg > 0.0f ? 1000.0f / avg : 0.0f, worst);
+        setLine(buf);
+
+        double countsPerMs = static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0;
+        for (int i = 0; i < SECTION_COUNT; ++i) {
+            double ms = windowFrames > 0 ? windowCounts[i] / countsPerMs / windowFrames : 0.0;
+            std::snprintf(buf, sizeof(buf), "%-10s %6.2f ms", perfSectionName(static_cast<PerfSection>(i)), ms);
+            setLine(buf);
+            windowCounts[i] = 0;
+        }
+        windowFrames = 0;
+        refreshTimer = 0.0f;
+
+        PerfCounters c = counterSource ? counterSource() : PerfCounters{};
+        std::snprintf(buf, sizeof(buf), "objects %zu  colliders %zu  particles %zu", c.gameObjects, c.colliders, c.particles);
+        setLine(buf);
+        std::snprintf(buf, sizeof(buf), "chunks %zu  textures %zu", c.chunks, c.textures);
+        setLine(buf);
+
+        uint64_t bytesIn = 0, bytesOut = 0;
+        for (const auto& [key, peer] : NetStats::instance().getPeers()) {
+            for (int m = 0; m < static_cast<int>(NetMsg::Count); ++m) {
+                bytesIn += peer.rateIn[m].bytes;
+                bytesOut += peer.rateOut[m].bytes;
+            }
+        }
+        std::snprintf(buf, sizeof(buf), "net in %.1f kbps  out %.1f kbps", bytesIn * 8.0 / 1000.0, bytesOut * 8.0 / 1000.0);
+        setLine(buf);
+
+        AllocTracker& allocs = AllocTracker::instance();
+        if (AllocTracker::enabled()) {
+            AllocCounts last = allocs.getLastFrame();
+            std::snprintf(buf, sizeof(buf), "allocs/frame %llu (%.1f KB)  over budget %llu",
+                static_cast<unsigned long long>(last.allocs), last.bytes / 1024.0,
+                static_cast<unsigned long long>(allocs.getFramesOverBudget()));
+        } else {
+            std::snprintf(buf, sizeof(buf), "allocs: tracking off");
+        }
+        setLine(buf);
+    }
+
+    bool visible = false;
+
+    std::array<float, FRAME_HISTORY> frameMs{};
+    int frameHead = 0;
+    int frameFilled = 0;
+    std::array<SDL_Rect, FRAME_HISTORY> okBars{};
+    std::array<SDL_Rect, FRAME_HISTORY> slowBars{};
+    std::array<SDL_Rect, FRAME_HISTORY> hitchBars{};
+
+    std::array<Uint64, SECTION_COUNT> frameCounts{};
+    std::array<Uint64, SECTION_COUNT> windowCounts{};
+    int windowFrames = 0;
+    float refreshTimer = 0.0f;
+
+    std::function<PerfCounters()> counterSource;
+    std::array<Text*, LINE_COUNT> lines{};
+    std::array<std::string, LINE_COUNT> lineText;
+};
+
+// One instrumented range for both tools: the section's HUD time in every build and,
+// in STRANDED_PROFILE builds, a profiler zone with the same extent. Ranges that only
+// matter to the trace use PROFILE_ZONE.
+class PerfZone {
+public:
+    PerfZone(const char* name, PerfSection section)
+        : hud(section)
+#ifdef STRANDED_PROFILE
+        , zone(name)
+#endif
+    {
+        (void)name;
+    }
+
+    // Ends both before the scope does (for ranges of statements that are not a block)
+    void end() {
+#ifdef STRANDED_PROFILE
+        zone.end();
+#endif
+        hud.end();
+    }
+
+    PerfZone(const PerfZone&) = delete;
+    PerfZone& operator=(const PerfZone&) = delete;
+
+private:
+    PerfHud::Scope hud;
+#ifdef STRANDED_PROFILE
+    ProfileZone zone;
+#endif
+};
+
+#define PERF_ZONE(name, section) PerfZone PROFILE_CONCAT(perfZone_, __LINE__)(name, section)
+#define PERF_ZONE_NAMED(var, name, section) PerfZone var(name, section)
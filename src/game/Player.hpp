@@ -14,10 +14,12 @@ extern void hostBroadcastParticleForHook(const Vector2& hookTip);
 #include "Rod.hpp"
 #include "FishingHook.hpp"
 #include "Gun.hpp"
+#include "Lighting.hpp"
+#include "World.hpp"
 #include <vector>
 
 // Access global gameObjects so Player can register projectiles
-extern std::vector<GameObject*> gameObjects;
+extern World gameObjects;
 
 class Player : public IAnimatable, public ICollidable {
 private:
@@ -38,6 +40,9 @@ private:
     // Health
     float maxHp = 100.0f;
     float hp = 100.0f;
+
+    // Warm lantern carried at night
+    Light lantern{this, {0.5f, 0.5f}, 110.0f, SDL_Color{255, 210, 150, 255}};
     
 public:
     enum Equipment {EQUIP_NONE = 0, EQUIP_ROD = 1, EQUIP_HARPOON = 2};
@@ -65,7 +70,7 @@ public:
         SDL_Renderer* renderer,
         float animationStep,
         int zIndex = 0)
-        : GameObject(pos, sizeMultiplier, spritePaths[0], renderer, zIndex),
+        : GameObject(pos, sizeMultiplier, static_cast<SDL_Texture*>(nullptr), renderer, zIndex), // IAnimatable sets the frame
           IAnimatable(pos, sizeMultiplier, spritePaths, frameCount, renderer, animationStep, zIndex),
           ICollidable(pos, sizeMultiplier, spritePaths[0], renderer, false, zIndex),
           renderer(renderer)
@@ -202,9 +207,7 @@ public:
                 bool fired = gun->fireAt(worldMousePos);
                 if (fired) {
                     // Ensure projectile is part of global updates
-                    if (std::find(gameObjects.begin(), gameObjects.end(), proj) == gameObjects.end()) {
-                        gameObjects.push_back(proj);
-                    }
+                    gameObjects.add(proj);
                     SoundManager::instance().playSound("shoot", 0, MIX_MAX_VOLUME);
                 }
             }
@@ -221,7 +224,7 @@ public:
             };
             // Get rod's world position (where the rod tip is)
             Vector2 rodWorld = rod->getWorldPosition();
-            Vector2* rodSize = rod->getSize();
+            const Vector2* rodSize = rod->getSize();
             Vector2 rodTip = {
                 rodWorld.x + rodSize->x / 2.0f,
                 rodWorld.y + rodSize->y
@@ -248,7 +251,7 @@ public:
         // The actual hook update is handled by the global gameObjects update loop to avoid double-updating.
         if (fishingHook && rod) {
             Vector2 rodWorld = rod->getWorldPosition();
-            Vector2* rodSize = rod->getSize();
+            const Vector2* rodSize = rod->getSize();
             Vector2 rodTip = {
                 rodWorld.x + rodSize->x / 2.0f,
                 rodWorld.y + rodSize->y
@@ -261,8 +264,7 @@ public:
             fishingHook->retract();
         }
         
-        Vector2* pos = getPosition();
-        prevPosition = *pos;  // Save before movement
+        prevPosition = *getPosition();  // Save before movement
 
         // Update child-only objects that need per-frame logic (e.g., gun cooldown)
         if (gun) gun->update(dt);
@@ -282,8 +284,7 @@ public:
 
             velocity.x = dx;
             velocity.y = dy;
-            pos->x += dx * dt;
-            pos->y += dy * dt;
+            changePosition(dx * dt, dy * dt);
             startAnimation();
             // Start walking sound if not already playing and only for local players
             if (!walkingSoundPlaying && !isRemote) {
@@ -311,34 +312,28 @@ public:
     }
 
     void applyVelocity(float dt) {
-        Vector2* pos = getPosition();
-        pos->x += velocity.x * dt;
-        pos->y += velocity.y * dt;
+        changePosition(velocity.x * dt, velocity.y * dt);
     }
 
     // Method to move player externally (e.g., by boat)
     void moveExternally(float dx, float dy) {
         changePosition(dx, dy);
         // Update prevPosition so collision response doesn't revert this movement
-        Vector2* pos = getPosition();
-        prevPosition = *pos;
+        prevPosition = *getPosition();
     }
 
     void updatePrevPosition() {
-        Vector2* pos = getPosition();
-        prevPosition = *pos;
+        prevPosition = *getPosition();
     }
 
     void onCollisionEnter(ICollidable* other) override {
-        Vector2* pos = getPosition();
-        *pos = prevPosition;  // Revert to last valid position
+        setPosition(prevPosition);  // Revert to last valid position
         SDL_Log("Player collided!");
     }
 
     void onCollisionStay(ICollidable* other) override {
         // Optional: Handle continuous collision
-        Vector2* pos = getPosition();
-        *pos = prevPosition;  // Revert to last valid position
+        setPosition(prevPosition);  // Revert to last valid position
         
     }
 
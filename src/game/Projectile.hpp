@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameObject.hpp"
+#include "Lighting.hpp"
 #include <SDL.h>
 
 // Simple projectile (harpoon shot) which moves toward a target and despawns on impact or timeout
@@ -12,14 +13,14 @@ private:
     float speed = 360.0f; // pixels per second (reduced for better feel)
     float life = 3.0f; // seconds
     bool active = false;
+    Light glow{this, {0.5f, 0.5f}, 40.0f, SDL_Color{170, 210, 255, 255}, 0.8f};
 public:
     Projectile(const Vector2& pos, const Vector2& sizeMultiplier, const char* spritePath, SDL_Renderer* renderer, int zIndex = 0)
         : GameObject(pos, sizeMultiplier, spritePath, renderer, zIndex) {}
 
     // Fire towards an explicit world target; projectile will stop at target
     void fire(const Vector2& start, const Vector2& targ) {
-        Vector2* p = getPosition();
-        p->x = start.x; p->y = start.y;
+        setPosition(start);
         target = targ;
         hasTarget = true;
         Vector2 dir = { target.x - start.x, target.y - start.y };
@@ -42,14 +43,15 @@ public:
 
     bool isActive() const { return active; }
 
+    bool updatesInParallel() const override { return true; }
+
     Vector2 getTargetPos() const { return target; }
 
     void setState(const Vector2& pos, const Vector2& targ, bool act) {
-        Vector2* p = getPosition();
-        p->x = pos.x; p->y = pos.y;
+        setPosition(pos);
         target = targ;
         hasTarget = true;
-        Vector2 dir = { target.x - p->x, target.y - p->y };
+        Vector2 dir = { target.x - pos.x, target.y - pos.y };
         float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
         if (len > 0.001f) { dir.x /= len; dir.y /= len; }
         velocity.x = dir.x * speed;
@@ -65,7 +67,7 @@ public:
 
     void update(float dt) override {
         if (!active) return;
-        Vector2* p = getPosition();
+        const Vector2* p = getPosition();
         // Move by velocity but clamp to target; stop when reaching target
         float step = speed * dt;
         float dx = target.x - p->x;
@@ -73,16 +75,14 @@ public:
         float dist = std::sqrt(dx*dx + dy*dy);
         if (hasTarget && dist <= step) {
             // Arrived (or would overshoot) -> snap to target and deactivate
-            p->x = target.x;
-            p->y = target.y;
+            setPosition(target);
             active = false;
             hasTarget = false;
             setVisible(false);
             return;
         }
         // Normal move
-        p->x += velocity.x * dt;
-        p->y += velocity.y * dt;
+        changePosition(velocity.x * dt, velocity.y * dt);
         life -= dt;
         if (life <= 0.0f) {
             active = false;
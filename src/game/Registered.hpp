@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+// Intrusive list of every live T, in creation order. T derives from
+// Registered<T>, so code looking for one kind of object walks only those
+// instead of casting its way through all of gameObjects. The links live in
+// the base, so registering and unregistering are O(1) and never allocate.
+// Instances are created and destroyed on the main thread only; do not create
+// or destroy a T while iterating all().
+template <typename T>
+class Registered {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T*;
+
+        explicit Iterator(Registered* node) : node(node) {}
+        T* operator*() const { return static_cast<T*>(node); }
+        Iterator& operator++() { node = node->next; return *this; }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        Registered* node;
+    };
+
+    // Every live T, oldest first; use with range-for
+    class Range {
+    public:
+        Iterator begin() const { return Iterator(head()); }
+        Iterator end() const { return Iterator(nullptr); }
+        bool empty() const { return head() == nullptr; }
+    };
+
+    static Range all() { return Range(); }
+
+protected:
+    Registered() {
+        prev = tail();
+        if (prev) prev->next = this;
+        else head() = this;
+        tail() = this;
+    }
+    Registered(const Registered&) : Registered() {}
+    Registered& operator=(const Registered&) { return *this; }
+
+    ~Registered() {
+        if (prev) prev->next = next;
+        else head() = next;
+        if (next) next->prev = prev;
+        else tail() = prev;
+    }
+
+private:
+    Registered* prev = nullptr;
+    Registered* next = nullptr;
+
+    static Registered*& head() {
+        static Registered* first = nullptr;
+        return first;
+    }
+    static Registered*& tail() {
+        static Registered* last = nullptr;
+        return last;
+    }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "GameObject.hpp"
+#include "Vector2.hpp"
+
+// Smooths rendering when the simulation runs at a fixed tick rate that differs from
+// the display rate. Before each tick the local transforms are captured; before a
+// render the objects are moved to a blend of the previous and current tick, and
+// afterwards put back, so the simulation (and replay hashes) never see the blend.
+class RenderInterpolator {
+    private:
+        struct Transform {
+            Vector2 position;
+            float rotation;
+            GameObject* parent;
+        };
+
+        struct Captured {
+            EntityHandle handle; // whose transform this is; stale once the slot is reused
+            Transform transform;
+        };
+
+        // Snapping instead of sliding across the map when something is placed or reparented
+        static constexpr float TELEPORT_DISTANCE = 200.0f;
+
+        // Indexed by World slot and kept between ticks, so capturing allocates only
+        // when the world grows. An entry counts only while its handle matches the
+        // object's, since pools and the World hand out the same memory and slots again.
+        std::vector<Captured> previous;
+        std::vector<std::pair<GameObject*, Transform>> current; // restored after rendering
+
+        static float lerpAngle(float from, float to, float t) {
+            float delta = std::fmod(to - from, 360.0f);
+            if (delta > 180.0f) delta -= 360.0f;
+            else if (delta < -180.0f) delta += 360.0f;
+            return from + delta * t;
+        }
+
+    public:
+        // Call before every simulation tick
+        void capture(const std::vector<GameObject*>& objects) {
+            for (GameObject* obj : objects) {
+                EntityHandle handle = obj->getHandle();
+                if (!handle) continue;
+                if (handle.index >= previous.size()) previous.resize(handle.index + 1);
+                previous[handle.index] = Captured{handle, Transform{*obj->getPosition(), obj->getRotation(), obj->getParent()}};
+            }
+        }
+
+        // Objects that did not exist before the last tick render where they are
+        void apply(const std::vector<GameObject*>& objects, float alpha) {
+            current.clear();
+            if (alpha >= 1.0f) return;
+            for (GameObject* obj : objects) {
+                EntityHandle handle = obj->getHandle();
+                if (!handle || handle.index >= previous.size() || previous[handle.index].handle != handle) continue;
+                const Transform& prev = previous[handle.index].transform;
+                if (prev.parent != obj->getParent()) continue;
+                Vector2 pos = *obj->getPosition();
+                float dx = pos.x - prev.position.x;
+                float dy = pos.y - prev.position.y;
+                if (dx * dx + dy * dy > TELEPORT_DISTANCE * TELEPORT_DISTANCE) continue;
+                current.emplace_back(obj, Transform{pos, obj->getRotation(), obj->getParent()});
+                obj->setPosition({prev.position.x + dx * alpha, prev.position.y + dy * alpha});
+                obj->setRotation(lerpAngle(prev.rotation, obj->getRotation(), alpha));
+            }
+        }
+
+        void restore() {
+            for (auto& [obj, t] : current) {
+                obj->setPosition(t.position);
+                obj->setRotation(t.rotation);
+            }
+            current.clear();
+        }
+};
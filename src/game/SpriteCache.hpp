@@ -0,0 +1,134 @@
+#pragma once
+
+#include <SDL.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../core/AssetPack.hpp"
+#include "../core/JobSystem.hpp"
+
+// Frames of one animation side by side in a single texture. Built once per
+// renderer, file list and step, then shared read-only by every object playing it.
+struct AnimationClip {
+    SDL_Texture* atlas = nullptr;
+    std::vector<SDL_Rect> frames; // where each frame sits in the atlas, in play order
+    float step = 0.1f;            // seconds per frame
+};
+
+// Loads each sprite file (or set of animation frames) once per renderer and
+// hands out the same texture to every object that draws it, so spawning an
+// object does no disk I/O. Sprites come from the open AssetPack when they are
+// packed. Textures from here are shared: never destroy or modulate them through
+// one object. Main thread only.
+class SpriteCache {
+public:
+    static SpriteCache& instance() {
+        static SpriteCache inst;
+        return inst;
+    }
+
+    // nullptr if the file cannot be loaded (warned about once per file)
+    SDL_Texture* texture(SDL_Renderer* renderer, const char* path) {
+        auto key = std::make_pair(renderer, AssetPack::key(path));
+        auto it = textures.find(key);
+        if (it != textures.end()) return it->second;
+        return upload(renderer, key, loadSpriteSurface(path), path);
+    }
+
+    // Decodes the sprites on the job system and uploads them here, so the first
+    // texture() of each is a lookup. Names not yet cached are the only ones read.
+    void preload(SDL_Renderer* renderer, const std::vector<std::string>& paths) {
+        std::vector<std::string> pending;
+        for (const std::string& path : paths) {
+            if (!textures.count(std::make_pair(renderer, AssetPack::key(path)))) pending.push_back(path);
+        }
+        std::vector<SDL_Surface*> surfaces(pending.size(), nullptr);
+        JobSystem::instance().parallelFor(pending.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) surfaces[i] = loadSpriteSurface(pending[i].c_str());
+        });
+        for (size_t i = 0; i < pending.size(); ++i) {
+            upload(renderer, std::make_pair(renderer, AssetPack::key(pending[i])), surfaces[i], pending[i].c_str());
+        }
+    }
+
+    // Packs the frame files into one atlas. Frames that cannot be loaded are left
+    // out (with a warning); a clip without frames does not animate.
+    const AnimationClip* clip(SDL_Renderer* renderer, const char* const framePaths[], int frameCount, float step) {
+        std::string names;
+        for (int i = 0; i < frameCount; ++i) names.append(AssetPack::key(framePaths[i])).push_back('\n');
+        auto key = std::make_tuple(renderer, names, step);
+        auto it = clips.find(key);
+        if (it != clips.end()) return it->second.get();
+
+        auto built = std::make_unique<AnimationClip>();
+        built->step = step;
+        std::vector<SDL_Surface*> loaded;
+        int width = 0, height = 0;
+        for (int i = 0; i < frameCount; ++i) {
+            SDL_Surface* surface = loadSpriteSurface(framePaths[i]);
+            SDL_Surface* converted = surface ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+            if (surface) SDL_FreeSurface(surface);
+            if (!converted) {
+                std::cerr << "Warning: could not load animation frame '" << framePaths[i] << "': " << SDL_GetError() << "\n";
+                continue;
+            }
+            built->frames.push_back(SDL_Rect{width, 0, converted->w, converted->h});
+            width += converted->w;
+            height = std::max(height, converted->h);
+            loaded.push_back(converted);
+        }
+        SDL_Surface* sheet = loaded.empty() ? nullptr : SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (sheet) {
+            SDL_FillRect(sheet, nullptr, 0);
+            for (size_t i = 0; i < loaded.size(); ++i) {
+                SDL_SetSurfaceBlendMode(loaded[i], SDL_BLENDMODE_NONE);
+                SDL_Rect dst = built->frames[i];
+                SDL_BlitSurface(loaded[i], nullptr, sheet, &dst);
+            }
+            built->atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+            SDL_FreeSurface(sheet);
+        }
+        for (SDL_Surface* surface : loaded) SDL_FreeSurface(surface);
+        if (!built->atlas) built->frames.clear();
+
+        const AnimationClip* result = built.get();
+        clips[key] = std::move(built);
+        return result;
+    }
+
+    // Frees every texture and clip; call before destroying the renderer. Objects
+    // still drawing from the cache must not be rendered afterwards.
+    void clear() {
+        for (auto& [key, tex] : textures) {
+            if (tex) SDL_DestroyTexture(tex);
+        }
+        textures.clear();
+        for (auto& [key, c] : clips) {
+            if (c->atlas) SDL_DestroyTexture(c->atlas);
+        }
+        clips.clear();
+    }
+
+private:
+    SpriteCache() = default;
+
+    // Takes ownership of surface (nullptr when loading failed)
+    SDL_Texture* upload(SDL_Renderer* renderer, const std::pair<SDL_Renderer*, std::string>& key, SDL_Surface* surface, const char* path) {
+        SDL_Texture* tex = nullptr;
+        if (surface) {
+            tex = SDL_CreateTextureFromSurface(renderer, surface);
+            SDL_FreeSurface(surface);
+        }
+        if (!tex) std::cerr << "Warning: could not load sprite '" << path << "': " << SDL_GetError() << "\n";
+        textures[key] = tex;
+        return tex;
+    }
+
+    std::map<std::pair<SDL_Renderer*, std::string>, SDL_Texture*> textures;
+    std::map<std::tuple<SDL_Renderer*, std::string, float>, std::unique_ptr<AnimationClip>> clips;
+};
@@ -1,84 +1,43 @@
 #pragma once
 
 #include "UIGameObject.hpp"
-#include <SDL_ttf.h>
+#include "FontCache.hpp"
 #include <string>
 #include <SDL.h>
-#include <iostream>
 
-// Header-only Text UI element backed by SDL_ttf
+// Header-only Text UI element drawn from the shared glyph atlas of its font.
+// Changing the text or colour does no rendering or texture work, so labels
+// can be updated every frame.
 class Text : public UIGameObject {
 public:
     Text(Vector2 screenPos, const std::string& textInit, const char* fontPath, int fontSize, SDL_Renderer* renderer, SDL_Color color = {255,255,255,255}, int zIndex = 0)
-        : UIGameObject(screenPos, {1.0f, 1.0f}, nullptr, renderer, zIndex), text(textInit), color(color), renderer(renderer) {
-        font = nullptr;
-        if (fontPath) {
-            font = TTF_OpenFont(fontPath, fontSize);
-            if (!font) {
-                std::cerr << "Warning: Failed to open font '" << fontPath << "': " << TTF_GetError() << "\n";
-            }
-        }
-        rebuildTexture();
+        : UIGameObject(screenPos, {1.0f, 1.0f}, static_cast<SDL_Texture*>(nullptr), renderer, zIndex), color(color), renderer(renderer) {
+        if (fontPath) atlas = FontCache::instance().atlas(renderer, fontPath, fontSize);
+        setText(textInit);
     }
 
-    ~Text() {
-        SDL_Texture* tex = getSprite();
-        if (tex) {
-            SDL_DestroyTexture(tex);
-            setSprite(nullptr);
-        }
-        if (font) {
-            TTF_CloseFont(font);
-            font = nullptr;
-        }
+    void setText(const std::string& newText) {
+        text = newText;
+        setSize(atlas ? atlas->measure(text) : Vector2{0.0f, 0.0f});
     }
-
-    void setText(const std::string& newText) { text = newText; rebuildTexture(); }
-    void setColor(SDL_Color newColor) { color = newColor; rebuildTexture(); }
+    void setColor(SDL_Color newColor) { color = newColor; }
     bool setFont(const char* fontPath, int fontSize) {
-        if (font) {
-            TTF_CloseFont(font);
-            font = nullptr;
-        }
-        font = TTF_OpenFont(fontPath, fontSize);
-        if (!font) {
-            std::cerr << "Warning: Failed to open font '" << fontPath << "': " << TTF_GetError() << "\n";
-            return false;
-        }
-        rebuildTexture();
-        return true;
+        atlas = FontCache::instance().atlas(renderer, fontPath, fontSize);
+        setText(text);
+        return atlas != nullptr;
     }
 
-private:
-    void rebuildTexture() {
-        SDL_Texture* old = getSprite();
-        if (old) {
-            SDL_DestroyTexture(old);
-            setSprite(nullptr);
-        }
-        if (!font || !renderer) return;
-
-        SDL_Surface* surf = TTF_RenderUTF8_Blended(font, text.c_str(), color);
-        if (!surf) {
-            std::cerr << "Warning: TTF_RenderUTF8_Blended failed: " << TTF_GetError() << "\n";
-            return;
-        }
+    const std::string& getText() const { return text; }
 
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-        if (!tex) {
-            std::cerr << "Warning: SDL_CreateTextureFromSurface failed: " << SDL_GetError() << "\n";
-            SDL_FreeSurface(surf);
-            return;
-        }
-
-        // Ensure alpha blending is enabled so text renders with transparency
-        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-
-        SDL_FreeSurface(surf);
-        setSprite(tex);
+    // One batched draw from the atlas; the atlas belongs to the renderer the Text was created with
+    void drawUI(SDL_Renderer*) override {
+        if (!atlas || text.empty()) return;
+        Vector2 screenPos = getWorldPosition();
+        atlas->draw(text, screenPos.x, screenPos.y, color);
     }
 
-    TTF_Font* font = nullptr;
+private:
+    GlyphAtlas* atlas = nullptr;
     SDL_Color color{255,255,255,255};
     std::string text;
     SDL_Renderer* renderer = nullptr;
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "GameObject.hpp"
+#include "SpriteCache.hpp"
+#include "Tilemap.hpp"
+
+// A whole tilemap as one object: it keeps the compact cell grid and the shared
+// tileset texture and Camera::render draws the cells in view straight from the
+// atlas, so a map costs one object however many tiles it has. Tiles are not
+// rotated or scaled with the layer.
+class TileLayer : public GameObject {
+public:
+    TileLayer(Vector2 pos, Tilemap map, SDL_Texture* atlas, SDL_Renderer* renderer, int zIndex = 0)
+        : GameObject(pos, {1.0f, 1.0f}, static_cast<SDL_Texture*>(nullptr), renderer, zIndex),
+          map(std::move(map)),
+          atlas(atlas)
+    {
+        setCapability(this);
+        setSize({static_cast<float>(this->map.mapWidth * this->map.tileWidth),
+                 static_cast<float>(this->map.mapHeight * this->map.tileHeight)});
+    }
+
+    // Loads a tilemap.json layout (written by src/tileseteditor) over the tileset
+    // texture, which SpriteCache loads once. nullptr (logged) if either cannot be read.
+    static TileLayer* fromTileset(const char* tilemapPath, const char* tilesetPath, SDL_Renderer* renderer, int zIndex = 0) {
+        Tilemap map;
+        if (!Tilemap::load(tilemapPath, map)) return nullptr;
+        SDL_Texture* atlas = SpriteCache::instance().texture(renderer, tilesetPath);
+        if (!atlas) return nullptr;
+        return new TileLayer({0.0f, 0.0f}, std::move(map), atlas, renderer, zIndex);
+    }
+
+    // Called by Camera::render in place of the sprite; draws only the cells that
+    // overlap the view. Each edge is rounded once, so neighbouring tiles meet
+    // without gaps at any zoom.
+    void drawCells(SDL_Renderer* renderer, Vector2 cameraPos, float zoom, Vector2 displaySize) const {
+        if (!atlas || map.cells.empty()) return;
+        Vector2 origin = getWorldPosition();
+        const float tw = static_cast<float>(map.tileWidth), th = static_cast<float>(map.tileHeight);
+        int x0 = std::max(0, static_cast<int>(std::floor((cameraPos.x - origin.x) / tw)));
+        int y0 = std::max(0, static_cast<int>(std::floor((cameraPos.y - origin.y) / th)));
+        int x1 = std::min(map.mapWidth, static_cast<int>(std::ceil((cameraPos.x + displaySize.x / zoom - origin.x) / tw)));
+        int y1 = std::min(map.mapHeight, static_cast<int>(std::ceil((cameraPos.y + displaySize.y / zoom - origin.y) / th)));
+
+        auto screenX = [&](int column) { return static_cast<int>((origin.x + column * tw - cameraPos.x) * zoom); };
+        auto screenY = [&](int row) { return static_cast<int>((origin.y + row * th - cameraPos.y) * zoom); };
+        for (int y = y0; y < y1; ++y) {
+            int top = screenY(y), bottom = screenY(y + 1);
+            for (int x = x0; x < x1; ++x) {
+                const TileCell& cell = map.at(x, y);
+                if (cell.empty()) continue;
+                int left = screenX(x);
+                SDL_Rect src = map.sourceRect(cell);
+                SDL_Rect dest = {left, top, screenX(x + 1) - left, bottom - top};
+                SDL_RenderCopy(renderer, atlas, &src, &dest);
+            }
+        }
+    }
+
+    const Tilemap& getTilemap() const { return map; }
+
+private:
+    Tilemap map;
+    SDL_Texture* atlas; // owned by SpriteCache
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// One map cell: the column and row of its tile in the tileset atlas
+struct TileCell {
+    uint16_t column = EMPTY;
+    uint16_t row = EMPTY;
+
+    static constexpr uint16_t EMPTY = 0xFFFF;
+    bool empty() const { return column == EMPTY; }
+};
+
+// A tilemap.json layout (written by src/tileseteditor), kept as one cell per
+// map position in row-major order. Drawing a cell means drawing sourceRect(cell)
+// of the tileset texture, so the whole map needs a single texture.
+struct Tilemap {
+    int tileWidth = 0;
+    int tileHeight = 0;
+    int mapWidth = 0;
+    int mapHeight = 0;
+    std::vector<TileCell> cells;
+
+    const TileCell& at(int x, int y) const { return cells[static_cast<size_t>(y) * mapWidth + x]; }
+
+    SDL_Rect sourceRect(const TileCell& cell) const {
+        return SDL_Rect{cell.column * tileWidth, cell.row * tileHeight, tileWidth, tileHeight};
+    }
+
+    // False (logged) if the file cannot be read or is not a tilemap
+    static bool load(const char* path, Tilemap& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            SDL_Log("Failed to open tilemap file: %s", path);
+            return false;
+        }
+        std::stringstream text;
+        text << file.rdbuf();
+        return parse(text.str(), out);
+    }
+
+    // Streams the JSON through a SAX handler instead of building a document, so
+    // large layouts cost no allocation per tile
+    static bool parse(const std::string& text, Tilemap& out) {
+        Reader reader(out);
+        if (!nlohmann::json::sax_parse(text, &reader)) {
+            SDL_Log("Failed to parse tilemap JSON: %s", reader.error.c_str());
+            return false;
+        }
+        return reader.finish();
+    }
+
+private:
+    class Reader : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        std::string error;
+
+        explicit Reader(Tilemap& map) : map(map) {}
+
+        bool null() override {
+            if (inTiles && depth == 3) rows.push_back(TileCell{});
+            return true;
+        }
+        bool boolean(bool) override { return true; }
+        bool number_integer(number_integer_t value) override { return number(static_cast<int>(value)); }
+        bool number_unsigned(number_unsigned_t value) override { return number(static_cast<int>(value)); }
+        bool number_float(number_float_t value, const string_t&) override { return number(static_cast<int>(value)); }
+        bool string(string_t&) override { return true; }
+        bool binary(binary_t&) override { return true; }
+
+        bool start_object(std::size_t) override {
+            if (++depth == 4 && inTiles) tile = TileCell{0, 0};
+            return true;
+        }
+        bool end_object() override {
+            if (depth-- == 4 && inTiles) rows.push_back(tile);
+            return true;
+        }
+        bool start_array(std::size_t) override {
+            ++depth;
+            if (depth == 2 && field == Field::Tiles) inTiles = true;
+            else if (depth == 3 && inTiles) rowStarts.push_back(rows.size());
+            return true;
+        }
+        bool end_array() override {
+            if (depth-- == 2) inTiles = false;
+            return true;
+        }
+
+        bool key(string_t& name) override {
+            if (depth == 1) {
+                field = name == "tileWidth" ? Field::TileWidth : name == "tileHeight" ? Field::TileHeight
+                      : name == "mapWidth" ? Field::MapWidth : name == "mapHeight" ? Field::MapHeight
+                      : name == "tiles" ? Field::Tiles : Field::Other;
+            } else if (depth == 4) {
+                field = name == "x" ? Field::TileX : name == "y" ? Field::TileY : Field::Other;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception& e) override {
+            error = e.what();
+            return false;
+        }
+
+        // Lays the rows read out on the declared map size; missing cells stay empty
+        bool finish() {
+            if (map.tileWidth <= 0 || map.tileHeight <= 0 || map.mapWidth < 0 || map.mapHeight < 0) {
+                SDL_Log("Tilemap is missing its tile or map size");
+                return false;
+            }
+            map.cells.assign(static_cast<size_t>(map.mapWidth) * map.mapHeight, TileCell{});
+            for (size_t y = 0; y < rowStarts.size() && y < static_cast<size_t>(map.mapHeight); ++y) {
+                size_t begin = rowStarts[y];
+                size_t end = y + 1 < rowStarts.size() ? rowStarts[y + 1] : rows.size();
+                for (size_t x = 0; x < end - begin && x < static_cast<size_t>(map.mapWidth); ++x) {
+                    map.cells[y * map.mapWidth + x] = rows[begin + x];
+                }
+            }
+            return true;
+        }
+
+    private:
+        enum class Field { Other, TileWidth, TileHeight, MapWidth, MapHeight, Tiles, TileX, TileY };
+
+        bool number(int value) {
+            if (depth == 1) {
+                if (field == Field::TileWidth) map.tileWidth = value;
+                else if (field == Field::TileHeight) map.tileHeight = value;
+                else if (field == Field::MapWidth) map.mapWidth = value;
+                else if (field == Field::MapHeight) map.mapHeight = value;
+            } else if (depth == 4 && inTiles) {
+                if (field == Field::TileX) tile.column = static_cast<uint16_t>(value);
+                else if (field == Field::TileY) tile.row = static_cast<uint16_t>(value);
+            }
+            return true;
+        }
+
+        Tilemap& map;
+        int depth = 0;         // open objects and arrays; the tile objects sit at 4
+        bool inTiles = false;  // inside the "tiles" array
+        Field field = Field::Other;
+        TileCell tile;
+        std::vector<TileCell> rows;     // cells of every row, back to back
+        std::vector<size_t> rowStarts;  // where each row begins in rows
+    };
+};
@@ -6,7 +6,31 @@
 class UIGameObject : public GameObject {
 public:
     UIGameObject(Vector2 screenPos, Vector2 size, const char* spritePath, SDL_Renderer* renderer, int zIndex = 0)
-        : GameObject(screenPos, size, spritePath, renderer, zIndex) {}
+        : GameObject(screenPos, size, spritePath, renderer, zIndex) {
+        setCapability(this);
+    }
 
-   
+    UIGameObject(Vector2 screenPos, Vector2 size, SDL_Texture* texture, SDL_Renderer* renderer, int zIndex = 0)
+        : GameObject(screenPos, size, texture, renderer, zIndex) {
+        setCapability(this);
+    }
+
+    // Called by Camera::render without the camera transform; draws the sprite at its screen position
+    virtual void drawUI(SDL_Renderer* renderer) {
+        Vector2 screenPos = getWorldPosition();
+        const Vector2* objSize = getSize();
+        SDL_Rect destRect = {
+            static_cast<int>(screenPos.x),
+            static_cast<int>(screenPos.y),
+            static_cast<int>(objSize->x),
+            static_cast<int>(objSize->y)
+        };
+        // Rotate around the centre of the element
+        SDL_Point center = {
+            static_cast<int>(objSize->x / 2),
+            static_cast<int>(objSize->y / 2)
+        };
+        SDL_RenderCopyEx(renderer, getSprite(), getSourceRect(), &destRect,
+                        getWorldRotation(), &center, SDL_FLIP_NONE);
+    }
 };
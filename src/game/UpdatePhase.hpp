@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "GameObject.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
+
+// Side effects recorded by objects that update on worker threads: spawning into
+// gameObjects, network sends, sounds, texture loads and calls into main.cpp.
+// They run on the main thread once every object has updated. Buffers are reused
+// across ticks; keep captures small (a pointer or two) so std::function stores
+// them inline instead of allocating.
+class CommandBuffer {
+    private:
+        std::vector<std::function<void()>> commands;
+
+    public:
+        void defer(std::function<void()> fn) {
+            commands.push_back(std::move(fn));
+        }
+
+        void execute() {
+            for (auto& command : commands) command();
+            commands.clear();
+        }
+};
+
+namespace UpdatePhase {
+    // Objects per update slice; each slice records into its own buffer
+    constexpr size_t SLICE_SIZE = 64;
+
+    inline CommandBuffer*& currentBuffer() {
+        static thread_local CommandBuffer* buffer = nullptr;
+        return buffer;
+    }
+
+    // Runs fn right away on the main thread, or records it when called from inside a
+    // parallel update slice. Update code with side effects outside the object goes through here.
+    inline void defer(std::function<void()> fn) {
+        if (CommandBuffer* buffer = currentBuffer()) buffer->defer(std::move(fn));
+        else fn();
+    }
+
+    // Updates every object once. Objects that opt in with updatesInParallel() run in
+    // slices on the job system after the others have updated (so the players and boat
+    // they read have already moved). Buffers are executed in slice order, which is the
+    // list order, so the result does not depend on the thread count. Main thread only.
+    inline void updateObjects(const std::vector<GameObject*>& objects, float dt) {
+        // Partitioned up front: updates may append to the list being iterated.
+        // Kept between ticks, like the buffers, so a steady tick does not allocate.
+        static std::vector<GameObject*> serial;
+        static std::vector<GameObject*> parallel;
+        static std::vector<CommandBuffer> buffers;
+        serial.clear();
+        parallel.clear();
+        for (GameObject* obj : objects) {
+            if (obj->updatesInParallel()) parallel.push_back(obj);
+            else serial.push_back(obj);
+        }
+
+        for (GameObject* obj : serial) {
+            obj->update(dt);
+        }
+        // Parallel updates read the players and boat; fill their caches before sharing them
+        GameObject::refreshWorldTransforms(objects);
+
+        const size_t slices = (parallel.size() + SLICE_SIZE - 1) / SLICE_SIZE;
+        if (buffers.size() < slices) buffers.resize(slices);
+        JobSystem::instance().parallelFor(parallel.size(), SLICE_SIZE, [&](size_t begin, size_t end) {
+            PROFILE_ZONE("update slice");
+            // A thread that waits inside a slice may run another slice; restore what it had
+            CommandBuffer* previous = currentBuffer();
+            currentBuffer() = &buffers[begin / SLICE_SIZE];
+            for (size_t i = begin; i < end; ++i) {
+                parallel[i]->update(dt);
+            }
+            currentBuffer() = previous;
+        });
+        for (size_t i = 0; i < slices; ++i) {
+            buffers[i].execute();
+        }
+    }
+}
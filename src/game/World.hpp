@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GameObject.hpp"
+
+// Every object taking part in the frame: updated, collided with and drawn.
+// A slot map: objects are packed for iteration, and each slot remembers where
+// its object sits in the packed list, so adding and removing are O(1).
+// Removing moves the last object into the gap, which changes the order of
+// objects(); the same adds and removes always give the same order.
+// A slot's generation goes up whenever it is freed, so an EntityHandle kept
+// after its object left the world resolves to nullptr instead of a dangling
+// pointer. There is one world (gameObjects in main.cpp). Main thread only;
+// do not add or remove while iterating.
+class World {
+public:
+    // An object already in the world keeps its handle
+    EntityHandle add(GameObject* obj) {
+        if (!obj) return {};
+        if (contains(obj)) return obj->handle;
+        uint32_t index;
+        if (freeHead != NO_SLOT) {
+            index = freeHead;
+            freeHead = slots[index].nextFree;
+        } else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{});
+        }
+        Slot& slot = slots[index];
+        slot.object = obj;
+        slot.denseIndex = static_cast<uint32_t>(dense.size());
+        dense.push_back(obj);
+        obj->handle = EntityHandle{index, slot.generation};
+        return obj->handle;
+    }
+
+    // Takes the object out of the world without freeing it; no-op if it is not in it
+    void remove(GameObject* obj) {
+        if (!contains(obj)) return;
+        Slot& slot = slots[obj->handle.index];
+        GameObject* last = dense.back();
+        dense[slot.denseIndex] = last;
+        slots[last->handle.index].denseIndex = slot.denseIndex;
+        dense.pop_back();
+
+        slot.object = nullptr;
+        if (++slot.generation == 0) slot.generation = 1; // 0 is the null handle
+        slot.nextFree = freeHead;
+        freeHead = obj->handle.index;
+        obj->handle = {};
+    }
+
+    bool contains(const GameObject* obj) const {
+        return obj && obj->handle && obj->handle.index < slots.size() && slots[obj->handle.index].object == obj;
+    }
+
+    // nullptr once the object has left the world
+    GameObject* get(EntityHandle handle) const {
+        if (!handle || handle.index >= slots.size()) return nullptr;
+        const Slot& slot = slots[handle.index];
+        return slot.generation == handle.generation ? slot.object : nullptr;
+    }
+
+    // Moves every object marked for deletion out of the world into `dead`; the caller frees them
+    void takeMarked(std::vector<GameObject*>& dead) {
+        for (size_t i = 0; i < dense.size();) {
+            if (dense[i]->isMarkedForDeletion()) {
+                dead.push_back(dense[i]);
+                remove(dense[i]); // moves the last object to i
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    const std::vector<GameObject*>& objects() const { return dense; }
+    size_t size() const { return dense.size(); }
+    std::vector<GameObject*>::const_iterator begin() const { return dense.begin(); }
+    std::vector<GameObject*>::const_iterator end() const { return dense.end(); }
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Slot {
+        GameObject* object = nullptr;
+        uint32_t generation = 1;
+        uint32_t denseIndex = 0;
+        uint32_t nextFree = NO_SLOT;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<GameObject*> dense;
+    uint32_t freeHead = NO_SLOT;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Rectangle.hpp"
+#include "Vector2.hpp"
+
+// Where a chunk's water tiles and small islands go. Planning is pure given the
+// seed, so chunks can be planned on worker threads; the main thread then creates
+// the GameObjects (tiles first, then islands).
+struct ChunkPlan {
+    std::vector<Vector2> tiles;
+    std::vector<Vector2> islands;
+    size_t islandCandidates = 0;
+};
+
+// seed 0 falls back to rand() and must only be planned on the main thread
+inline ChunkPlan planChunk(const Rectangle& area, uint32_t seed, int tileW, int tileH) {
+    ChunkPlan plan;
+    if (tileW <= 0 || tileH <= 0) return plan;
+
+    uint32_t prng = seed;
+    // First pass: fill with environment tiles
+    std::vector<Vector2> smallIslandPositions;
+    for (int y = static_cast<int>(area.begin.y); y < static_cast<int>(area.end.y); y += tileH) {
+        for (int x = static_cast<int>(area.begin.x); x < static_cast<int>(area.end.x); x += tileW) {
+            bool makeSmallIsland = false;
+            if (seed != 0) {
+                prng = 1664525u * prng + 1013904223u; // LCG
+                // Use a byte of PRNG and make small tile islands rarer (~0.78%)
+                int tileRoll = (prng >> 8) & 0xFF;
+                makeSmallIsland = (tileRoll < 2);
+            } else {
+                // Random non-seeded fallback: 1 in 128 (~0.78%)
+                makeSmallIsland = (rand() % 128) == 0;
+            }
+
+            plan.tiles.push_back({static_cast<float>(x), static_cast<float>(y)});
+
+            // Record island positions to place in a second pass so islands are drawn over tiles
+            if (makeSmallIsland) {
+                smallIslandPositions.push_back({static_cast<float>(x), static_cast<float>(y)});
+            }
+        }
+    }
+
+    // Tile grid dimensions for this chunk/area
+    int areaTilesX = static_cast<int>((area.end.x - area.begin.x) / tileW);
+    int areaTilesY = static_cast<int>((area.end.y - area.begin.y) / tileH);
+
+    // Safety: if area has no tiles, return early
+    if (areaTilesX <= 0 || areaTilesY <= 0) return plan;
+
+    // Placement constraints - reduce density by increasing spacing and capping islands
+    const int MIN_ISLAND_GAP_TILES = 2; // increased gap between island centers (in tiles)
+    const int EDGE_BUFFER_TILES = 2; // larger buffer from chunk edges to avoid cross-chunk joins
+    const int MAX_SMALL_ISLANDS_PER_CHUNK = 1; // cap small islands per chunk
+
+    // Prepare occupancy grid for deterministic spacing and overlap prevention
+    std::vector<uint8_t> occupancy(areaTilesX * areaTilesY, 0);
+
+    // Shuffle candidate small island positions deterministically when seed present; random otherwise
+    std::vector<Vector2> candidates = smallIslandPositions;
+    plan.islandCandidates = candidates.size();
+    if (!candidates.empty()) {
+        if (seed != 0) {
+            std::mt19937 shuf(seed ^ 0x9E3779B9u);
+            std::shuffle(candidates.begin(), candidates.end(), shuf);
+        } else {
+            std::mt19937 shuf(static_cast<uint32_t>(rand()));
+            std::shuffle(candidates.begin(), candidates.end(), shuf);
+        }
+    }
+
+    auto markOccupied = [&](int tx, int ty) {
+        for (int oy = -MIN_ISLAND_GAP_TILES; oy <= MIN_ISLAND_GAP_TILES; ++oy) {
+            for (int ox = -MIN_ISLAND_GAP_TILES; ox <= MIN_ISLAND_GAP_TILES; ++ox) {
+                int nx = tx + ox;
+                int ny = ty + oy;
+                if (nx < 0 || nx >= areaTilesX || ny < 0 || ny >= areaTilesY) continue;
+                occupancy[ny * areaTilesX + nx] = 1;
+            }
+        }
+    };
+
+    for (const auto &pos : candidates) {
+        int tx = static_cast<int>((pos.x - area.begin.x) / tileW);
+        int ty = static_cast<int>((pos.y - area.begin.y) / tileH);
+        if (tx < 0 || tx >= areaTilesX || ty < 0 || ty >= areaTilesY) continue;
+
+        // Prevent islands in the spawn area (1000x1000 blocks centered at (0,0))
+        const int SPAWN_CLEAR_BLOCKS = 200;
+        const int SPAWN_HALF = SPAWN_CLEAR_BLOCKS / 2; // half-width in blocks
+        int worldTileX = static_cast<int>(std::floor(pos.x / tileW));
+        int worldTileY = static_cast<int>(std::floor(pos.y / tileH));
+        SDL_Log("world tile x=%d y=%d", worldTileX, worldTileY);
+        if (std::abs(worldTileX) < SPAWN_HALF && std::abs(worldTileY) < SPAWN_HALF) continue;
+
+        // Respect an edge buffer so islands do not sit on the very edge of a chunk
+        if (tx < EDGE_BUFFER_TILES || tx >= areaTilesX - EDGE_BUFFER_TILES) continue;
+        if (ty < EDGE_BUFFER_TILES || ty >= areaTilesY - EDGE_BUFFER_TILES) continue;
+
+        // Check occupancy in a neighborhood of MIN_ISLAND_GAP_TILES
+        bool blocked = false;
+        for (int oy = -MIN_ISLAND_GAP_TILES; oy <= MIN_ISLAND_GAP_TILES && !blocked; ++oy) {
+            for (int ox = -MIN_ISLAND_GAP_TILES; ox <= MIN_ISLAND_GAP_TILES; ++ox) {
+                int nx = tx + ox;
+                int ny = ty + oy;
+                if (nx < 0 || nx >= areaTilesX || ny < 0 || ny >= areaTilesY) continue;
+                if (occupancy[ny * areaTilesX + nx]) { blocked = true; break; }
+            }
+        }
+        if (blocked) continue;
+
+        // Place island and mark occupancy in its neighborhood to enforce spacing
+        plan.islands.push_back(pos);
+        markOccupied(tx, ty);
+        // If we've reached the per-chunk cap, stop placing more small islands
+        if (static_cast<int>(plan.islands.size()) >= MAX_SMALL_ISLANDS_PER_CHUNK) {
+            SDL_Log("Reached max small islands (%d) for this area (seed=%u); skipping remaining candidates.", MAX_SMALL_ISLANDS_PER_CHUNK, seed);
+            break;
+        }
+    }
+
+    return plan;
+}
@@ -3,12 +3,15 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <map>
+#include <deque>
 #include <unordered_map>
 #include <cstring>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <random>
+#include <filesystem>
 
 #include "Camera.hpp" 
 #include "GameObject.hpp"
@@ -20,24 +23,55 @@
 #include "DebugObject.hpp"
 #include "UIGameObject.hpp"
 #include "Particle.hpp"
+#include "ParticleSystem.hpp"
+#include "PerfHud.hpp"
 #include "../audio/SoundManager.hpp"
 #include <SDL_ttf.h>
 #include "Text.hpp"
+#include "FontCache.hpp"
 #include "Lighthouse.hpp"
 #include "AttackingFish.hpp"
 #include "FishProjectile.hpp"
+#include "CaughtFish.hpp"
+#include "ObjectPool.hpp"
+#include "SpriteCache.hpp"
+#include "RenderInterpolation.hpp"
+#include "WorldGen.hpp"
+#include "UpdatePhase.hpp"
+#include "CollisionPhase.hpp"
+#include "World.hpp"
+#include "../net/Packets.hpp"
+#include "../net/NetIO.hpp"
+#include "../net/Snapshot.hpp"
+#include "../net/InputFrames.hpp"
+#include "../net/InputBuffer.hpp"
+#include "../core/Random.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/AllocTracker.hpp"
+#include "../core/AssetPack.hpp"
 #include <string>
 
 // Track whether TTF was successfully initialized
 static bool ttfInitialized = false;
 
 //GAME
-std::vector<GameObject*> gameObjects;
+World gameObjects;
 Camera* camera;
 Player* player = nullptr;
 Boat* boat;
 SDL_Renderer* g_renderer = nullptr;
-static std::set<std::pair<int,int>> generatedChunks;
+// Generated world chunks. The generator is deterministic for a given world seed and nothing
+// changes a chunk after it is built, so the host and every client build identical chunks
+// locally and no chunk state travels.
+struct WorldChunk {
+    bool generated = false;
+    std::vector<GameObject*> objects; // generator output order
+};
+static std::map<std::pair<int,int>, WorldChunk> worldChunks;
+static uint32_t worldSeed = 0; // host: --world-seed (0 = the original fixed world); clients: from ACPT
+// Colliders currently touching; file scope so removeRemotePlayer can purge pairs it invalidates
+static CollisionPairSet collisionPairs;
 
 // Day/night cycle globals (file scope)
 float g_dayTimeSeconds = 0.0f;
@@ -62,6 +96,7 @@ static int equipmentWheelRadius = 96;
 static int equipmentWheelSelected = -1; // 0=rod, 1=harpoon
 static Text* equipmentLabelRod = nullptr;
 static Text* equipmentLabelHarpoon = nullptr;
+static Text* equipmentWheelHint = nullptr;
 static GameObject* equipmentIconRod = nullptr;
 static GameObject* equipmentIconHarpoon = nullptr;
 
@@ -123,11 +158,11 @@ static const float TUG_FAIL_THRESHOLD = 0.95f; // progress >= this = fail
 
 static Vector2 fishingMinigameHookPos{0.0f,0.0f}; // world pos where minigame triggered
 static SDL_Rect fishingMinigameScreenRect = {0,0,0,0}; // screen-space rect for minigame bar
-static std::mt19937 fishingMinigameRng(std::random_device{}());
+static std::mt19937 fishingMinigameRng; // seeded from the session seed in main()
 static int fishingMinigameAttempts = 0; // debug counter
 
 // Fish collection / inventory state
-static std::vector<GameObject*> fishesMovingToPlayer; // world fish moving towards player
+static std::vector<EntityHandle> fishesMovingToPlayer; // world fish moving towards player
 // Inventory as a fixed 2D grid of UIFish icons (screen-space UIGameObjects)
 static const int INV_COLS = 5;
 static const int INV_ROWS = 3;
@@ -155,10 +190,29 @@ static Text* g_coinText = nullptr;
 bool isHost = false;
 UDPsocket udpSocket = nullptr;
 static IPaddress hostAddr;
-static std::vector<IPaddress> clientAddrs;
-static uint32_t clientId = 0;
+// Host-side record of an accepted client
+struct ClientPeer {
+    IPaddress address;
+    uint32_t id = 0;
+    uint32_t nonce = 0; // from the client's CONN, identifies its session
+    float silenceSeconds = 0.0f; // time since we last heard anything from this address
+    InputJitterBuffer inputBuffer; // frames waiting for their simulation tick
+};
+static std::unordered_map<uint64_t, ClientPeer> clientPeers; // keyed by netAddressKey(address)
+static uint32_t nextClientId = 1; // 0 is the host
+// Host clock for input arrival times; advanced by frame dt (not wall time) so replays see the same values
+static double hostClockSeconds = 0.0;
+// Client-side session state
+enum class ClientConnState { Connecting, Connected, Rejected };
+static ClientConnState clientConnState = ClientConnState::Connecting;
+static uint32_t connectNonce = 0;
+static float connectRetryTimer = 0.0f;
+static float hostSilenceSeconds = 0.0f;
+static SnapshotTickFilter snapshotTicks; // newest snapshot tick applied this session
+uint32_t clientId = 0; // shared with AttackingFish.hpp
 static uint32_t inputSeq = 0;
-static std::unordered_map<uint32_t, Player*> remotePlayers;
+static std::deque<InputFrame> inputHistory; // newest first, resent with every input datagram
+std::unordered_map<uint32_t, Player*> remotePlayers; // shared with Camera.hpp
 static bool clientBoardingRequest = false;
 // Entity id counters for host authority
 static uint32_t nextEntityId = 1;
@@ -167,171 +221,13 @@ static bool clientBoatMovementToggle = false;
 static bool clientHookToggle = false;
 static uint8_t clientEquipRequest = 0; // 0=no request, 1=rod, 2=harpoon
 // RNG for networked events
-static std::mt19937 netRng(std::random_device{}());
-
-#pragma pack(push, 1)
-struct ChunkPacket {
-    uint32_t magic; // 'CHNK'
-    int32_t cx;
-    int32_t cy;
-    uint32_t seed;
-    uint8_t biome; // Biome enum value
-};
-#pragma pack(pop)
-
-#pragma pack(push, 1)
-struct ParticlePacket {
-    uint32_t magic; // 'PART'
-    uint32_t ownerId;
-    uint32_t seed;
-    float startX;
-    float startY;
-    float destX;
-    float destY;
-    float delay; // seconds until spawn (host-determined)
-    uint8_t count;
-    float duration;
-    int32_t zIndex;
-    float spread;
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-    uint8_t a;
-};
-#pragma pack(pop)
-
-#pragma pack(push, 1)
-struct HookArrivalPacket {
-    uint32_t magic; // 'HKAR'
-    uint32_t ownerId;
-    float x;
-    float y;
-};
-#pragma pack(pop)
-
-// AttackingFish spawn packet (host -> clients)
-#pragma pack(push, 1)
-struct AttackingFishSpawnPacket {
-    uint32_t magic; // 'AFSP'
-    uint32_t entityId;
-    uint32_t ownerId; // player who triggered/spawned this fish
-    float x;
-    float y;
-};
-#pragma pack(pop)
-
-#pragma pack(push, 1)
-struct AttackingFishRequestPacket {
-    uint32_t magic; // 'AFRQ' client->host request
-    uint32_t ownerId; // requesting player's id
-    float x;
-    float y;
-};
-#pragma pack(pop)
-
-// Fish projectile spawn packet (host -> clients)
-#pragma pack(push, 1)
-struct FishProjectileSpawnPacket {
-    uint32_t magic; // 'FPRJ'
-    uint32_t projectileId;
-    uint32_t ownerEntityId;
-    uint32_t targetPlayerId; // 0 = host, others = client IDs
-    float startX;
-    float startY;
-};
-#pragma pack(pop)
+static std::mt19937 netRng; // seeded from the session seed in main()
 
-#pragma pack(push, 1)
-struct DaytimePacket {
-    uint32_t magic; // 'DAYT'
-    float dayTimeSeconds; // current time of day (seconds since cycle start)
-    float cycleDurationSeconds; // seconds per full day-night cycle
-};
-#pragma pack(pop)
-
-// Header for packet containing explicit particle start positions
-#pragma pack(push, 1)
-struct ParticlePositionsHeader {
-    uint32_t magic; // 'PPOS'
-    uint32_t ownerId;
-    float delay; // seconds until spawn
-    uint8_t count; // number of particle start positions
-    float duration; // particle lifetime
-    int32_t zIndex;
-    float destX;
-    float destY;
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-    uint8_t a;
-};
+// Network stats overlay (toggled with F3)
+static bool netStatsOverlayVisible = false;
+static std::vector<Text*> netStatsOverlayLines;
+static uint32_t netStatsOverlayGeneration = 0;
 
-struct ParticlePos {
-    float sx;
-    float sy;
-};
-#pragma pack(pop)
-
-#pragma pack(push, 1)
-struct InputPacket {
-    uint32_t clientId;
-    uint32_t seq;
-    uint8_t moveFlags; // bits: 0=up, 1=down, 2=left, 3=right
-    uint8_t boardBoat; // 0=no action, 1=toggle boarding
-    uint8_t toggleBoatMovement; // 0=no action, 1=toggle start/stop
-    uint8_t hasBoatControl; // 0=no, 1=has navigation direction update
-    uint8_t toggleHook; // 0=no action, 1=toggle hook
-    float boatNavDirX;
-    float boatNavDirY;
-    uint8_t mouseDown; // 0 = none, 1 = left click
-    int32_t mouseX;
-    int32_t mouseY;
-    int32_t hookTargetX;
-    int32_t hookTargetY;
-    int32_t hookStartX;
-    int32_t hookStartY;
-
-    uint8_t equipAction; // 0 = none, 1 = equip rod, 2 = equip harpoon
-    uint8_t fireWeapon; // 0 = none, 1 = fire weapon (harpoon)
-    int32_t weaponTargetX;
-    int32_t weaponTargetY;
-};
-
-struct BoatState {
-    float x, y;
-    float rotation;
-    float navDirX, navDirY;
-    uint8_t isMoving;
-};
-
-struct PlayerState {
-    uint32_t id;
-    float x, y;
-    float vx, vy;  // velocity
-    uint8_t animFrame;
-    uint8_t isOnBoat; // 0 = not on boat, 1 = on boat
-    uint8_t isHooking; // 0 = not hooking, 1 = hooking
-    uint8_t fishingHookActive; // 0 = not active, 1 = active
-    float fishingHookX, fishingHookY; // world position of hook
-    float fishingHookTargetX, fishingHookTargetY; // mouse destination
-
-    // Equipment & projectile (harpoon) state
-    uint8_t equipment; // 0=none, 1=rod, 2=harpoon
-    uint8_t projectileActive; // 0 = not active, 1 = active
-    float projectileX, projectileY; // world position of projectile
-    float projectileTargetX, projectileTargetY; // projectile destination
-
-    // Health
-    float hp;
-    float maxHp;
-};
-
-struct SnapshotHeader {
-    uint32_t tick;
-    uint32_t playerCount;
-    uint8_t hasBoat;
-};
-#pragma pack(pop)
 
 
 
@@ -339,15 +235,11 @@ struct SnapshotHeader {
 constexpr int WIN_WIDTH = 800;
 constexpr int WIN_HEIGHT = 600;
 
-enum RENDER_LAYERS {
-    LAYER_ENVIRONMENT = 0,
-    LAYER_BOAT = 1,
-    LAYER_LIGHTHOUSE = 2,
-    LAYER_PLAYER = 3,
-    LAYER_PARTICLE = 4,
-    LAYER_UI = 5,
-    LAYER_DEBUG = 6,
-};
+// Fixed simulation step (see --tick-rate); frames longer than MAX_FRAME_SECONDS are
+// simulated as if they were that long, and at most MAX_TICKS_PER_FRAME ticks run per frame
+static const uint16_t DEFAULT_TICK_RATE = 60;
+static const double MAX_FRAME_SECONDS = 0.25;
+static const int MAX_TICKS_PER_FRAME = 8;
 
 // Forward declare so getOrCreateRemotePlayer can reference it when installing callbacks
 void hostBroadcastHookArrival(uint32_t ownerId, const Vector2& pos);
@@ -366,15 +258,13 @@ void openLighthouseShop() {
         SDL_Log("Lighthouse shop closed");
         // Remove sell-all label if present
         if (lighthouseSellAllLabel) {
-            auto it = std::find(gameObjects.begin(), gameObjects.end(), lighthouseSellAllLabel);
-            if (it != gameObjects.end()) gameObjects.erase(it);
+            gameObjects.remove(lighthouseSellAllLabel);
             delete lighthouseSellAllLabel;
             lighthouseSellAllLabel = nullptr;
         }
         // Remove title if present
         if (lighthouseShopTitle) {
-            auto it2 = std::find(gameObjects.begin(), gameObjects.end(), lighthouseShopTitle);
-            if (it2 != gameObjects.end()) gameObjects.erase(it2);
+            gameObjects.remove(lighthouseShopTitle);
             delete lighthouseShopTitle;
             lighthouseShopTitle = nullptr;
         }
@@ -384,7 +274,7 @@ void openLighthouseShop() {
 
 bool initEnvironmentTiles(SDL_Renderer* renderer) {
         if(envCacheInit) return true;
-        SDL_Surface* surface = SDL_LoadBMP("./sprites/water1.bmp");
+        SDL_Surface* surface = loadSpriteSurface("./sprites/water1.bmp");
         if (!surface) {
             SDL_Log("Failed to load environment tile: %s", SDL_GetError());
             return false;
@@ -398,7 +288,7 @@ bool initEnvironmentTiles(SDL_Renderer* renderer) {
             return false;
         }
         // Load alternate water texture (optional)
-        SDL_Surface* surface2 = SDL_LoadBMP("./sprites/water2.bmp");
+        SDL_Surface* surface2 = loadSpriteSurface("./sprites/water2.bmp");
         if (surface2) {
             envTexture2 = SDL_CreateTextureFromSurface(renderer, surface2);
             SDL_FreeSurface(surface2);
@@ -411,116 +301,26 @@ bool initEnvironmentTiles(SDL_Renderer* renderer) {
 }
 
 
-std::vector<GameObject*> generateInitialEnvironment(SDL_Renderer* renderer, Rectangle area, uint32_t seed = 0, Biome biome = BIOME_WATER1) {
+// Create the GameObjects for a planned chunk (main thread: textures come from the renderer)
+std::vector<GameObject*> buildEnvironment(SDL_Renderer* renderer, const Rectangle& area, const ChunkPlan& plan, uint32_t seed, Biome biome) {
     std::vector<GameObject*> environment;
     if (!initEnvironmentTiles(renderer)) {
         return environment;
     }
 
-    uint32_t prng = seed;
     // Choose tile texture based on biome
     SDL_Texture* tileTexture = (biome == BIOME_WATER2 && envTexture2) ? envTexture2 : envTexture;
     // Choose island sprite based on biome (water2 uses island2)
     const char* islandSprite = (biome == BIOME_WATER2) ? "./sprites/island2.bmp" : "./sprites/island.bmp";
 
-    // First pass: fill with environment tiles
-    std::vector<Vector2> smallIslandPositions;
-    for (int y = static_cast<int>(area.begin.y); y < static_cast<int>(area.end.y); y += envTileH) {
-        for (int x = static_cast<int>(area.begin.x); x < static_cast<int>(area.end.x); x += envTileW) {
-            bool makeSmallIsland = false;
-            if (seed != 0) {
-                prng = 1664525u * prng + 1013904223u; // LCG
-                // Use a byte of PRNG and make small tile islands rarer (~0.78%)
-                int tileRoll = (prng >> 8) & 0xFF;
-                makeSmallIsland = (tileRoll < 2);
-            } else {
-                // Random non-seeded fallback: 1 in 128 (~0.78%)
-                makeSmallIsland = (rand() % 128) == 0;
-            }
-
-            SDL_Texture* texture = tileTexture;
-            // Always add the water tile first so islands are drawn on top
-            if (texture) {
-                GameObject* tileObj = new GameObject(
-                    {static_cast<float>(x), static_cast<float>(y)},
-                    {1.0f, 1.0f},
-                    texture,
-                    renderer,
-                    LAYER_ENVIRONMENT
-                );
-                environment.push_back(tileObj);
-            }
-
-            // Record island positions to place in a second pass so islands are drawn over tiles
-            if (makeSmallIsland) {
-                smallIslandPositions.push_back({static_cast<float>(x), static_cast<float>(y)});
-            }
+    // Water tiles first so islands are drawn on top
+    environment.reserve(plan.tiles.size() + plan.islands.size());
+    if (tileTexture) {
+        for (const Vector2& pos : plan.tiles) {
+            environment.push_back(new GameObject(pos, {1.0f, 1.0f}, tileTexture, renderer, LAYER_ENVIRONMENT));
         }
     }
-
-    // Large island generation removed per configuration.
-
-    // Tile grid dimensions for this chunk/area
-    int areaTilesX = static_cast<int>((area.end.x - area.begin.x) / envTileW);
-    int areaTilesY = static_cast<int>((area.end.y - area.begin.y) / envTileH);
-
-    // Safety: if area has no tiles, return early
-    if (areaTilesX <= 0 || areaTilesY <= 0) return environment;
-
-    // Placement constraints - reduce density by increasing spacing and capping islands
-    const int MIN_ISLAND_GAP_TILES = 2; // increased gap between island centers (in tiles)
-    const int EDGE_BUFFER_TILES = 2; // larger buffer from chunk edges to avoid cross-chunk joins
-    const int MAX_SMALL_ISLANDS_PER_CHUNK = 1; // cap small islands per chunk
-
-
-
-    // Prepare occupancy grid for deterministic spacing and overlap prevention
-    std::vector<uint8_t> occupancy(areaTilesX * areaTilesY, 0);
-
-
-    // Shuffle candidate small island positions deterministically when seed present; random otherwise
-    std::vector<Vector2> candidates = smallIslandPositions;
-    if (!candidates.empty()) {
-        if (seed != 0) {
-            std::mt19937 shuf(seed ^ 0x9E3779B9u);
-            std::shuffle(candidates.begin(), candidates.end(), shuf);
-        } else {
-            std::mt19937 shuf(static_cast<uint32_t>(SDL_GetTicks()));
-            std::shuffle(candidates.begin(), candidates.end(), shuf);
-        }
-    }
-
-    int placedSmall = 0;
-    for (const auto &pos : candidates) {
-        int tx = static_cast<int>((pos.x - area.begin.x) / envTileW);
-        int ty = static_cast<int>((pos.y - area.begin.y) / envTileH);
-        if (tx < 0 || tx >= areaTilesX || ty < 0 || ty >= areaTilesY) continue;
-
-        // Prevent islands in the spawn area (1000x1000 blocks centered at (0,0))
-        const int SPAWN_CLEAR_BLOCKS = 200;
-        const int SPAWN_HALF = SPAWN_CLEAR_BLOCKS / 2; // half-width in blocks
-        int worldTileX = static_cast<int>(std::floor(pos.x / envTileW));
-        int worldTileY = static_cast<int>(std::floor(pos.y / envTileH));
-        SDL_Log("world tile x=%d y=%d", worldTileX, worldTileY);
-        if (std::abs(worldTileX) < SPAWN_HALF && std::abs(worldTileY) < SPAWN_HALF) continue;
-
-        // Respect an edge buffer so islands do not sit on the very edge of a chunk
-        if (tx < EDGE_BUFFER_TILES || tx >= areaTilesX - EDGE_BUFFER_TILES) continue;
-        if (ty < EDGE_BUFFER_TILES || ty >= areaTilesY - EDGE_BUFFER_TILES) continue;
-
-        // Check occupancy in a neighborhood of MIN_ISLAND_GAP_TILES
-        bool blocked = false;
-        for (int oy = -MIN_ISLAND_GAP_TILES; oy <= MIN_ISLAND_GAP_TILES && !blocked; ++oy) {
-            for (int ox = -MIN_ISLAND_GAP_TILES; ox <= MIN_ISLAND_GAP_TILES; ++ox) {
-                int nx = tx + ox;
-                int ny = ty + oy;
-                if (nx < 0 || nx >= areaTilesX || ny < 0 || ny >= areaTilesY) continue;
-                if (occupancy[ny * areaTilesX + nx]) { blocked = true; break; }
-            }
-        }
-        if (blocked) continue;
-
-        // Place island and mark occupancy in its neighborhood to enforce spacing
+    for (const Vector2& pos : plan.islands) {
         ICollidable* island = new ICollidable(
             {pos.x, pos.y},
             {1.0f, 1.0f},
@@ -530,35 +330,9 @@ std::vector<GameObject*> generateInitialEnvironment(SDL_Renderer* renderer, Rect
             LAYER_ENVIRONMENT
         );
         environment.push_back(island);
-        ++placedSmall;
-        // If we've reached the per-chunk cap, stop placing more small islands
-        if (placedSmall >= MAX_SMALL_ISLANDS_PER_CHUNK) {
-            SDL_Log("Reached max small islands (%d) for this area (seed=%u); skipping remaining candidates.", MAX_SMALL_ISLANDS_PER_CHUNK, seed);
-            // mark occupancy for this island before breaking to keep spacing consistent
-            for (int oy = -MIN_ISLAND_GAP_TILES; oy <= MIN_ISLAND_GAP_TILES; ++oy) {
-                for (int ox = -MIN_ISLAND_GAP_TILES; ox <= MIN_ISLAND_GAP_TILES; ++ox) {
-                    int nx = tx + ox;
-                    int ny = ty + oy;
-                    if (nx < 0 || nx >= areaTilesX || ny < 0 || ny >= areaTilesY) continue;
-                    occupancy[ny * areaTilesX + nx] = 1;
-                }
-            }
-            break;
-        }
-
-        for (int oy = -MIN_ISLAND_GAP_TILES; oy <= MIN_ISLAND_GAP_TILES; ++oy) {
-            for (int ox = -MIN_ISLAND_GAP_TILES; ox <= MIN_ISLAND_GAP_TILES; ++ox) {
-                int nx = tx + ox;
-                int ny = ty + oy;
-                if (nx < 0 || nx >= areaTilesX || ny < 0 || ny >= areaTilesY) continue;
-                occupancy[ny * areaTilesX + nx] = 1;
-            }
-        }
     }
 
-    SDL_Log("Placed %d small islands (candidates %zu) in area [%.1f,%.1f]-[%.1f,%.1f] (seed=%u)", placedSmall, candidates.size(), area.begin.x, area.begin.y, area.end.x, area.end.y, seed);
-
-
+    SDL_Log("Placed %zu small islands (candidates %zu) in area [%.1f,%.1f]-[%.1f,%.1f] (seed=%u)", plan.islands.size(), plan.islandCandidates, area.begin.x, area.begin.y, area.end.x, area.end.y, seed);
 
     return environment;
 }
@@ -582,9 +356,9 @@ Player* getOrCreateRemotePlayer(uint32_t id) {
     // Start remote players with no equipment so clients don't show host holding tools by default
     remote->equip(Player::EQUIP_NONE);
     remotePlayers[id] = remote;
-    gameObjects.push_back(remote); // Add player
+    gameObjects.add(remote); // Add player
     if (remote->getFishingProjectile()) {
-        gameObjects.push_back(remote->getFishingProjectile()); // Add their fishing hook for rendering
+        gameObjects.add(remote->getFishingProjectile()); // Add their fishing hook for rendering
         // If running as host, set up hook arrival broadcast for this remote player
         if (isHost) {
             remote->getFishingProjectile()->setOnHookArrival([id](const Vector2& pos){
@@ -596,7 +370,7 @@ Player* getOrCreateRemotePlayer(uint32_t id) {
         // hook arrival to clients so the owning player handles the minigame locally.
         remote->getFishingProjectile()->setOnAttractArrival([id, remote](){
             Vector2 p = remote->getFishingProjectile()->getWorldPosition();
-            if (isHost && udpSocket && !clientAddrs.empty()) {
+            if (isHost && udpSocket && !clientPeers.empty()) {
                 hostBroadcastHookArrival(id, p);
             }
         });
@@ -605,6 +379,154 @@ Player* getOrCreateRemotePlayer(uint32_t id) {
     return remote;
 }
 
+// Free a remote player together with its hook and harpoon projectile, plus attacking fish it
+// owns and fish projectiles chasing it (those would otherwise hold a dangling Player* or
+// recreate the player through getOrCreateRemotePlayer). Must not run while iterating gameObjects.
+void removeRemotePlayer(uint32_t id) {
+    auto it = remotePlayers.find(id);
+    if (it == remotePlayers.end()) return;
+    Player* remote = it->second;
+    remotePlayers.erase(it);
+
+    if (boat && boat->isPlayerOnBoard(remote)) boat->leaveBoat(remote);
+
+    // Owned by the player (deleted by ~Player / ~Gun), only need to leave the world
+    std::set<GameObject*> removed{remote};
+    if (remote->getFishingProjectile()) removed.insert(remote->getFishingProjectile());
+    if (remote->getGun() && remote->getGun()->getProjectile()) removed.insert(remote->getGun()->getProjectile());
+
+    std::vector<FishProjectile*> deadProjectiles;
+    std::vector<AttackingFish*> deadFish;
+    for (FishProjectile* fp : FishProjectile::all()) {
+        if (fp->getTarget() == remote) { deadProjectiles.push_back(fp); removed.insert(fp); }
+    }
+    for (AttackingFish* af : AttackingFish::all()) {
+        if (af->getOwnerPlayerId() == id) { deadFish.push_back(af); removed.insert(af); }
+    }
+
+    for (GameObject* obj : removed) gameObjects.remove(obj);
+
+    std::set<ICollidable*> removedColliders;
+    for (GameObject* obj : removed) {
+        if (ICollidable* c = obj->asCollidable()) removedColliders.insert(c);
+    }
+    for (auto pit = collisionPairs.begin(); pit != collisionPairs.end();) {
+        if (removedColliders.count(pit->first) || removedColliders.count(pit->second)) pit = collisionPairs.erase(pit);
+        else ++pit;
+    }
+
+    for (FishProjectile* fp : deadProjectiles) delete fp;
+    for (AttackingFish* af : deadFish) delete af;
+    delete remote;
+    std::cout << "Removed remote player with ID: " << id << "\n";
+}
+
+// Per-chunk generator seed; with world seed 0 this reproduces the original fixed world
+uint32_t chunkSeed(int cx, int cy) {
+    uint32_t seed = (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u) ^ 0x9E3779B9u ^ worldSeed;
+    return seed != 0 ? seed : 1u; // 0 would make planChunk fall back to rand()
+}
+
+// Take objects out of the world, forget their collisions and free them. Each object
+// must appear once. Must not run while iterating gameObjects.
+void destroyObjects(const std::vector<GameObject*>& dead) {
+    if (dead.empty()) return;
+    static std::vector<ICollidable*> deadColliders; // sorted; keeps its capacity between frames
+    deadColliders.clear();
+    for (GameObject* obj : dead) {
+        gameObjects.remove(obj);
+        if (ICollidable* c = obj->asCollidable()) deadColliders.push_back(c);
+    }
+    if (!deadColliders.empty()) {
+        std::sort(deadColliders.begin(), deadColliders.end());
+        auto isDead = [](ICollidable* c) { return std::binary_search(deadColliders.begin(), deadColliders.end(), c); };
+        for (auto pit = collisionPairs.begin(); pit != collisionPairs.end();) {
+            if (isDead(pit->first) || isDead(pit->second)) pit = collisionPairs.erase(pit);
+            else ++pit;
+        }
+    }
+    for (GameObject* obj : dead) delete obj;
+}
+
+// End of frame: free every object marked for deletion during it
+void destroyMarkedObjects() {
+    static std::vector<GameObject*> marked; // keeps its capacity between frames
+    marked.clear();
+    gameObjects.takeMarked(marked); // each marked object once
+    destroyObjects(marked);
+}
+
+// Every sprite the game may draw: the packed ones, or the BMPs in ./sprites without a pack
+std::vector<std::string> startupSprites() {
+    if (AssetPack::instance().isOpen()) return AssetPack::instance().spriteNames();
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("./sprites", ec)) {
+        if (entry.path().extension() == ".bmp") paths.push_back("./sprites/" + entry.path().filename().string());
+    }
+    return paths;
+}
+
+// Loads what fish spawns draw and collide with and reserves their pools, so spawning
+// in combat neither reads files nor allocates
+void warmSpawnPools(SDL_Renderer* rend) {
+    for (const char* sprite : {"./sprites/AttackingFish1.bmp", "./sprites/AttackingFish2.bmp", "./sprites/FishProjectile.bmp", CaughtFish::SPRITE}) {
+        SpriteCache::instance().texture(rend, sprite);
+    }
+    ICollidable::sharedShape("./sprites/AttackingFish1.bmp");
+    ICollidable::sharedShape("./sprites/FishProjectile.bmp");
+    ObjectPool<AttackingFish>::instance().reserve(16);
+    ObjectPool<FishProjectile>::instance().reserve(64);
+    ObjectPool<CaughtFish>::instance().reserve(16);
+    ObjectPool<FishIcon>::instance().reserve(INV_COLS * INV_ROWS);
+}
+
+Rectangle chunkArea(int cx, int cy) {
+    return Rectangle{{cx * static_cast<float>(CHUNK_SIZE_PX), cy * static_cast<float>(CHUNK_SIZE_PX)},
+                     {(cx+1) * static_cast<float>(CHUNK_SIZE_PX), (cy+1) * static_cast<float>(CHUNK_SIZE_PX)}};
+}
+
+// Build the listed chunks from the world seed where they do not exist yet.
+// Layouts are planned in parallel on the job system; objects are created here in list order.
+void generateChunks(SDL_Renderer* rend, const std::vector<std::pair<int,int>>& keys) {
+    std::vector<std::pair<int,int>> missing;
+    for (const auto& key : keys) {
+        auto it = worldChunks.find(key);
+        if (it == worldChunks.end() || !it->second.generated) missing.push_back(key);
+    }
+    if (missing.empty() || !initEnvironmentTiles(rend)) return;
+
+    std::vector<ChunkPlan> plans(missing.size());
+    std::vector<JobSystem::Handle> jobs;
+    jobs.reserve(missing.size());
+    for (size_t i = 0; i < missing.size(); ++i) {
+        Rectangle area = chunkArea(missing[i].first, missing[i].second);
+        uint32_t seed = chunkSeed(missing[i].first, missing[i].second);
+        jobs.push_back(JobSystem::instance().submit([&plans, i, area, seed] {
+            PROFILE_ZONE("chunk plan");
+            plans[i] = planChunk(area, seed, envTileW, envTileH);
+        }));
+    }
+    JobSystem::instance().waitAll(jobs);
+
+    for (size_t i = 0; i < missing.size(); ++i) {
+        int cx = missing[i].first, cy = missing[i].second;
+        WorldChunk& chunk = worldChunks[{cx, cy}];
+        uint32_t seed = chunkSeed(cx, cy);
+        chunk.objects = buildEnvironment(rend, chunkArea(cx, cy), plans[i], seed, sampleBiome(cx, cy, seed));
+        chunk.generated = true;
+        for (GameObject* obj : chunk.objects) gameObjects.add(obj);
+    }
+}
+
+// Drop every chunk (client joining a world with a different seed)
+void clearWorldChunks() {
+    std::vector<GameObject*> dead;
+    for (auto& [key, chunk] : worldChunks) dead.insert(dead.end(), chunk.objects.begin(), chunk.objects.end());
+    worldChunks.clear();
+    destroyObjects(dead);
+}
+
 // Forward declarations
 float hitBoxDistance(std::vector<Rectangle> shapeA, std::vector<Rectangle> shapeB);
 
@@ -644,7 +566,7 @@ uint32_t getPlayerId(Player* p) {
 
 // Host: broadcast projectile spawn to all clients
 void hostBroadcastFishProjectile(uint32_t projectileId, uint32_t ownerEntityId, uint32_t targetPlayerId, float startX, float startY) {
-    if (!isHost || !udpSocket || clientAddrs.empty()) return;
+    if (!isHost || !udpSocket || clientPeers.empty()) return;
     FishProjectileSpawnPacket pkt{};
     pkt.magic = 0x4A525046; // 'FPRJ' packed
     pkt.projectileId = projectileId;
@@ -657,18 +579,250 @@ void hostBroadcastFishProjectile(uint32_t projectileId, uint32_t ownerEntityId,
     if (!out) return;
     std::memcpy(out->data, &pkt, sizeof(pkt));
     out->len = sizeof(pkt);
-    for (auto& addr : clientAddrs) {
-        out->address = addr;
-        SDLNet_UDP_Send(udpSocket, -1, out);
+    for (auto& [peerKey, peer] : clientPeers) {
+        out->address = peer.address;
+        netSend(udpSocket, out);
     }
     SDLNet_FreePacket(out);
     SDL_Log("Host: broadcast FishProjectile pid=%u owner=%u start=(%.2f,%.2f) targetPid=%u", projectileId, ownerEntityId, startX, startY, targetPlayerId);
 }
 
+// Answer PING with PONG and feed PONG round trips into NetStats. Returns true if the packet was consumed.
+bool handlePingPong(UDPpacket* in) {
+    if (in->len < static_cast<int>(sizeof(PingPacket))) return false;
+    PingPacket ping;
+    std::memcpy(&ping, in->data, sizeof(ping));
+    if (ping.magic == MAGIC_PING) {
+        ping.magic = MAGIC_PONG;
+        std::memcpy(in->data, &ping, sizeof(ping));
+        in->len = sizeof(ping);
+        netSend(udpSocket, in); // in->address is still the sender
+        return true;
+    }
+    if (ping.magic == MAGIC_PONG) {
+        NetStats::instance().onPong(in->address, ping);
+        return true;
+    }
+    return false;
+}
+
+void sendDaytimeTo(const IPaddress& addr) {
+    DaytimePacket dpk{};
+    dpk.magic = 0x54415944; // 'DAYT'
+    dpk.dayTimeSeconds = std::fmod(g_dayTimeSeconds, g_dayCycleDurationSeconds);
+    dpk.cycleDurationSeconds = g_dayCycleDurationSeconds;
+    UDPpacket* dout = SDLNet_AllocPacket(sizeof(dpk));
+    std::memcpy(dout->data, &dpk, sizeof(dpk));
+    dout->len = sizeof(dpk);
+    dout->address = addr;
+    netSend(udpSocket, dout);
+    SDLNet_FreePacket(dout);
+}
+
+void sendDisconnect(const IPaddress& addr, uint32_t id, uint8_t reason) {
+    DisconnectPacket pkt{MAGIC_DISC, id, reason};
+    UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
+    std::memcpy(out->data, &pkt, sizeof(pkt));
+    out->len = sizeof(pkt);
+    out->address = addr;
+    netSend(udpSocket, out);
+    SDLNet_FreePacket(out);
+}
+
+// Host: forget a client, free its player and tell everyone else it left
+void hostDropClient(uint64_t key, uint8_t reason) {
+    auto it = clientPeers.find(key);
+    if (it == clientPeers.end()) return;
+    uint32_t id = it->second.id;
+    NetStats::instance().removePeer(it->second.address);
+    clientPeers.erase(it);
+    for (auto& [peerKey, peer] : clientPeers) sendDisconnect(peer.address, id, reason);
+    removeRemotePlayer(id);
+    SDL_Log("Host: client %u disconnected (reason %u), %zu remaining", id, reason, clientPeers.size());
+}
+
+// Host: CONN assigns an id (or repeats the ACPT for a retransmit), DISC drops the sender.
+// Returns true if the packet was a handshake packet.
+bool handleHostConnectionPacket(UDPpacket* in) {
+    if (in->len < 4) return false;
+    uint32_t magic;
+    std::memcpy(&magic, in->data, sizeof(magic));
+    uint64_t key = netAddressKey(in->address);
+
+    if (magic == MAGIC_CONN && in->len >= static_cast<int>(sizeof(ConnectPacket))) {
+        ConnectPacket req;
+        std::memcpy(&req, in->data, sizeof(req));
+        if (req.protocolVersion != NET_PROTOCOL_VERSION) {
+            SDL_Log("Host: rejecting client with protocol %u (ours is %u)", req.protocolVersion, NET_PROTOCOL_VERSION);
+            sendDisconnect(in->address, 0, DISCONNECT_VERSION_MISMATCH);
+            return true;
+        }
+        auto it = clientPeers.find(key);
+        if (it != clientPeers.end() && it->second.nonce != req.nonce) {
+            // Same address, new session: the old client restarted without saying goodbye
+            hostDropClient(key, DISCONNECT_QUIT);
+            it = clientPeers.end();
+        }
+        bool isNew = (it == clientPeers.end());
+        if (isNew) {
+            ClientPeer peer;
+            peer.address = in->address;
+            peer.id = nextClientId++;
+            if (nextClientId == INVALID_CLIENT_ID) nextClientId = 1;
+            peer.nonce = req.nonce;
+            it = clientPeers.emplace(key, peer).first;
+            NetStats::instance().setPeerId(in->address, peer.id);
+            SDL_Log("Host: client %u connected", peer.id);
+        }
+        it->second.silenceSeconds = 0.0f;
+
+        AcceptPacket ack{MAGIC_ACPT, req.nonce, it->second.id, worldSeed, WORLD_GENERATOR_VERSION};
+        UDPpacket* out = SDLNet_AllocPacket(sizeof(ack));
+        std::memcpy(out->data, &ack, sizeof(ack));
+        out->len = sizeof(ack);
+        out->address = in->address;
+        netSend(udpSocket, out);
+        SDLNet_FreePacket(out);
+
+        if (isNew) {
+            // Send current day/night state; the client generates the world from the seed in ACPT
+            sendDaytimeTo(in->address);
+        }
+        return true;
+    }
+
+    if (magic == MAGIC_DISC) {
+        hostDropClient(key, DISCONNECT_QUIT);
+        return true;
+    }
+    return false;
+}
+
+// Host: age every peer and drop the ones that went silent
+void hostUpdatePeers(float dt) {
+    std::vector<uint64_t> timedOut;
+    for (auto& [peerKey, peer] : clientPeers) {
+        peer.silenceSeconds += dt;
+        if (peer.silenceSeconds > NET_TIMEOUT_SECONDS) timedOut.push_back(peerKey);
+    }
+    for (uint64_t key : timedOut) hostDropClient(key, DISCONNECT_TIMEOUT);
+}
+
+// Client: drop every remote player and go back to connecting (host timed out or shut down)
+void clientResetSession() {
+    std::vector<uint32_t> ids;
+    for (auto& [id, rp] : remotePlayers) ids.push_back(id);
+    for (uint32_t id : ids) removeRemotePlayer(id);
+    clientId = INVALID_CLIENT_ID;
+    clientConnState = ClientConnState::Connecting;
+    connectNonce = static_cast<uint32_t>(netRng());
+    inputHistory.clear();
+    connectRetryTimer = 0.0f;
+    hostSilenceSeconds = 0.0f;
+    snapshotTicks.reset(); // the next host's ticks start over
+}
+
+// Client: ACPT completes the handshake, DISC removes a departed peer (or us).
+// Returns true if the packet was a handshake packet.
+bool handleClientConnectionPacket(UDPpacket* in) {
+    if (in->len < 4) return false;
+    uint32_t magic;
+    std::memcpy(&magic, in->data, sizeof(magic));
+
+    if (magic == MAGIC_ACPT && in->len >= static_cast<int>(sizeof(AcceptPacket))) {
+        AcceptPacket ack;
+        std::memcpy(&ack, in->data, sizeof(ack));
+        if (clientConnState == ClientConnState::Connecting && ack.nonce == connectNonce) {
+            if (ack.generatorVersion != WORLD_GENERATOR_VERSION) {
+                std::cerr << "Host generates worlds with generator version " << ack.generatorVersion
+                          << " (ours is " << WORLD_GENERATOR_VERSION << "); cannot join\n";
+                sendDisconnect(in->address, ack.clientId, DISCONNECT_VERSION_MISMATCH);
+                clientConnState = ClientConnState::Rejected;
+                return true;
+            }
+            // Chunks built before connecting may not match the host's world; start over
+            // and let ensureChunksAround regenerate from its seed
+            if (ack.worldSeed != worldSeed) {
+                clearWorldChunks();
+                worldSeed = ack.worldSeed;
+            }
+            clientId = ack.clientId;
+            clientConnState = ClientConnState::Connected;
+            NetStats::instance().setPeerId(in->address, 0);
+            SDL_Log("Client: connected, assigned id %u, world seed %u", clientId, worldSeed);
+        }
+        return true;
+    }
+
+    if (magic == MAGIC_DISC && in->len >= static_cast<int>(sizeof(DisconnectPacket))) {
+        DisconnectPacket disc;
+        std::memcpy(&disc, in->data, sizeof(disc));
+        if (disc.reason == DISCONNECT_VERSION_MISMATCH) {
+            std::cerr << "Host rejected connection: protocol version mismatch (ours is " << NET_PROTOCOL_VERSION << ")\n";
+            clientConnState = ClientConnState::Rejected;
+        } else if (disc.reason == DISCONNECT_HOST_SHUTDOWN || disc.clientId == clientId) {
+            SDL_Log("Client: host ended the session (reason %u), reconnecting", disc.reason);
+            clientResetSession();
+        } else {
+            removeRemotePlayer(disc.clientId);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Client: repeat CONN until accepted, and notice when the host goes silent
+void clientUpdateConnection(float dt) {
+    if (clientConnState == ClientConnState::Rejected) return;
+    if (clientConnState == ClientConnState::Connecting) {
+        connectRetryTimer -= dt;
+        if (connectRetryTimer > 0.0f) return;
+        connectRetryTimer = 0.5f;
+        ConnectPacket req{MAGIC_CONN, NET_PROTOCOL_VERSION, connectNonce};
+        UDPpacket* out = SDLNet_AllocPacket(sizeof(req));
+        std::memcpy(out->data, &req, sizeof(req));
+        out->len = sizeof(req);
+        out->address = hostAddr;
+        netSend(udpSocket, out);
+        SDLNet_FreePacket(out);
+        return;
+    }
+    hostSilenceSeconds += dt;
+    if (hostSilenceSeconds > NET_TIMEOUT_SECONDS) {
+        SDL_Log("Client: no packets from host for %.1fs, reconnecting", hostSilenceSeconds);
+        clientResetSession();
+    }
+}
+
+// Probe RTT to every peer once per second (host -> each client, client -> host)
+void sendNetPings(float dt) {
+    static float pingTimer = 0.0f;
+    static uint32_t pingSeq = 0;
+    if (!udpSocket) return;
+    pingTimer += dt;
+    if (pingTimer < 1.0f) return;
+    pingTimer = 0.0f;
+
+    PingPacket ping{MAGIC_PING, clientId, pingSeq++, NetStats::nowMicros()};
+    UDPpacket* out = SDLNet_AllocPacket(sizeof(ping));
+    std::memcpy(out->data, &ping, sizeof(ping));
+    out->len = sizeof(ping);
+    if (isHost) {
+        for (auto& [peerKey, peer] : clientPeers) {
+            out->address = peer.address;
+            netSend(udpSocket, out);
+        }
+    } else if (clientConnState == ClientConnState::Connected) {
+        out->address = hostAddr;
+        netSend(udpSocket, out);
+    }
+    SDLNet_FreePacket(out);
+}
+
 void sendInputPacket() {
-    if (!udpSocket || isHost) return;
+    if (!udpSocket || isHost || clientConnState != ClientConnState::Connected) return;
     
-    const Uint8* keys = SDL_GetKeyboardState(nullptr);
+    const Uint8* keys = NetRecorder::instance().keyboardState();
     uint8_t moveFlags = 0;
     if (keys[SDL_SCANCODE_W]) moveFlags |= (1 << 0);
     if (keys[SDL_SCANCODE_S]) moveFlags |= (1 << 1);
@@ -701,7 +855,7 @@ void sendInputPacket() {
     static int32_t lastMouseX = 0, lastMouseY = 0;
     uint8_t mouseDown = 0;
     int32_t mouseX = 0, mouseY = 0;
-    int buttons = SDL_GetMouseState(&mouseX, &mouseY);
+    int buttons = NetRecorder::instance().mouseState(&mouseX, &mouseY);
     if ((buttons & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0) {
         mouseDown = 1;
     }
@@ -734,7 +888,7 @@ void sendInputPacket() {
     // Calculate rod tip world position (match Player::onMouseDown and host computation)
     Rod* rod = player->getRod();
     Vector2 rodWorld = rod->getWorldPosition();
-    Vector2* rodSize = rod->getSize();
+    const Vector2* rodSize = rod->getSize();
     float hookStartX = rodWorld.x + rodSize->x / 2.0f;
     float hookStartY = rodWorld.y + rodSize->y;
     // Determine weapon fire (if player is holding harpoon and clicked)
@@ -745,62 +899,191 @@ void sendInputPacket() {
     }
 
     // Log the rod tip world position being sent
-    InputPacket pkt{clientId, inputSeq++, moveFlags, boardBoat, toggleBoatMovement, hasBoatControl, toggleHook, navDir.x, navDir.y, sendMouseDown, static_cast<int32_t>(worldX), static_cast<int32_t>(worldY), hookTargetX, hookTargetY};
-    pkt.hookStartX = static_cast<int32_t>(hookStartX);
-    pkt.hookStartY = static_cast<int32_t>(hookStartY);
-    pkt.equipAction = equipAction;
-    pkt.fireWeapon = fireWeapon;
-    pkt.weaponTargetX = weaponTargetX;
-    pkt.weaponTargetY = weaponTargetY;
-
-    UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
-    std::memcpy(out->data, &pkt, sizeof(pkt));
-    out->len = sizeof(pkt);
+    InputFrame frame{moveFlags, boardBoat, toggleBoatMovement, hasBoatControl, toggleHook, navDir.x, navDir.y, sendMouseDown, static_cast<int32_t>(worldX), static_cast<int32_t>(worldY), hookTargetX, hookTargetY};
+    frame.hookStartX = static_cast<int32_t>(hookStartX);
+    frame.hookStartY = static_cast<int32_t>(hookStartY);
+    frame.equipAction = equipAction;
+    frame.fireWeapon = fireWeapon;
+    frame.weaponTargetX = weaponTargetX;
+    frame.weaponTargetY = weaponTargetY;
+
+    // Resend the last few frames too, so a lost datagram does not lose a one-shot action
+    inputHistory.push_front(frame);
+    if (inputHistory.size() > INPUT_REDUNDANCY) inputHistory.pop_back();
+    std::vector<uint8_t> bytes = buildInputPacket(clientId, inputSeq++, inputHistory);
+
+    UDPpacket* out = netSendPacket();
+    if (bytes.size() > static_cast<size_t>(out->maxlen)) {
+        std::cerr << "Warning: input packet of " << bytes.size() << " bytes exceeds NET_MTU\n";
+        return;
+    }
+    std::memcpy(out->data, bytes.data(), bytes.size());
+    out->len = static_cast<int>(bytes.size());
     out->address = hostAddr;
-    SDLNet_UDP_Send(udpSocket, -1, out);
-    SDLNet_FreePacket(out);
+    netSend(udpSocket, out);
+}
+
+// Host: apply one frame of a client's input to its player
+void applyRemoteInput(Player* remote, uint32_t ownerId, const InputFrame& input) {
+    // Simulate input by directly calling key handlers
+    if (input.moveFlags & (1 << 0)) remote->onKeyDown(SDLK_w); else remote->onKeyUp(SDLK_w);
+    if (input.moveFlags & (1 << 1)) remote->onKeyDown(SDLK_s); else remote->onKeyUp(SDLK_s);
+    if (input.moveFlags & (1 << 2)) remote->onKeyDown(SDLK_a); else remote->onKeyUp(SDLK_a);
+    if (input.moveFlags & (1 << 3)) remote->onKeyDown(SDLK_d); else remote->onKeyUp(SDLK_d);
+    
+    // Handle boarding request
+    if (input.boardBoat == 1) {
+        if (boat->isPlayerOnBoard(remote)) {
+            boat->leaveBoat(remote);
+        } else {
+            // Check if close enough to board
+            ICollidable* boatCollider = boat;
+            ICollidable* remoteCollider = remote;
+            if (boatCollider && remoteCollider) {
+                auto boatShape = boatCollider->getCollisionBox();
+                auto remoteShape = remoteCollider->getCollisionBox();
+                if (hitBoxDistance(boatShape, remoteShape) < 10.0f) {
+                    boat->boardBoat(remote);
+                }
+            }
+        }
+    }
+    
+    // Handle boat navigation direction update
+    if (input.hasBoatControl == 1) {
+        float angle = atan2(input.boatNavDirY, input.boatNavDirX);
+        boat->setNavigationDirection(angle);
+    }
+    
+    // Handle boat movement toggle (E key)
+    if (input.toggleBoatMovement == 1) {
+        boat->onInteract(SDLK_e);
+    }
+    
+    // Handle hook toggle
+    if (input.toggleHook == 1) {
+        remote->onKeyDown(SDLK_r);
+    }
+
+    // Handle equip requests from client
+    if (input.equipAction == 1) {
+        remote->equipRod();
+    } else if (input.equipAction == 2) {
+        remote->equipHarpoon();
+    }
+
+    // Handle weapon fire (harpoon)
+    if (input.fireWeapon == 1) {
+        if (remote->getEquipment() != Player::EQUIP_HARPOON) remote->equipHarpoon();
+        if (remote->getGun() && remote->getGun()->getProjectile()) {
+            Vector2 target = { static_cast<float>(input.weaponTargetX), static_cast<float>(input.weaponTargetY) };
+            Projectile* rp = remote->getGun()->getProjectile();
+            // Attempt to fire; only add projectile to world updates if shot succeeds
+            bool fired = remote->getGun()->fireAt(target);
+            if (fired) {
+                gameObjects.add(rp);
+                SDL_Log("Host: Fired harpoon for client %u toward (%.2f, %.2f)", ownerId, target.x, target.y);
+            }
+        }
+    }
+
+    // Handle mouse click for fishing hook casting
+    if (input.mouseDown == 1 && remote->isRodVisible() && remote->getFishingProjectile()) {
+        // Use client-sent rod tip world position as the authoritative cast origin
+        Vector2 hookTip = { static_cast<float>(input.hookStartX), static_cast<float>(input.hookStartY) };
+        printf("Host: received rod tip for client %u (%.2f, %.2f)\n", ownerId, hookTip.x, hookTip.y);
+        printf("Host: received hook target (X: %d, Y: %d)\n", input.hookTargetX, input.hookTargetY);
+        Vector2 target = { static_cast<float>(input.hookTargetX), static_cast<float>(input.hookTargetY) };
+        Vector2 direction = { target.x - hookTip.x, target.y - hookTip.y };
+        remote->getFishingProjectile()->retract(false);
+        remote->getFishingProjectile()->cast(hookTip, direction, target);
+        // Use seed-based broadcast so clients can deterministically generate particle positions locally
+        const int count = 10;
+        const float duration = 4.5f;
+        const int zidx = LAYER_PARTICLE;
+        const float spread = 12.0f;
+        // Compute spawn delay deterministically on host
+        std::uniform_real_distribution<float> delayDist(2.6f, 5.0f);
+        float delay = delayDist(netRng);
+        // Compute center for noisy starts deterministically on host
+        std::uniform_real_distribution<float> radiusDist(40.0f, 140.0f);
+        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
+        float radius = radiusDist(netRng);
+        float angle = angleDist(netRng);
+        Vector2 startCenter = { hookTip.x + std::cos(angle) * radius, hookTip.y + std::sin(angle) * radius };
+
+        // Create compact ParticlePacket that contains seed + center; clients will reproduce exact noisy starts
+        uint32_t seed = static_cast<uint32_t>(netRng());
+        ParticlePacket p{};
+        p.magic = 0x54524150; // 'PART'
+        p.ownerId = ownerId;
+        p.seed = seed;
+        p.startX = startCenter.x;
+        p.startY = startCenter.y;
+        p.destX = hookTip.x;
+        p.destY = hookTip.y;
+        p.delay = delay;
+        p.count = static_cast<uint8_t>(count);
+        p.duration = duration;
+        p.zIndex = zidx;
+        p.spread = spread;
+        p.r = 0; p.g = 255; p.b = 0; p.a = 255;
+
+        size_t totalSize = sizeof(p);
+        UDPpacket* out = SDLNet_AllocPacket(static_cast<int>(totalSize));
+        std::memcpy(out->data, &p, sizeof(p));
+        out->len = static_cast<uint16_t>(totalSize);
+        for (auto& [peerKey, peer] : clientPeers) {
+            out->address = peer.address;
+            netSend(udpSocket, out);
+        }
+        SDLNet_FreePacket(out);
+
+        // Schedule host-side spawn using seed so host matches clients
+        if (remote->getFishingProjectile()) {
+            remote->getFishingProjectile()->cancelPendingAttract();
+            remote->getFishingProjectile()->scheduleAttractFromSeed(seed, count, SDL_Color{0,255,0,255}, duration, zidx, spread, startCenter, true, (ownerId == clientId), delay);
+        }
+
+        // If this owner is the host itself (ownerId == clientId), also schedule on local player representation
+        if (ownerId == clientId) {
+            if (player && player->getFishingProjectile()) {
+                player->getFishingProjectile()->cancelPendingAttract();
+                player->getFishingProjectile()->scheduleAttractFromSeed(seed, count, SDL_Color{0,255,0,255}, duration, zidx, spread, startCenter, true, true, delay);
+            }
+        }
+    }
 }
 
 void receiveInputs() {
     if (!udpSocket || !isHost) return;
+    PROFILE_ZONE("receiveInputs");
     
-    UDPpacket* in = SDLNet_AllocPacket(512);
-    while (SDLNet_UDP_Recv(udpSocket, in)) {
+    static std::vector<InputFrame> inputFrames;
+    UDPpacket* in = netRecvPacket();
+    while (netRecv(udpSocket, in)) {
+        // CONN/DISC are the only packets accepted from addresses without a session
+        if (handleHostConnectionPacket(in)) continue;
+        auto peerIt = clientPeers.find(netAddressKey(in->address));
+        if (peerIt == clientPeers.end()) continue;
+        ClientPeer& sender = peerIt->second;
+        sender.silenceSeconds = 0.0f;
+
+        // Echo latency probes straight back to the sender, and time our own probes
+        if (handlePingPong(in)) continue;
+
         // Check for AttackingFish request from client first
         if (in->len >= sizeof(AttackingFishRequestPacket)) {
             AttackingFishRequestPacket req;
             std::memcpy(&req, in->data, sizeof(req));
             if (req.magic == 0x51524641) { // 'AFRQ'
-                // Register client address if new
-                bool known = false;
-                for (auto& addr : clientAddrs) {
-                    if (addr.host == in->address.host && addr.port == in->address.port) {
-                        known = true;
-                        break;
-                    }
-                }
-                if (!known) {
-                    clientAddrs.push_back(in->address);
-                    SDL_Log("New client connected (via AFRQ): %u", req.ownerId);
-
-                    // Send current day/night state to newly connected client
-                    DaytimePacket dpk{};
-                    dpk.magic = 0x54415944; // 'DAYT'
-                    dpk.dayTimeSeconds = std::fmod(g_dayTimeSeconds, g_dayCycleDurationSeconds);
-                    dpk.cycleDurationSeconds = g_dayCycleDurationSeconds;
-                    UDPpacket* dout = SDLNet_AllocPacket(sizeof(dpk));
-                    std::memcpy(dout->data, &dpk, sizeof(dpk));
-                    dout->len = sizeof(dpk);
-                    dout->address = in->address;
-                    SDLNet_UDP_Send(udpSocket, -1, dout);
-                    SDLNet_FreePacket(dout);
-                }
+                req.ownerId = sender.id; // trust the session, not the packet
 
                 // Create authoritative attacking fish and broadcast spawn to all clients
                 uint32_t eid = nextEntityId++;
                 Vector2 pos{req.x, req.y};
                 AttackingFish* af = new AttackingFish(pos, g_renderer, eid, req.ownerId);
-                gameObjects.push_back(af);
+                gameObjects.add(af);
                 SDL_Log("Host: created AttackingFish for client request owner=%u at (%.2f,%.2f) eid=%u", req.ownerId, req.x, req.y, eid);
 
                 // Broadcast spawn packet
@@ -813,9 +1096,9 @@ void receiveInputs() {
                 UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
                 std::memcpy(out->data, &pkt, sizeof(pkt));
                 out->len = sizeof(pkt);
-                for (auto& addr : clientAddrs) {
-                    out->address = addr;
-                    SDLNet_UDP_Send(udpSocket, -1, out);
+                for (auto& [peerKey, peer] : clientPeers) {
+                    out->address = peer.address;
+                    netSend(udpSocket, out);
                 }
                 SDLNet_FreePacket(out);
 
@@ -828,177 +1111,32 @@ void receiveInputs() {
             }
         }
 
-        if (in->len >= sizeof(InputPacket)) {
-            InputPacket pkt;
-            std::memcpy(&pkt, in->data, sizeof(pkt));
-            
-            // Track new clients
-            bool known = false;
-            for (auto& addr : clientAddrs) {
-                if (addr.host == in->address.host && addr.port == in->address.port) {
-                    known = true;
-                    break;
-                }
-            }
-            if (!known) {
-                clientAddrs.push_back(in->address);
-                std::cout << "New client connected: " << pkt.clientId << "\n";
-
-                // Send current day/night state to newly connected client
-                DaytimePacket dpk{};
-                dpk.magic = 0x54415944; // 'DAYT'
-                dpk.dayTimeSeconds = std::fmod(g_dayTimeSeconds, g_dayCycleDurationSeconds);
-                dpk.cycleDurationSeconds = g_dayCycleDurationSeconds;
-                UDPpacket* dout = SDLNet_AllocPacket(sizeof(dpk));
-                std::memcpy(dout->data, &dpk, sizeof(dpk));
-                dout->len = sizeof(dpk);
-                dout->address = in->address;
-                SDLNet_UDP_Send(udpSocket, -1, dout);
-                SDLNet_FreePacket(dout);
-            }
-            
-            // Apply input to remote player
-            Player* remote = getOrCreateRemotePlayer(pkt.clientId);
-            if (remote) {
-                // Simulate input by directly calling key handlers
-                if (pkt.moveFlags & (1 << 0)) remote->onKeyDown(SDLK_w); else remote->onKeyUp(SDLK_w);
-                if (pkt.moveFlags & (1 << 1)) remote->onKeyDown(SDLK_s); else remote->onKeyUp(SDLK_s);
-                if (pkt.moveFlags & (1 << 2)) remote->onKeyDown(SDLK_a); else remote->onKeyUp(SDLK_a);
-                if (pkt.moveFlags & (1 << 3)) remote->onKeyDown(SDLK_d); else remote->onKeyUp(SDLK_d);
-                
-                // Handle boarding request
-                if (pkt.boardBoat == 1) {
-                    if (boat->isPlayerOnBoard(remote)) {
-                        boat->leaveBoat(remote);
-                    } else {
-                        // Check if close enough to board
-                        ICollidable* boatCollider = dynamic_cast<ICollidable*>(boat);
-                        ICollidable* remoteCollider = dynamic_cast<ICollidable*>(remote);
-                        if (boatCollider && remoteCollider) {
-                            auto boatShape = boatCollider->getCollisionBox();
-                            auto remoteShape = remoteCollider->getCollisionBox();
-                            if (hitBoxDistance(boatShape, remoteShape) < 10.0f) {
-                                boat->boardBoat(remote);
-                            }
-                        }
-                    }
-                }
-                
-                // Handle boat navigation direction update
-                if (pkt.hasBoatControl == 1) {
-                    float angle = atan2(pkt.boatNavDirY, pkt.boatNavDirX);
-                    boat->setNavigationDirection(angle);
-                }
-                
-                // Handle boat movement toggle (E key)
-                if (pkt.toggleBoatMovement == 1) {
-                    boat->onInteract(SDLK_e);
-                }
-                
-                // Handle hook toggle
-                if (pkt.toggleHook == 1) {
-                    remote->onKeyDown(SDLK_r);
-                }
-
-                // Handle equip requests from client
-                if (pkt.equipAction == 1) {
-                    remote->equipRod();
-                } else if (pkt.equipAction == 2) {
-                    remote->equipHarpoon();
-                }
-
-                // Handle weapon fire (harpoon)
-                if (pkt.fireWeapon == 1) {
-                    if (remote->getEquipment() != Player::EQUIP_HARPOON) remote->equipHarpoon();
-                    if (remote->getGun() && remote->getGun()->getProjectile()) {
-                        Vector2 target = { static_cast<float>(pkt.weaponTargetX), static_cast<float>(pkt.weaponTargetY) };
-                        Projectile* rp = remote->getGun()->getProjectile();
-                        // Attempt to fire; only add projectile to world updates if shot succeeds
-                        bool fired = remote->getGun()->fireAt(target);
-                        if (fired) {
-                            if (std::find(gameObjects.begin(), gameObjects.end(), rp) == gameObjects.end()) {
-                                gameObjects.push_back(rp);
-                            }
-                            SDL_Log("Host: Fired harpoon for client %u toward (%.2f, %.2f)", pkt.clientId, target.x, target.y);
-                        }
-                    }
-                }
-
-                // Handle mouse click for fishing hook casting
-                    if (pkt.mouseDown == 1 && remote->isRodVisible() && remote->getFishingProjectile()) {
-                    // Use client-sent rod tip world position as the authoritative cast origin
-                    Vector2 hookTip = { static_cast<float>(pkt.hookStartX), static_cast<float>(pkt.hookStartY) };
-                    printf("Host: received rod tip for client %u (%.2f, %.2f)\n", pkt.clientId, hookTip.x, hookTip.y);
-                    printf("Host: received hook target (X: %d, Y: %d)\n", pkt.hookTargetX, pkt.hookTargetY);
-                    Vector2 target = { static_cast<float>(pkt.hookTargetX), static_cast<float>(pkt.hookTargetY) };
-                    Vector2 direction = { target.x - hookTip.x, target.y - hookTip.y };
-                    remote->getFishingProjectile()->retract(false);
-                    remote->getFishingProjectile()->cast(hookTip, direction, target);
-                    // Use seed-based broadcast so clients can deterministically generate particle positions locally
-                    const int count = 10;
-                    const float duration = 4.5f;
-                    const int zidx = LAYER_PARTICLE;
-                    const float spread = 12.0f;
-                    // Compute spawn delay deterministically on host
-                    std::uniform_real_distribution<float> delayDist(2.6f, 5.0f);
-                    float delay = delayDist(netRng);
-                    // Compute center for noisy starts deterministically on host
-                    std::uniform_real_distribution<float> radiusDist(40.0f, 140.0f);
-                    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-                    float radius = radiusDist(netRng);
-                    float angle = angleDist(netRng);
-                    Vector2 startCenter = { hookTip.x + std::cos(angle) * radius, hookTip.y + std::sin(angle) * radius };
-
-                    // Create compact ParticlePacket that contains seed + center; clients will reproduce exact noisy starts
-                    uint32_t seed = static_cast<uint32_t>(netRng());
-                    ParticlePacket p{};
-                    p.magic = 0x54524150; // 'PART'
-                    p.ownerId = pkt.clientId;
-                    p.seed = seed;
-                    p.startX = startCenter.x;
-                    p.startY = startCenter.y;
-                    p.destX = hookTip.x;
-                    p.destY = hookTip.y;
-                    p.delay = delay;
-                    p.count = static_cast<uint8_t>(count);
-                    p.duration = duration;
-                    p.zIndex = zidx;
-                    p.spread = spread;
-                    p.r = 0; p.g = 255; p.b = 0; p.a = 255;
-
-                    size_t totalSize = sizeof(p);
-                    UDPpacket* out = SDLNet_AllocPacket(static_cast<int>(totalSize));
-                    std::memcpy(out->data, &p, sizeof(p));
-                    out->len = static_cast<uint16_t>(totalSize);
-                    for (auto& addr : clientAddrs) {
-                        out->address = addr;
-                        SDLNet_UDP_Send(udpSocket, -1, out);
-                    }
-                    SDLNet_FreePacket(out);
-
-                    // Schedule host-side spawn using seed so host matches clients
-                    if (remote->getFishingProjectile()) {
-                        remote->getFishingProjectile()->cancelPendingAttract();
-                        remote->getFishingProjectile()->scheduleAttractFromSeed(seed, count, SDL_Color{0,255,0,255}, duration, zidx, spread, startCenter, true, (pkt.clientId == clientId), delay);
-                    }
+        InputPacketHeader header;
+        if (parseInputPacket(in->data, static_cast<size_t>(in->len), header, inputFrames)) {
+            NetStats::instance().onSequence(in->address, header.latestSeq);
+            if (header.clientId != sender.id) continue; // stale or spoofed id
+            getOrCreateRemotePlayer(header.clientId);
+            // Applied one frame per tick by hostApplyBufferedInputs
+            sender.inputBuffer.receive(header.latestSeq, inputFrames, hostClockSeconds);
+        }
+    }
+}
 
-                    // If this owner is the host itself (ownerId == clientId), also schedule on local player representation
-                    if (pkt.clientId == clientId) {
-                        if (player && player->getFishingProjectile()) {
-                            player->getFishingProjectile()->cancelPendingAttract();
-                            player->getFishingProjectile()->scheduleAttractFromSeed(seed, count, SDL_Color{0,255,0,255}, duration, zidx, spread, startCenter, true, true, delay);
-                        }
-                    }
-                }
-            }
+// Host: apply exactly one buffered input frame per client for this simulation tick
+void hostApplyBufferedInputs(float tickSeconds) {
+    for (auto& [peerKey, peer] : clientPeers) {
+        InputJitterBuffer& buffer = peer.inputBuffer;
+        InputFrame frame;
+        if (buffer.consume(frame, tickSeconds)) {
+            if (Player* remote = getOrCreateRemotePlayer(peer.id)) applyRemoteInput(remote, peer.id, frame);
         }
+        NetStats::instance().setInputBuffer(peer.address, buffer.getDepth(), buffer.getTargetDepth(), buffer.getJitterMs(), buffer.getUnderruns());
     }
-    SDLNet_FreePacket(in);
 }
 
 // Broadcast a compact particle seed packet for a host-initiated cast
 void hostBroadcastParticleForHook(const Vector2& hookTip) {
-    if (!udpSocket || !isHost || clientAddrs.empty()) return;
+    if (!udpSocket || !isHost || clientPeers.empty()) return;
 
     const int count = 10;
     const float duration = 4.5f;
@@ -1033,9 +1171,9 @@ void hostBroadcastParticleForHook(const Vector2& hookTip) {
     if (!out) return;
     std::memcpy(out->data, &p, sizeof(p));
     out->len = static_cast<uint16_t>(totalSize);
-    for (auto& addr : clientAddrs) {
-        out->address = addr;
-        SDLNet_UDP_Send(udpSocket, -1, out);
+    for (auto& [peerKey, peer] : clientPeers) {
+        out->address = peer.address;
+        netSend(udpSocket, out);
     }
     SDLNet_FreePacket(out);
 
@@ -1048,7 +1186,7 @@ void hostBroadcastParticleForHook(const Vector2& hookTip) {
 
 // Broadcast authoritative hook arrival to clients
 void hostBroadcastHookArrival(uint32_t ownerId, const Vector2& pos) {
-    if (!udpSocket || !isHost || clientAddrs.empty()) return;
+    if (!udpSocket || !isHost || clientPeers.empty()) return;
 
     HookArrivalPacket hp{};
     hp.magic = 0x52414B48; // 'HKAR'
@@ -1061,9 +1199,9 @@ void hostBroadcastHookArrival(uint32_t ownerId, const Vector2& pos) {
     if (!out) return;
     std::memcpy(out->data, &hp, sizeof(hp));
     out->len = static_cast<uint16_t>(totalSize);
-    for (auto& addr : clientAddrs) {
-        out->address = addr;
-        SDLNet_UDP_Send(udpSocket, -1, out);
+    for (auto& [peerKey, peer] : clientPeers) {
+        out->address = peer.address;
+        netSend(udpSocket, out);
     }
     SDLNet_FreePacket(out);
 
@@ -1082,9 +1220,7 @@ void onHook(const Vector2& pos) {
         if (dist2 < 4.0f * 4.0f) { // close enough to be our hook
                     // If there's already an attacking fish at the hook position, do not start a minigame
             bool afPresent = false;
-            for (GameObject* obj : gameObjects) {
-                AttackingFish* afc = dynamic_cast<AttackingFish*>(obj);
-                if (!afc) continue;
+            for (AttackingFish* afc : AttackingFish::all()) {
                 Vector2 afPos = afc->getWorldPosition();
                 float dx2 = afPos.x - hookPos.x;
                 float dy2 = afPos.y - hookPos.y;
@@ -1094,7 +1230,7 @@ void onHook(const Vector2& pos) {
                 SDL_Log("Hooked existing attacking fish at (%.2f,%.2f) - skipping minigame", hookPos.x, hookPos.y);
                 if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
                 // If host, broadcast hook arrival so clients retract
-                if (isHost && udpSocket && !clientAddrs.empty()) hostBroadcastHookArrival(clientId, hookPos);
+                if (isHost && udpSocket && !clientPeers.empty()) hostBroadcastHookArrival(clientId, hookPos);
                 return;
             }
 
@@ -1107,10 +1243,10 @@ void onHook(const Vector2& pos) {
                 if (isHost || !udpSocket) {
                     uint32_t eid = isHost ? nextEntityId++ : 0;
                     AttackingFish* af = new AttackingFish(hookPos, g_renderer, eid, clientId);
-                    gameObjects.push_back(af);
+                    gameObjects.add(af);
                     SDL_Log("Spawned AttackingFish at (%.2f,%.2f) eid=%u owner=%u", hookPos.x, hookPos.y, eid, clientId);
                     // If running as host, broadcast spawn packet to clients
-                    if (isHost && udpSocket && !clientAddrs.empty()) {
+                    if (isHost && udpSocket && !clientPeers.empty()) {
                         AttackingFishSpawnPacket pkt{};
                         pkt.magic = 0x50534641; // 'AFSP' packed
                         pkt.entityId = eid;
@@ -1120,16 +1256,16 @@ void onHook(const Vector2& pos) {
                         UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
                         std::memcpy(out->data, &pkt, sizeof(pkt));
                         out->len = sizeof(pkt);
-                        for (auto& addr : clientAddrs) {
-                            out->address = addr;
-                            SDLNet_UDP_Send(udpSocket, -1, out);
+                        for (auto& [peerKey, peer] : clientPeers) {
+                            out->address = peer.address;
+                            netSend(udpSocket, out);
                         }
                         SDLNet_FreePacket(out);
                     }
                 } else {
                     // Client: spawn a local AttackingFish immediately so the owner sees it without waiting for host packet
                     AttackingFish* af = new AttackingFish(hookPos, g_renderer, 0, clientId);
-                    gameObjects.push_back(af);
+                    gameObjects.add(af);
                     SDL_Log("Client: locally spawned AttackingFish at (%.2f,%.2f) owner=%u (pending authoritative spawn)", hookPos.x, hookPos.y, clientId);
 
                     // Send request to host to create authoritative spawn (if using UDP networking)
@@ -1143,7 +1279,7 @@ void onHook(const Vector2& pos) {
                         std::memcpy(outReq->data, &req, sizeof(req));
                         outReq->len = sizeof(req);
                         outReq->address = hostAddr;
-                        SDLNet_UDP_Send(udpSocket, -1, outReq);
+                        netSend(udpSocket, outReq);
                         SDLNet_FreePacket(outReq);
                         SDL_Log("Client: sent AttackingFish request to host for owner=%u at (%.2f,%.2f)", clientId, hookPos.x, hookPos.y);
                     }
@@ -1215,9 +1351,7 @@ void onHook(const Vector2& pos) {
             // We found the remote whose hook attracted
             // First, ensure there isn't already an AttackingFish near this hook (do not spawn duplicate)
             bool afPresent = false;
-            for (GameObject* obj : gameObjects) {
-                AttackingFish* afc = dynamic_cast<AttackingFish*>(obj);
-                if (!afc) continue;
+            for (AttackingFish* afc : AttackingFish::all()) {
                 Vector2 afPos = afc->getWorldPosition();
                 float dx2 = afPos.x - pos.x; float dy2 = afPos.y - pos.y;
                 if (dx2*dx2 + dy2*dy2 < 16.0f * 16.0f) { afPresent = true; break; }
@@ -1225,7 +1359,7 @@ void onHook(const Vector2& pos) {
             if (afPresent) {
                 SDL_Log("Remote hook at (%.2f,%.2f) already has AttackingFish, retracting hook and not starting minigame", pos.x, pos.y);
                 remote->getFishingProjectile()->retract();
-                if (isHost && udpSocket && !clientAddrs.empty()) hostBroadcastHookArrival(id, pos);
+                if (isHost && udpSocket && !clientPeers.empty()) hostBroadcastHookArrival(id, pos);
                 return;
             }
 
@@ -1236,10 +1370,10 @@ void onHook(const Vector2& pos) {
                 if (isHost || !udpSocket) {
                     uint32_t eid = isHost ? nextEntityId++ : 0;
                     AttackingFish* af = new AttackingFish(pos, g_renderer, eid, id);
-                    gameObjects.push_back(af);
+                    gameObjects.add(af);
                     SDL_Log("Spawned AttackingFish for remote %u at (%.2f,%.2f) eid=%u owner=%u", id, pos.x, pos.y, eid, id);
                     // If running as host, broadcast spawn packet to clients
-                    if (isHost && udpSocket && !clientAddrs.empty()) {
+                    if (isHost && udpSocket && !clientPeers.empty()) {
                         AttackingFishSpawnPacket pkt{};
                         pkt.magic = 0x50534641; // 'AFSP'
                         pkt.entityId = eid;
@@ -1249,25 +1383,24 @@ void onHook(const Vector2& pos) {
                         UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
                         std::memcpy(out->data, &pkt, sizeof(pkt));
                         out->len = sizeof(pkt);
-                        for (auto& addr : clientAddrs) {
-                            out->address = addr;
-                            SDLNet_UDP_Send(udpSocket, -1, out);
+                        for (auto& [peerKey, peer] : clientPeers) {
+                            out->address = peer.address;
+                            netSend(udpSocket, out);
                         }
                         SDLNet_FreePacket(out);
                     }
                 }
                 // Retract remote hook on host and notify clients about arrival
                 remote->getFishingProjectile()->retract();
-                if (isHost && udpSocket && !clientAddrs.empty()) hostBroadcastHookArrival(id, pos);
+                if (isHost && udpSocket && !clientPeers.empty()) hostBroadcastHookArrival(id, pos);
                 return;
             } else {
                 // Not an attacking fish: treat as normal spawn for remote - retract and optionally spawn a free fish
                 remote->getFishingProjectile()->retract();
-                if (isHost && udpSocket && !clientAddrs.empty()) hostBroadcastHookArrival(id, pos);
+                if (isHost && udpSocket && !clientPeers.empty()) hostBroadcastHookArrival(id, pos);
                 if (g_renderer) {
-                    GameObject* caught = new GameObject(pos, {2.0f,2.0f}, "./sprites/fish.bmp", g_renderer, LAYER_PARTICLE);
-                    gameObjects.push_back(caught);
-                    fishesMovingToPlayer.push_back(caught);
+                    GameObject* caught = new CaughtFish(pos, g_renderer);
+                    fishesMovingToPlayer.push_back(gameObjects.add(caught));
                     SDL_Log("Spawned free fish at (%.2f,%.2f) for remote %u", pos.x, pos.y, id);
                 }
                 return;
@@ -1277,38 +1410,19 @@ void onHook(const Vector2& pos) {
 
     // Otherwise spawn a free fish in the world (remote player or missed minigame)
     if (g_renderer) {
-        GameObject* freeFish = new GameObject(pos, {2.0f,2.0f}, "./sprites/fish.bmp", g_renderer, LAYER_PARTICLE);
-        gameObjects.push_back(freeFish);
-        fishesMovingToPlayer.push_back(freeFish);
+        GameObject* freeFish = new CaughtFish(pos, g_renderer);
+        fishesMovingToPlayer.push_back(gameObjects.add(freeFish));
         SDL_Log("Spawned free fish at (%.2f,%.2f) (no matching hook)", pos.x, pos.y);
     }
 } 
 
 
-// Helper function to check collision between two collision shapes (handles single and multi-rectangle)
-bool checkCollision(const std::vector<Rectangle>& shapeA, 
-                    const std::vector<Rectangle>& shapeB) {
-    
-    
-    // Check all combinations of rectangles
-    for (const auto& rectA : shapeA) {
-        for (const auto& rectB : shapeB) {
-            if (rectA.intersects(rectB)) {
-                return true;
-            }
-        }
-    }
-    
-    return false;
-}
-
-
-
 void broadcastSnapshot() {
-    if (!udpSocket || !isHost || clientAddrs.empty()) return;
+    if (!udpSocket || !isHost || clientPeers.empty()) return;
     
     static uint32_t tick = 0;
-    std::vector<PlayerState> states;
+    static std::vector<PlayerState> states; // reused every tick
+    states.clear();
     
     // Add local player
     Vector2 pos = player->getWorldPosition();
@@ -1384,20 +1498,90 @@ void broadcastSnapshot() {
     boatState.navDirY = navDir.y;
     boatState.isMoving = boat->getIsMoving() ? 1 : 0;
     
-    SnapshotHeader header{tick++, static_cast<uint32_t>(states.size()), 1};
-    size_t totalSize = sizeof(header) + sizeof(boatState) + states.size() * sizeof(PlayerState);
-    
-    UDPpacket* out = SDLNet_AllocPacket(static_cast<int>(totalSize));
-    std::memcpy(out->data, &header, sizeof(header));
-    std::memcpy(out->data + sizeof(header), &boatState, sizeof(boatState));
-    std::memcpy(out->data + sizeof(header) + sizeof(boatState), states.data(), states.size() * sizeof(PlayerState));
-    out->len = static_cast<uint16_t>(totalSize);
-    
-    for (auto& addr : clientAddrs) {
-        out->address = addr;
-        SDLNet_UDP_Send(udpSocket, -1, out);
+    // Split into MTU-sized parts; the host player is first so it always rides with the boat in part 0
+    auto parts = buildSnapshotParts(tick++, &boatState, states);
+    UDPpacket* out = netSendPacket();
+    for (const auto& part : parts) {
+        std::memcpy(out->data, part.data(), part.size());
+        out->len = static_cast<int>(part.size());
+        for (auto& [peerKey, peer] : clientPeers) {
+            out->address = peer.address;
+            netSend(udpSocket, out);
+        }
     }
-    SDLNet_FreePacket(out);
+}
+
+// Draw the per-peer NetStats summary in the top-left corner. Lines are only re-formatted when the rate window rolls.
+void renderNetStatsOverlay(SDL_Renderer* renderer) {
+    NetStats& stats = NetStats::instance();
+    if (netStatsOverlayLines.empty() || netStatsOverlayGeneration != stats.getWindowGeneration()) {
+        netStatsOverlayGeneration = stats.getWindowGeneration();
+        std::vector<std::string> lines = stats.formatOverlay();
+        if (NetSim::instance().isEnabled()) lines.push_back(NetSim::instance().describe());
+        while (netStatsOverlayLines.size() > lines.size()) {
+            delete netStatsOverlayLines.back();
+            netStatsOverlayLines.pop_back();
+        }
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (i < netStatsOverlayLines.size()) {
+                netStatsOverlayLines[i]->setText(lines[i]);
+            } else {
+                Vector2 linePos{16.0f, 96.0f + static_cast<float>(i) * 16.0f};
+                netStatsOverlayLines.push_back(new Text(linePos, lines[i], "./fonts/font.ttf", 14, renderer, SDL_Color{255,255,255,255}, LAYER_UI));
+            }
+        }
+    }
+
+    int width = 0;
+    for (Text* t : netStatsOverlayLines) width = std::max(width, static_cast<int>(t->getSize()->x));
+    SDL_Rect bg = {8, 88, width + 16, static_cast<int>(netStatsOverlayLines.size()) * 16 + 16};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &bg);
+    for (Text* t : netStatsOverlayLines) t->drawUI(renderer);
+}
+
+// FNV-1a over the simulation state a replay has to reproduce exactly
+uint64_t computeStateHash() {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    };
+    auto mixPlayer = [&mix](uint32_t id, Player* p) {
+        Vector2 pos = p->getWorldPosition();
+        Vector2 vel = p->getVelocity();
+        float hp = p->getHp();
+        int equipment = static_cast<int>(p->getEquipment());
+        mix(&id, sizeof(id));
+        mix(&pos, sizeof(pos));
+        mix(&vel, sizeof(vel));
+        mix(&hp, sizeof(hp));
+        mix(&equipment, sizeof(equipment));
+    };
+
+    mix(&g_dayTimeSeconds, sizeof(g_dayTimeSeconds));
+    mix(&coinCount, sizeof(coinCount));
+    if (player) mixPlayer(clientId, player);
+    std::vector<uint32_t> ids;
+    for (auto& [id, rp] : remotePlayers) ids.push_back(id);
+    std::sort(ids.begin(), ids.end());
+    for (uint32_t id : ids) mixPlayer(id, remotePlayers[id]);
+    if (boat) {
+        Vector2 bpos = boat->getWorldPosition();
+        float rot = boat->getRotation();
+        mix(&bpos, sizeof(bpos));
+        mix(&rot, sizeof(rot));
+    }
+    uint64_t objectCount = gameObjects.size();
+    mix(&objectCount, sizeof(objectCount));
+    for (GameObject* obj : gameObjects) {
+        Vector2 pos = obj->getWorldPosition();
+        uint8_t visible = obj->getVisible() ? 1 : 0;
+        mix(&pos, sizeof(pos));
+        mix(&visible, sizeof(visible));
+    }
+    return h;
 }
 
 float hitBoxDistance(std::vector<Rectangle> shapeA, std::vector<Rectangle> shapeB) {
@@ -1414,6 +1598,18 @@ float hitBoxDistance(std::vector<Rectangle> shapeA, std::vector<Rectangle> shape
 }
 
 int main(int argc, char* argv[]) {
+    const Uint64 startupBegin = SDL_GetPerformanceCounter();
+    uint32_t sessionSeed = 0;
+    bool sessionSeedGiven = false;
+    std::string recordPath;
+    std::string replayPath;
+    bool headless = false;
+    bool fastMode = false;
+    uint16_t tickRate = DEFAULT_TICK_RATE;
+    int jobWorkers = -1;
+    std::string tracePath;
+    std::string packPath = "assets.spak";
+
     // Parse command-line args
     for (int i = 1; i < argc; ++i) {
         if (std::string(argv[i]) == "--host" && i + 1 < argc) {
@@ -1446,10 +1642,95 @@ int main(int argc, char* argv[]) {
                 std::cerr << "UDP_Open failed (client): " << SDLNet_GetError() << "\n";
                 return 1;
             }
-            // Generate unique client ID (never 0, that's reserved for host)
-            clientId = 1 + (SDL_GetTicks() % 0xFFFFFFFE);
-            std::cout << "Connecting to " << ip << ":" << port << " as client " << clientId << "\n";
+            // The host assigns our id when it accepts the connection (see clientUpdateConnection)
+            clientId = INVALID_CLIENT_ID;
+            std::cout << "Connecting to " << ip << ":" << port << "\n";
+        } else if (std::string(argv[i]) == "--netstats-dump" && i + 1 < argc) {
+            // Periodic per-peer network stats; ".json" writes JSON lines, anything else CSV
+            const char* path = argv[++i];
+            float interval = 5.0f;
+            if (i + 2 < argc && std::string(argv[i + 1]) == "--netstats-interval") {
+                interval = std::stof(argv[i + 2]);
+                i += 2;
+            }
+            NetStats::instance().setDumpPath(path, interval);
+        } else if (std::string(argv[i]) == "--netsim" && i + 1 < argc) {
+            // Simulated WAN conditions on our outgoing datagrams, e.g. "wan" or "latency=80,loss=2"
+            if (!NetSim::instance().configure(argv[++i])) return 1;
+        } else if (std::string(argv[i]) == "--world-seed" && i + 1 < argc) {
+            // Host only: clients receive the world seed when they connect
+            worldSeed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::string(argv[i]) == "--seed" && i + 1 < argc) {
+            sessionSeed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            sessionSeedGiven = true;
+        } else if (std::string(argv[i]) == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::string(argv[i]) == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::string(argv[i]) == "--headless") {
+            headless = true; // dummy video/audio drivers and a software renderer
+        } else if (std::string(argv[i]) == "--fast") {
+            fastMode = true; // no vsync: run frames as fast as they simulate
+        } else if (std::string(argv[i]) == "--tick-rate" && i + 1 < argc) {
+            // Simulation ticks per second, independent of the display refresh
+            tickRate = static_cast<uint16_t>(std::clamp(std::stoi(argv[++i]), 10, 240));
+        } else if (std::string(argv[i]) == "--jobs" && i + 1 < argc) {
+            // Job system threads besides the main thread; 0 runs every job on the main thread
+            jobWorkers = std::max(0, std::stoi(argv[++i]));
+        } else if (std::string(argv[i]) == "--trace" && i + 1 < argc) {
+            // Chrome trace of the profiler zones, written at exit (F5 writes one any time)
+            tracePath = argv[++i];
+        } else if (std::string(argv[i]) == "--alloc-budget" && i + 1 < argc) {
+            // Heap allocations allowed per frame before it is reported (STRANDED_ALLOC_TRACKING builds)
+            AllocTracker::instance().setFrameBudget(static_cast<uint64_t>(std::max(0, std::stoi(argv[++i]))));
+            if (!AllocTracker::enabled()) {
+                std::cerr << "Warning: --alloc-budget needs a build with -DSTRANDED_ALLOC_TRACKING=ON\n";
+            }
+        } else if (std::string(argv[i]) == "--pack" && i + 1 < argc) {
+            // Cooked assets (StrandedAssetCooker); anything not in the pack loads from its file
+            packPath = argv[++i];
+        } else if (std::string(argv[i]) == "--no-pack") {
+            packPath.clear();
+        }
+    }
+
+    // Replays rebuild the session from the log header and never touch the real network
+    if (!replayPath.empty()) {
+        if (!NetRecorder::instance().startReplay(replayPath, sessionSeed, worldSeed, isHost, hostAddr, tickRate)) return 1;
+        sessionSeedGiven = true;
+        if (SDLNet_Init() < 0) {
+            std::cerr << "SDLNet_Init failed: " << SDLNet_GetError() << "\n";
+            return 1;
         }
+        if (!udpSocket) udpSocket = SDLNet_UDP_Open(0); // never read or written, keeps networked code paths live
+        clientId = isHost ? 0 : INVALID_CLIENT_ID;
+    }
+
+    // One seed drives every gameplay RNG so recorded sessions replay identically
+    if (!sessionSeedGiven) sessionSeed = std::random_device{}();
+    setSessionSeed(sessionSeed);
+    srand(sessionSeed);
+    fishingMinigameRng.seed(nextRandomSeed());
+    netRng.seed(nextRandomSeed());
+    // Derived rather than drawn from the sequence so --netsim does not shift gameplay seeds
+    NetSim::instance().setSeed(sessionSeed ^ 0x4E455453u);
+    if (!isHost && udpSocket) connectNonce = static_cast<uint32_t>(netRng());
+    if (!recordPath.empty() && replayPath.empty()) {
+        NetRecorder::instance().startRecording(recordPath, sessionSeed, worldSeed, isHost, hostAddr, tickRate);
+    }
+
+    NetStats::instance().setIsHost(isHost);
+
+    PROFILE_THREAD_NAME("main");
+    JobSystem::instance().start(jobWorkers);
+    SDL_Log("Job system: %u worker threads", JobSystem::instance().getWorkerCount());
+    if (!packPath.empty() && AssetPack::instance().open(packPath)) {
+        SDL_Log("Asset pack: %s", packPath.c_str());
+    }
+
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
     }
 
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
@@ -1494,7 +1775,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 rendererFlags = headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+    if (!fastMode) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "SDL_CreateRenderer failed: " << SDL_GetError() << "\n";
         SDL_DestroyWindow(window);
@@ -1502,9 +1785,11 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     g_renderer = renderer;
+    SpriteCache::instance().preload(renderer, startupSprites());
+    warmSpawnPools(renderer);
 
     // Load navigation clock texture
-    SDL_Surface* navClockSurface = SDL_LoadBMP("./sprites/navigation_clock.bmp");
+    SDL_Surface* navClockSurface = loadSpriteSurface("./sprites/navigation_clock.bmp");
     if(navClockSurface){
         navigationClockTexture = SDL_CreateTextureFromSurface(renderer, navClockSurface);
         SDL_FreeSurface(navClockSurface);
@@ -1518,7 +1803,7 @@ int main(int argc, char* argv[]) {
     }
 
     // Load navigation indicator texture
-    SDL_Surface* navIndicatorSurface = SDL_LoadBMP("./sprites/navigation_indicator.bmp");
+    SDL_Surface* navIndicatorSurface = loadSpriteSurface("./sprites/navigation_indicator.bmp");
     if(navIndicatorSurface){
         navigationIndicatorTexture = SDL_CreateTextureFromSurface(renderer, navIndicatorSurface);
         SDL_FreeSurface(navIndicatorSurface);
@@ -1531,9 +1816,6 @@ int main(int argc, char* argv[]) {
         std::cerr << "Failed to load navigation_indicator.bmp: " << SDL_GetError() << "\n";
     }
 
-    // Seed randomness for environment variation
-    srand(static_cast<unsigned>(SDL_GetTicks()));
-
     bool running = true;
     SDL_Event event;
 
@@ -1578,55 +1860,46 @@ int main(int argc, char* argv[]) {
     
     camera->follow(player);
 
+    // World totals for the perf HUD (F4), gathered only when its text refreshes
+    PerfHud::instance().setCounterSource([] {
+        PerfCounters counters;
+        counters.gameObjects = gameObjects.size();
+        static std::vector<SDL_Texture*> textures;
+        textures.clear();
+        for (GameObject* obj : gameObjects) {
+            if (obj->asCollidable()) ++counters.colliders;
+            if (SDL_Texture* tex = obj->getSprite()) textures.push_back(tex);
+        }
+        std::sort(textures.begin(), textures.end());
+        counters.textures = static_cast<size_t>(std::unique(textures.begin(), textures.end()) - textures.begin());
+        counters.particles = ParticleSystem::countAlive();
+        for (const auto& [key, chunk] : worldChunks) {
+            if (chunk.generated) ++counters.chunks;
+        }
+        return counters;
+    });
+
         
     
-    gameObjects.push_back(player);
-    gameObjects.push_back(boat);
+    gameObjects.add(player);
+    gameObjects.add(boat);
     
     // Add remote players to game objects if they exist
     for (auto& [id, remote] : remotePlayers) {
-        gameObjects.push_back(remote);
+        gameObjects.add(remote);
     }
     
     auto ensureChunksAround = [&](SDL_Renderer* rend, Vector2 playerPos, int radius){
         int cx = static_cast<int>(std::floor(playerPos.x / CHUNK_SIZE_PX));
         int cy = static_cast<int>(std::floor(playerPos.y / CHUNK_SIZE_PX));
+        // Host and clients generate chunks independently from the shared world seed
+        std::vector<std::pair<int,int>> keys;
         for(int dy = -radius; dy <= radius; ++dy){
             for(int dx = -radius; dx <= radius; ++dx){
-                int nx = cx + dx;
-                int ny = cy + dy;
-                std::pair<int,int> key{nx, ny};
-                if(generatedChunks.find(key) != generatedChunks.end()) continue;
-                Rectangle area{{nx * static_cast<float>(CHUNK_SIZE_PX), ny * static_cast<float>(CHUNK_SIZE_PX)},
-                               {(nx+1) * static_cast<float>(CHUNK_SIZE_PX), (ny+1) * static_cast<float>(CHUNK_SIZE_PX)}};
-                // Deterministic per-chunk seed
-                uint32_t seed = static_cast<uint32_t>((nx * 73856093) ^ (ny * 19349663) ^ 0x9E3779B9);
-                // Determine biome deterministically for this chunk
-                Biome biome = sampleBiome(nx, ny, seed);
-                auto env = generateInitialEnvironment(rend, area, seed, biome);
-                // Append to global render list
-                gameObjects.insert(gameObjects.end(), env.begin(), env.end());
-                generatedChunks.insert(key);
-
-                // If host, broadcast chunk to clients
-                if (isHost && udpSocket && !clientAddrs.empty()) {
-                    ChunkPacket pkt;
-                    pkt.magic = 0x4B4E4843; // 'CHNK'
-                    pkt.cx = nx;
-                    pkt.cy = ny;
-                    pkt.seed = seed;
-                    pkt.biome = static_cast<uint8_t>(biome);
-                    UDPpacket* out = SDLNet_AllocPacket(sizeof(pkt));
-                    std::memcpy(out->data, &pkt, sizeof(pkt));
-                    out->len = sizeof(pkt);
-                    for (auto& addr : clientAddrs) {
-                        out->address = addr;
-                        SDLNet_UDP_Send(udpSocket, -1, out);
-                    }
-                    SDLNet_FreePacket(out);
-                }
+                keys.push_back({cx + dx, cy + dy});
             }
         }
+        generateChunks(rend, keys);
     };
 
     // Generate initial chunks around player
@@ -1657,136 +1930,63 @@ int main(int argc, char* argv[]) {
     UIGameObject* coin = new UIGameObject({20.0f,20.0f},{5.0f,5.0f},"./sprites/coin.bmp",renderer,LAYER_UI);
     // Create a UI text label for coin count: (pos, text, fontPath, fontSize, renderer, color, zIndex)
     Text *coinText = new Text({100.0f,35.0f}, "x0", "./fonts/font.ttf", 48, renderer, SDL_Color{0,0,0,255}, LAYER_UI);
-    gameObjects.push_back(coinText);
+    gameObjects.add(coinText);
     // expose coin text globally for the shop UI
     g_coinText = coinText;
-    gameObjects.push_back(coin);
-    gameObjects.push_back(lighthouse);
-    gameObjects.push_back(lighthouseGround);
+    gameObjects.add(coin);
+    gameObjects.add(lighthouse);
+    gameObjects.add(lighthouseGround);
     
     // Add fishing hooks to game objects
     if (player->getFishingProjectile()) {
-        gameObjects.push_back(player->getFishingProjectile());
+        gameObjects.add(player->getFishingProjectile());
     }
     for (auto& [id, remote] : remotePlayers) {
         if (remote->getFishingProjectile()) {
-            gameObjects.push_back(remote->getFishingProjectile());
+            gameObjects.add(remote->getFishingProjectile());
         }
     }
     
 
     Uint64 prev = SDL_GetPerformanceCounter();
     double freq = static_cast<double>(SDL_GetPerformanceFrequency());
-    std::set<std::pair<ICollidable*, ICollidable*>> collisionPairs; // TODO: Make this work
 
+    Uint64 loopStart = prev;
+    uint64_t ticksRun = 0; // fixed-step ticks simulated; clients overwrite the day time from DAYT
+    uint64_t frameCount = 0;
+    const double tickSeconds = 1.0 / tickRate;
+    double tickAccumulator = 0.0;
+    RenderInterpolator renderInterpolator;
+    SDL_Log("Simulation tick rate %u Hz", static_cast<unsigned>(tickRate));
+    SDL_Log("Startup: %.1f ms (%s)", (SDL_GetPerformanceCounter() - startupBegin) * 1000.0 / freq,
+            AssetPack::instance().isOpen() ? "asset pack" : "loose files");
     while (running) {
         Uint64 now = SDL_GetPerformanceCounter();
         double dt = (now - prev) / freq; // seconds since last frame
         prev = now;
-
-        // Update day/night cycle
-        g_dayTimeSeconds += static_cast<float>(dt);
-        float cyclePos = std::fmod(g_dayTimeSeconds / g_dayCycleDurationSeconds, 1.0f);
-        const float twoPi = 2.0f * 3.14159265f;
-        g_sunIntensity = 0.5f + 0.5f * std::cos(twoPi * cyclePos - 3.14159265f);
-
-
-        // Update fishing minigame state (indicator movement and timeout) EARLY so input sees the visible indicator
-        if (fishingMinigameActive) {
-            if (!navigationUIActive && !inventoryOpen) {
-                fishingMinigameTimer += static_cast<float>(dt);
-
-                // Compute screen-space rectangle for the minigame bar near the hook position
-                if (camera) {
-                    Vector2 hookWorld = fishingMinigameHookPos;
-                    Vector2 camPos = camera->getPosition();
-                    float zoom = camera->getZoom();
-                    const int barW = 200;
-                    const int barH = 20;
-                    int sx = static_cast<int>((hookWorld.x - camPos.x) * zoom) - barW/2;
-                    int sy = static_cast<int>((hookWorld.y - camPos.y) * zoom) - 48; // above hook
-                    // Clamp to window bounds
-                    sx = std::max(8, std::min(sx, WIN_WIDTH - barW - 8));
-                    sy = std::max(8, std::min(sy, WIN_HEIGHT - barH - 8));
-                    fishingMinigameScreenRect = { sx, sy, barW, barH };
-                }
-
-                if (fishingMinigameType == MINIGAME_TIMED_CLICK) {
-                    // Move indicator across 0..1, bounce at edges
-                    fishingMinigameIndicator += fishingMinigameIndicatorDir * fishingMinigameIndicatorSpeed * static_cast<float>(dt);
-                    if (fishingMinigameIndicator > 1.0f) {
-                        fishingMinigameIndicator = 1.0f;
-                        fishingMinigameIndicatorDir = -fishingMinigameIndicatorDir;
-                    } else if (fishingMinigameIndicator < 0.0f) {
-                        fishingMinigameIndicator = 0.0f;
-                        fishingMinigameIndicatorDir = -fishingMinigameIndicatorDir;
-                    }
-
-                    // Timeout: failure if not clicked within duration
-                    if (fishingMinigameTimer >= fishingMinigameDuration) {
-                        SDL_Log("Fishing minigame: timeout (failed)");
-                        SoundManager::instance().playSound("escape", 0, MIX_MAX_VOLUME);
-                        if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
-                        fishingMinigameActive = false;
-                    }
-                } else if (fishingMinigameType == MINIGAME_TUG_OF_THE_DEEP) {
-                    // Tug: fish force and occasional bursts
-                    if (tugBurstRemaining > 0.0f) {
-                        // burst is active, reduce remaining
-                        tugBurstRemaining -= static_cast<float>(dt);
-                    } else if (fishingMinigameTimer >= tugNextBurstTime) {
-                        // trigger a short burst
-                        tugBurstRemaining = 0.25f + (static_cast<float>(fishingMinigameRng()%20) / 100.0f); // 0.25 - 0.45s
-                        tugNextBurstTime = fishingMinigameTimer + (0.8f + (static_cast<float>(fishingMinigameRng()%120) / 100.0f));
-                    }
-                    float activeFishForce = tugFishForce + (tugBurstRemaining > 0.0f ? 0.18f : 0.0f);
-
-                    // Apply fish force to progress
-                    tugProgress += activeFishForce * static_cast<float>(dt);
-
-                    // Decay player's pull level over time
-                    tugPlayerPullLevel = std::max(0.0f, tugPlayerPullLevel - static_cast<float>(dt) * 0.6f);
-
-                    // Recover stamina slowly
-                    if (tugLastPullTime + 1.0f < fishingMinigameTimer) {
-                        tugStamina = std::min(3, tugStamina + 1);
-                        tugLastPullTime = fishingMinigameTimer; // throttle recovery increment once
-                    }
-
-                    // Compute tension; when fish force exceeds player's pull, tension increases
-                    float tensionDelta = activeFishForce - tugPlayerPullLevel;
-                    tugTension += std::max(0.0f, tensionDelta) * 0.8f * static_cast<float>(dt);
-                    tugTension = std::clamp(tugTension, 0.0f, 1.0f);
-
-                    // Win/lose checks
-                    if (tugProgress <= TUG_WIN_THRESHOLD) {
-                        SDL_Log("Fishing minigame: TUG success! progress=%.3f", tugProgress);
-                        // success will be handled where clicks are processed (spawn fish below)
-                        // to keep consistent, set minigame inactive and spawn fish here
-                        SoundManager::instance().playSound("catch", 0, MIX_MAX_VOLUME);
-                        if (g_renderer) {
-                            GameObject* caught = new GameObject(fishingMinigameHookPos, {2.0f,2.0f}, "./sprites/fish.bmp", g_renderer, LAYER_PARTICLE);
-                            gameObjects.push_back(caught);
-                            fishesMovingToPlayer.push_back(caught);
-                            SDL_Log("Caught fish spawned at (%.2f,%.2f) and marked for collection", fishingMinigameHookPos.x, fishingMinigameHookPos.y);
-                        }
-                        if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
-                        fishingMinigameActive = false;
-                    } else if (tugProgress >= TUG_FAIL_THRESHOLD || tugTension >= 1.0f) {
-                        SDL_Log("Fishing minigame: TUG failed. progress=%.3f tension=%.3f", tugProgress, tugTension);
-                        SoundManager::instance().playSound("escape", 0, MIX_MAX_VOLUME);
-                        if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
-                        fishingMinigameActive = false;
-                    }
-                }
-            }
-        }
-
-        while (SDL_PollEvent(&event)) {
+        // Recording logs dt; replay substitutes the recorded dt and ends with the log
+        if (!NetRecorder::instance().beginFrame(dt)) break;
+        ++frameCount;
+        PROFILE_ZONE("frame");
+        PerfHud::instance().beginFrame(dt);
+        AllocTracker::instance().beginFrame();
+
+        PERF_ZONE_NAMED(inputZone, "input polling", PerfSection::Input);
+        while (NetRecorder::instance().pollEvent(event)) {
             if (event.type == SDL_QUIT) {
                 running = false;
             } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
                 running = false;
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+                netStatsOverlayVisible = !netStatsOverlayVisible;
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F4 && !event.key.repeat) {
+                PerfHud::instance().toggle();
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F5 && !event.key.repeat) {
+#ifdef STRANDED_PROFILE
+                Profiler::instance().writeChromeTrace("trace-" + std::to_string(frameCount) + ".json");
+#else
+                SDL_Log("Profiler zones are compiled out of this build (STRANDED_PROFILER)");
+#endif
             }
             else if (event.type == SDL_MOUSEBUTTONDOWN) {
                 // If the lighthouse shop is open, handle shop clicks and consume the event
@@ -1878,9 +2078,8 @@ int main(int argc, char* argv[]) {
                             SDL_Log("Fishing minigame: Success! indicator=%.3f window=(%.3f-%.3f)", fishingMinigameIndicator, fishingMinigameWindowStart, fishingMinigameWindowEnd);
                             SoundManager::instance().playSound("catch", 0, MIX_MAX_VOLUME);
                             if (g_renderer) {
-                                GameObject* caught = new GameObject(fishingMinigameHookPos, {2.0f,2.0f}, "./sprites/fish.bmp", g_renderer, LAYER_PARTICLE);
-                                gameObjects.push_back(caught);
-                                fishesMovingToPlayer.push_back(caught);
+                                GameObject* caught = new CaughtFish(fishingMinigameHookPos, g_renderer);
+                                fishesMovingToPlayer.push_back(gameObjects.add(caught));
                                 SDL_Log("Caught fish spawned at (%.2f,%.2f) and marked for collection", fishingMinigameHookPos.x, fishingMinigameHookPos.y);
                             }
                         } else {
@@ -1919,9 +2118,8 @@ int main(int argc, char* argv[]) {
                             SDL_Log("Fishing minigame: TUG success! progress=%.3f", tugProgress);
                             SoundManager::instance().playSound("catch", 0, MIX_MAX_VOLUME);
                             if (g_renderer) {
-                                GameObject* caught = new GameObject(fishingMinigameHookPos, {2.0f,2.0f}, "./sprites/fish.bmp", g_renderer, LAYER_PARTICLE);
-                                gameObjects.push_back(caught);
-                                fishesMovingToPlayer.push_back(caught);
+                                GameObject* caught = new CaughtFish(fishingMinigameHookPos, g_renderer);
+                                fishesMovingToPlayer.push_back(gameObjects.add(caught));
                                 SDL_Log("Caught fish spawned at (%.2f,%.2f) and marked for collection", fishingMinigameHookPos.x, fishingMinigameHookPos.y);
                             }
                             if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
@@ -1993,54 +2191,52 @@ int main(int argc, char* argv[]) {
                 }
 
                 // Only local player handles local input
-                for(GameObject* obj: gameObjects){
-                    if(IInteractable* interactable = dynamic_cast<IInteractable*>(obj)){
-                        if(interactable->getInteractKeys().find(event.key.keysym.sym) != interactable->getInteractKeys().end()){
-
-                            // Check if this key wasn't already pressed (prevent key repeat)
-                            if(pressedInteractKeys.find(event.key.keysym.sym) == pressedInteractKeys.end()){
-                                // Check if the interactable is also collidable
-                                ICollidable* interactableCollider = dynamic_cast<ICollidable*>(interactable);
-                                ICollidable* playerCollider = dynamic_cast<ICollidable*>(player);
-                                
-                                if(interactableCollider && playerCollider){
-                                    auto shapeA = interactableCollider->getCollisionBox();
-                                    auto shapeB = playerCollider->getCollisionBox();
-
-                                    // Compute distance and positions for proximity test
-                                    float dist = hitBoxDistance(shapeA, shapeB);
-                                    Vector2 ppos = player->getWorldPosition();
-                                    Vector2 opos = interactable->getWorldPosition();
-
-                                    if (dist < 10.0f) { // Simple distance check for proximity
-                                        // Mark the key as pressed now that we're handling an interaction
-                                        pressedInteractKeys.insert(event.key.keysym.sym);
-
-                                        // Handle B key for boarding/leaving boat
-                                        if(event.key.keysym.sym == SDLK_b){
-                                            if (isHost) {
-                                                // Host handles it directly
-                                                if(boat->isPlayerOnBoard(player)){
-                                                    boat->leaveBoat(player);
-                                                } else {
-                                                    boat->boardBoat(player);
-                                                }
-                                            } else {
-                                                // Client sends request to server
-                                                clientBoardingRequest = true;
-                                            }
-                                        } else if(event.key.keysym.sym == SDLK_e && dynamic_cast<Boat*>(interactable)){
-                                            // Handle E key for boat movement
-                                            if (isHost) {
-                                                interactable->onInteract(event.key.keysym.sym);
+                for(IInteractable* interactable : IInteractable::all()){
+                    if(interactable->getInteractKeys().find(event.key.keysym.sym) != interactable->getInteractKeys().end()){
+
+                        // Check if this key wasn't already pressed (prevent key repeat)
+                        if(pressedInteractKeys.find(event.key.keysym.sym) == pressedInteractKeys.end()){
+                            // Interactables are collidable; compare hitboxes for the proximity test
+                            ICollidable* interactableCollider = interactable;
+                            ICollidable* playerCollider = player;
+                            
+                            if(interactableCollider && playerCollider){
+                                auto shapeA = interactableCollider->getCollisionBox();
+                                auto shapeB = playerCollider->getCollisionBox();
+
+                                // Compute distance and positions for proximity test
+                                float dist = hitBoxDistance(shapeA, shapeB);
+                                Vector2 ppos = player->getWorldPosition();
+                                Vector2 opos = interactable->getWorldPosition();
+
+                                if (dist < 10.0f) { // Simple distance check for proximity
+                                    // Mark the key as pressed now that we're handling an interaction
+                                    pressedInteractKeys.insert(event.key.keysym.sym);
+
+                                    // Handle B key for boarding/leaving boat
+                                    if(event.key.keysym.sym == SDLK_b){
+                                        if (isHost) {
+                                            // Host handles it directly
+                                            if(boat->isPlayerOnBoard(player)){
+                                                boat->leaveBoat(player);
                                             } else {
-                                                // Client sends request to server
-                                                clientBoatMovementToggle = true;
+                                                boat->boardBoat(player);
                                             }
                                         } else {
-                                            SDL_Log("Interacting with object using key: %s", SDL_GetKeyName(event.key.keysym.sym));
+                                            // Client sends request to server
+                                            clientBoardingRequest = true;
+                                        }
+                                    } else if(event.key.keysym.sym == SDLK_e && interactable == boat){
+                                        // Handle E key for boat movement
+                                        if (isHost) {
                                             interactable->onInteract(event.key.keysym.sym);
+                                        } else {
+                                            // Client sends request to server
+                                            clientBoatMovementToggle = true;
                                         }
+                                    } else {
+                                        SDL_Log("Interacting with object using key: %s", SDL_GetKeyName(event.key.keysym.sym));
+                                        interactable->onInteract(event.key.keysym.sym);
                                     }
                                 }
                             }
@@ -2082,464 +2278,508 @@ int main(int argc, char* argv[]) {
             }
         }
         
-        // Network: client sends input, host receives
-        if (!isHost && udpSocket) {
-            sendInputPacket();
-        }
-        if (isHost && udpSocket) {
-            receiveInputs();
-        }
-        
-        // Sync remote players and receive chunk spawns from host
-        if (!isHost && udpSocket) {
-            // Modified to process both snapshots and chunk packets
-            UDPpacket* in = SDLNet_AllocPacket(2048);
-            while (SDLNet_UDP_Recv(udpSocket, in)) {
-                // Check for compact particle seed packet first
-                if (in->len >= sizeof(ParticlePacket)) {
-                    ParticlePacket pp;
-                    std::memcpy(&pp, in->data, sizeof(ParticlePacket));
-                    if (pp.magic == 0x54524150) { // 'PART'
-                        Player* targetPlayer = nullptr;
-                        if (pp.ownerId == clientId) {
-                            targetPlayer = player;
-                        } else {
-                            targetPlayer = getOrCreateRemotePlayer(pp.ownerId);
+        // Held keys / mouse position after this frame's events (recorded for replays)
+        NetRecorder::instance().captureInputState();
+        inputZone.end();
+
+        // Fixed-step simulation: the frame's time is spent in whole ticks and the
+        // remainder carries over; rendering blends the last two ticks by that remainder
+        tickAccumulator += std::min(dt, MAX_FRAME_SECONDS);
+        int ticksThisFrame = 0;
+        while (tickAccumulator >= tickSeconds && ticksThisFrame < MAX_TICKS_PER_FRAME) {
+            tickAccumulator -= tickSeconds;
+            ++ticksThisFrame;
+            ++ticksRun;
+            const double dt = tickSeconds;
+            PROFILE_ZONE("tick");
+            renderInterpolator.capture(gameObjects.objects());
+
+            // Update day/night cycle
+            g_dayTimeSeconds += static_cast<float>(dt);
+            float cyclePos = std::fmod(g_dayTimeSeconds / g_dayCycleDurationSeconds, 1.0f);
+            const float twoPi = 2.0f * 3.14159265f;
+            g_sunIntensity = 0.5f + 0.5f * std::cos(twoPi * cyclePos - 3.14159265f);
+
+
+            // Update fishing minigame state (indicator movement and timeout); clicks are handled
+            // before the tick so they are judged against the indicator that was on screen
+            if (fishingMinigameActive) {
+                if (!navigationUIActive && !inventoryOpen) {
+                    fishingMinigameTimer += static_cast<float>(dt);
+
+                    // Compute screen-space rectangle for the minigame bar near the hook position
+                    if (camera) {
+                        Vector2 hookWorld = fishingMinigameHookPos;
+                        Vector2 camPos = camera->getPosition();
+                        float zoom = camera->getZoom();
+                        const int barW = 200;
+                        const int barH = 20;
+                        int sx = static_cast<int>((hookWorld.x - camPos.x) * zoom) - barW/2;
+                        int sy = static_cast<int>((hookWorld.y - camPos.y) * zoom) - 48; // above hook
+                        // Clamp to window bounds
+                        sx = std::max(8, std::min(sx, WIN_WIDTH - barW - 8));
+                        sy = std::max(8, std::min(sy, WIN_HEIGHT - barH - 8));
+                        fishingMinigameScreenRect = { sx, sy, barW, barH };
+                    }
+
+                    if (fishingMinigameType == MINIGAME_TIMED_CLICK) {
+                        // Move indicator across 0..1, bounce at edges
+                        fishingMinigameIndicator += fishingMinigameIndicatorDir * fishingMinigameIndicatorSpeed * static_cast<float>(dt);
+                        if (fishingMinigameIndicator > 1.0f) {
+                            fishingMinigameIndicator = 1.0f;
+                            fishingMinigameIndicatorDir = -fishingMinigameIndicatorDir;
+                        } else if (fishingMinigameIndicator < 0.0f) {
+                            fishingMinigameIndicator = 0.0f;
+                            fishingMinigameIndicatorDir = -fishingMinigameIndicatorDir;
+                        }
+
+                        // Timeout: failure if not clicked within duration
+                        if (fishingMinigameTimer >= fishingMinigameDuration) {
+                            SDL_Log("Fishing minigame: timeout (failed)");
+                            SoundManager::instance().playSound("escape", 0, MIX_MAX_VOLUME);
+                            if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
+                            fishingMinigameActive = false;
                         }
-                        if (targetPlayer && targetPlayer->getFishingProjectile()) {
-                            SDL_Color col{pp.r, pp.g, pp.b, pp.a};
-                            bool playSound = (pp.ownerId == clientId);
-                            Vector2 center{pp.startX, pp.startY};
-                            targetPlayer->getFishingProjectile()->cancelPendingAttract();
-                            // Use seed-based scheduling so clients reproduce positions locally
-                            targetPlayer->getFishingProjectile()->scheduleAttractFromSeed(pp.seed, pp.count, col, pp.duration, pp.zIndex, pp.spread, center, true, playSound, pp.delay);
+                    } else if (fishingMinigameType == MINIGAME_TUG_OF_THE_DEEP) {
+                        // Tug: fish force and occasional bursts
+                        if (tugBurstRemaining > 0.0f) {
+                            // burst is active, reduce remaining
+                            tugBurstRemaining -= static_cast<float>(dt);
+                        } else if (fishingMinigameTimer >= tugNextBurstTime) {
+                            // trigger a short burst
+                            tugBurstRemaining = 0.25f + (static_cast<float>(fishingMinigameRng()%20) / 100.0f); // 0.25 - 0.45s
+                            tugNextBurstTime = fishingMinigameTimer + (0.8f + (static_cast<float>(fishingMinigameRng()%120) / 100.0f));
                         }
-                        continue; // processed
-                    }
-                }
+                        float activeFishForce = tugFishForce + (tugBurstRemaining > 0.0f ? 0.18f : 0.0f);
 
-                // Check for hook arrival packet
-                if (in->len >= sizeof(HookArrivalPacket)) {
-                    HookArrivalPacket hp;
-                    std::memcpy(&hp, in->data, sizeof(HookArrivalPacket));
-                    if (hp.magic == 0x52414B48) { // 'HKAR'
-                        Player* targetPlayer = nullptr;
-                        if (hp.ownerId == clientId) {
-                            targetPlayer = player;
-                        } else {
-                            targetPlayer = getOrCreateRemotePlayer(hp.ownerId);
+                        // Apply fish force to progress
+                        tugProgress += activeFishForce * static_cast<float>(dt);
+
+                        // Decay player's pull level over time
+                        tugPlayerPullLevel = std::max(0.0f, tugPlayerPullLevel - static_cast<float>(dt) * 0.6f);
+
+                        // Recover stamina slowly
+                        if (tugLastPullTime + 1.0f < fishingMinigameTimer) {
+                            tugStamina = std::min(3, tugStamina + 1);
+                            tugLastPullTime = fishingMinigameTimer; // throttle recovery increment once
                         }
-                        if (targetPlayer && targetPlayer->getFishingProjectile()) {
-                            Vector2 pos{hp.x, hp.y};
-                            // Authoritative set: apply arrived position immediately
-                            targetPlayer->getFishingProjectile()->setArrivedAt(pos);
+
+                        // Compute tension; when fish force exceeds player's pull, tension increases
+                        float tensionDelta = activeFishForce - tugPlayerPullLevel;
+                        tugTension += std::max(0.0f, tensionDelta) * 0.8f * static_cast<float>(dt);
+                        tugTension = std::clamp(tugTension, 0.0f, 1.0f);
+
+                        // Win/lose checks
+                        if (tugProgress <= TUG_WIN_THRESHOLD) {
+                            SDL_Log("Fishing minigame: TUG success! progress=%.3f", tugProgress);
+                            // success will be handled where clicks are processed (spawn fish below)
+                            // to keep consistent, set minigame inactive and spawn fish here
+                            SoundManager::instance().playSound("catch", 0, MIX_MAX_VOLUME);
+                            if (g_renderer) {
+                                GameObject* caught = new CaughtFish(fishingMinigameHookPos, g_renderer);
+                                fishesMovingToPlayer.push_back(gameObjects.add(caught));
+                                SDL_Log("Caught fish spawned at (%.2f,%.2f) and marked for collection", fishingMinigameHookPos.x, fishingMinigameHookPos.y);
+                            }
+                            if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
+                            fishingMinigameActive = false;
+                        } else if (tugProgress >= TUG_FAIL_THRESHOLD || tugTension >= 1.0f) {
+                            SDL_Log("Fishing minigame: TUG failed. progress=%.3f tension=%.3f", tugProgress, tugTension);
+                            SoundManager::instance().playSound("escape", 0, MIX_MAX_VOLUME);
+                            if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
+                            fishingMinigameActive = false;
                         }
-                        continue; // processed
                     }
                 }
+            }
 
-                // Check for AttackingFish spawn packet
-                if (in->len >= sizeof(AttackingFishSpawnPacket)) {
-                    AttackingFishSpawnPacket ap;
-                    std::memcpy(&ap, in->data, sizeof(AttackingFishSpawnPacket));
-                    if (ap.magic == 0x50534641) { // 'AFSP'
-                        Vector2 spawn{ap.x, ap.y};
-                        // If we already have a local AttackingFish near this position (e.g. client-spawned), adopt the authoritative ids
-                        bool adopted = false;
-                        for (GameObject* obj : gameObjects) {
-                            AttackingFish* afc = dynamic_cast<AttackingFish*>(obj);
-                            if (!afc) continue;
-                            Vector2 afPos = afc->getWorldPosition();
-                            float dx = afPos.x - ap.x;
-                            float dy = afPos.y - ap.y;
-                            if (dx*dx + dy*dy < 16.0f * 16.0f) {
-                                afc->adoptSpawn(ap.entityId, ap.ownerId);
-                                SDL_Log("Client: Adopted existing AttackingFish for eid=%u owner=%u at (%.2f,%.2f)", ap.entityId, ap.ownerId, ap.x, ap.y);
-                                adopted = true;
-                                break;
+            // Network: client sends input, host receives
+            if (!isHost && udpSocket) {
+                sendInputPacket();
+            }
+            if (isHost && udpSocket) {
+                hostClockSeconds += dt;
+                PERF_ZONE("host receive", PerfSection::Network);
+                receiveInputs();
+                hostApplyBufferedInputs(static_cast<float>(dt));
+            }
+            if (isHost && udpSocket) {
+                hostUpdatePeers(static_cast<float>(dt));
+            }
+            if (!isHost && udpSocket) {
+                clientUpdateConnection(static_cast<float>(dt));
+            }
+            if (udpSocket) {
+                sendNetPings(static_cast<float>(dt));
+                NetStats::instance().update(static_cast<float>(dt));
+            }
+        
+            // Sync remote players and receive chunk spawns from host
+            if (!isHost && udpSocket) {
+                PERF_ZONE("client receive", PerfSection::Network);
+                // Modified to process both snapshots and chunk packets
+                UDPpacket* in = netRecvPacket();
+                while (netRecv(udpSocket, in)) {
+                    // Only the host talks to us; anything it sends counts as a keepalive
+                    if (in->address.host != hostAddr.host || in->address.port != hostAddr.port) continue;
+                    hostSilenceSeconds = 0.0f;
+                    if (handleClientConnectionPacket(in)) continue;
+
+                    // Latency probes (host pings us, and answers ours)
+                    if (handlePingPong(in)) continue;
+
+                    // Check for compact particle seed packet
+                    if (in->len >= sizeof(ParticlePacket)) {
+                        ParticlePacket pp;
+                        std::memcpy(&pp, in->data, sizeof(ParticlePacket));
+                        if (pp.magic == 0x54524150) { // 'PART'
+                            Player* targetPlayer = nullptr;
+                            if (pp.ownerId == clientId) {
+                                targetPlayer = player;
+                            } else {
+                                targetPlayer = getOrCreateRemotePlayer(pp.ownerId);
                             }
+                            if (targetPlayer && targetPlayer->getFishingProjectile()) {
+                                SDL_Color col{pp.r, pp.g, pp.b, pp.a};
+                                bool playSound = (pp.ownerId == clientId);
+                                Vector2 center{pp.startX, pp.startY};
+                                targetPlayer->getFishingProjectile()->cancelPendingAttract();
+                                // Use seed-based scheduling so clients reproduce positions locally
+                                targetPlayer->getFishingProjectile()->scheduleAttractFromSeed(pp.seed, pp.count, col, pp.duration, pp.zIndex, pp.spread, center, true, playSound, pp.delay);
+                            }
+                            continue; // processed
                         }
-                        if (!adopted) {
-                            AttackingFish* af = new AttackingFish(spawn, g_renderer, ap.entityId, ap.ownerId);
-                            gameObjects.push_back(af);
-                            SDL_Log("Client: Received AttackingFish spawn eid=%u owner=%u at (%.2f,%.2f)", ap.entityId, ap.ownerId, ap.x, ap.y);
-                        }
+                    }
 
-                        // If this attacking fish was chosen by the host for our hook, cancel any local minigame and retract the hook
-                        if (ap.ownerId == clientId && fishingMinigameActive) {
-                            SDL_Log("Client: AttackingFish chosen by host for our hook; cancelling local minigame and retracting hook.");
-                            fishingMinigameActive = false;
-                            if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
+                    // Check for hook arrival packet
+                    if (in->len >= sizeof(HookArrivalPacket)) {
+                        HookArrivalPacket hp;
+                        std::memcpy(&hp, in->data, sizeof(HookArrivalPacket));
+                        if (hp.magic == 0x52414B48) { // 'HKAR'
+                            Player* targetPlayer = nullptr;
+                            if (hp.ownerId == clientId) {
+                                targetPlayer = player;
+                            } else {
+                                targetPlayer = getOrCreateRemotePlayer(hp.ownerId);
+                            }
+                            if (targetPlayer && targetPlayer->getFishingProjectile()) {
+                                Vector2 pos{hp.x, hp.y};
+                                // Authoritative set: apply arrived position immediately
+                                targetPlayer->getFishingProjectile()->setArrivedAt(pos);
+                            }
+                            continue; // processed
                         }
-                        continue; // processed
                     }
-                }
 
-                // Check for daytime packet
-                if (in->len >= sizeof(DaytimePacket)) {
-                    DaytimePacket d;
-                    std::memcpy(&d, in->data, sizeof(DaytimePacket));
-                    if (d.magic == 0x54415944) { // 'DAYT'
-                        // Apply the host's day/time values; wrap dayTime into local cycle
-                        g_dayCycleDurationSeconds = d.cycleDurationSeconds > 0.1f ? d.cycleDurationSeconds : g_dayCycleDurationSeconds;
-                        g_dayTimeSeconds = std::fmod(d.dayTimeSeconds, g_dayCycleDurationSeconds);
-                        // Immediately compute sun intensity so there's no visual jump
-                        float cyclePos = std::fmod(g_dayTimeSeconds / g_dayCycleDurationSeconds, 1.0f);
-                        const float twoPi = 2.0f * 3.14159265f;
-                        g_sunIntensity = 0.5f + 0.5f * std::cos(twoPi * cyclePos - 3.14159265f);
-                        SDL_Log("Client: Received daytime sync: time=%.2f cycle=%.2f intensity=%.3f", g_dayTimeSeconds, g_dayCycleDurationSeconds, g_sunIntensity);
-                        continue; // processed
+                    // Check for AttackingFish spawn packet
+                    if (in->len >= sizeof(AttackingFishSpawnPacket)) {
+                        AttackingFishSpawnPacket ap;
+                        std::memcpy(&ap, in->data, sizeof(AttackingFishSpawnPacket));
+                        if (ap.magic == 0x50534641) { // 'AFSP'
+                            Vector2 spawn{ap.x, ap.y};
+                            // If we already have a local AttackingFish near this position (e.g. client-spawned), adopt the authoritative ids
+                            bool adopted = false;
+                            for (AttackingFish* afc : AttackingFish::all()) {
+                                Vector2 afPos = afc->getWorldPosition();
+                                float dx = afPos.x - ap.x;
+                                float dy = afPos.y - ap.y;
+                                if (dx*dx + dy*dy < 16.0f * 16.0f) {
+                                    afc->adoptSpawn(ap.entityId, ap.ownerId);
+                                    SDL_Log("Client: Adopted existing AttackingFish for eid=%u owner=%u at (%.2f,%.2f)", ap.entityId, ap.ownerId, ap.x, ap.y);
+                                    adopted = true;
+                                    break;
+                                }
+                            }
+                            if (!adopted) {
+                                AttackingFish* af = new AttackingFish(spawn, g_renderer, ap.entityId, ap.ownerId);
+                                gameObjects.add(af);
+                                SDL_Log("Client: Received AttackingFish spawn eid=%u owner=%u at (%.2f,%.2f)", ap.entityId, ap.ownerId, ap.x, ap.y);
+                            }
+
+                            // If this attacking fish was chosen by the host for our hook, cancel any local minigame and retract the hook
+                            if (ap.ownerId == clientId && fishingMinigameActive) {
+                                SDL_Log("Client: AttackingFish chosen by host for our hook; cancelling local minigame and retracting hook.");
+                                fishingMinigameActive = false;
+                                if (player && player->getFishingProjectile()) player->getFishingProjectile()->retract();
+                            }
+                            continue; // processed
+                        }
                     }
-                }
 
-                // Check for fish projectile spawn packet
-                if (in->len >= sizeof(FishProjectileSpawnPacket)) {
-                    FishProjectileSpawnPacket fpkt;
-                    std::memcpy(&fpkt, in->data, sizeof(FishProjectileSpawnPacket));
-                    if (fpkt.magic == 0x4A525046) { // 'FPRJ'
-                        // Find target player by id
-                        Player* targetPlayer = nullptr;
-                        if (fpkt.targetPlayerId == clientId) targetPlayer = player;
-                        else targetPlayer = getOrCreateRemotePlayer(fpkt.targetPlayerId);
-                        Vector2 start{fpkt.startX, fpkt.startY};
-                        // Create projectile locally to match host spawn
-                        FishProjectile* fpr = new FishProjectile(start, {1.0f,1.0f}, "./sprites/FishProjectile.bmp", g_renderer, LAYER_PARTICLE);
-                        if (targetPlayer) fpr->fire(start, targetPlayer);
-                        else {
-                            // If target missing, fire toward start (will expire)
-                            fpr->fire(start, player);
+                    // Check for daytime packet
+                    if (in->len >= sizeof(DaytimePacket)) {
+                        DaytimePacket d;
+                        std::memcpy(&d, in->data, sizeof(DaytimePacket));
+                        if (d.magic == 0x54415944) { // 'DAYT'
+                            // Apply the host's day/time values; wrap dayTime into local cycle
+                            g_dayCycleDurationSeconds = d.cycleDurationSeconds > 0.1f ? d.cycleDurationSeconds : g_dayCycleDurationSeconds;
+                            g_dayTimeSeconds = std::fmod(d.dayTimeSeconds, g_dayCycleDurationSeconds);
+                            // Immediately compute sun intensity so there's no visual jump
+                            float cyclePos = std::fmod(g_dayTimeSeconds / g_dayCycleDurationSeconds, 1.0f);
+                            const float twoPi = 2.0f * 3.14159265f;
+                            g_sunIntensity = 0.5f + 0.5f * std::cos(twoPi * cyclePos - 3.14159265f);
+                            SDL_Log("Client: Received daytime sync: time=%.2f cycle=%.2f intensity=%.3f", g_dayTimeSeconds, g_dayCycleDurationSeconds, g_sunIntensity);
+                            continue; // processed
                         }
-                        gameObjects.push_back(fpr);
-                        SDL_Log("Client: Received FishProjectile spawn pid=%u owner=%u start=(%.2f,%.2f) targetPid=%u", fpkt.projectileId, fpkt.ownerEntityId, fpkt.startX, fpkt.startY, fpkt.targetPlayerId);
-                        continue; // processed
                     }
-                }
 
-                // Check for chunk packet first
-                if (in->len >= sizeof(ChunkPacket)) {
-                    ChunkPacket cp;
-                    std::memcpy(&cp, in->data, sizeof(ChunkPacket));
-                    if (cp.magic == 0x4B4E4843) { // 'CHNK'
-                        std::pair<int,int> key{cp.cx, cp.cy};
-                        if (generatedChunks.find(key) == generatedChunks.end()) {
-                            Rectangle area{{cp.cx * static_cast<float>(CHUNK_SIZE_PX), cp.cy * static_cast<float>(CHUNK_SIZE_PX)},
-                                           {(cp.cx+1) * static_cast<float>(CHUNK_SIZE_PX), (cp.cy+1) * static_cast<float>(CHUNK_SIZE_PX)}};
-                            Biome biome = static_cast<Biome>(cp.biome);
-                            auto env = generateInitialEnvironment(renderer, area, cp.seed, biome);
-                            gameObjects.insert(gameObjects.end(), env.begin(), env.end());
-                            generatedChunks.insert(key);
+                    // Check for fish projectile spawn packet
+                    if (in->len >= sizeof(FishProjectileSpawnPacket)) {
+                        FishProjectileSpawnPacket fpkt;
+                        std::memcpy(&fpkt, in->data, sizeof(FishProjectileSpawnPacket));
+                        if (fpkt.magic == 0x4A525046) { // 'FPRJ'
+                            // Find target player by id
+                            Player* targetPlayer = nullptr;
+                            if (fpkt.targetPlayerId == clientId) targetPlayer = player;
+                            else targetPlayer = getOrCreateRemotePlayer(fpkt.targetPlayerId);
+                            Vector2 start{fpkt.startX, fpkt.startY};
+                            // Create projectile locally to match host spawn
+                            FishProjectile* fpr = new FishProjectile(start, {1.0f,1.0f}, "./sprites/FishProjectile.bmp", g_renderer, LAYER_PARTICLE);
+                            if (targetPlayer) fpr->fire(start, targetPlayer);
+                            else {
+                                // If target missing, fire toward start (will expire)
+                                fpr->fire(start, player);
+                            }
+                            gameObjects.add(fpr);
+                            SDL_Log("Client: Received FishProjectile spawn pid=%u owner=%u start=(%.2f,%.2f) targetPid=%u", fpkt.projectileId, fpkt.ownerEntityId, fpkt.startX, fpkt.startY, fpkt.targetPlayerId);
+                            continue; // processed
                         }
-                        continue; // processed
                     }
-                }
 
-                // Otherwise try to interpret as snapshot
-                if (in->len >= sizeof(SnapshotHeader)) {
-                    SnapshotHeader header;
-                    std::memcpy(&header, in->data, sizeof(header));
-                    
-                    size_t offset = sizeof(header);
+                    // Snapshot part: each one is self-contained, apply it unless a newer tick already arrived
+                    static SnapshotPart snapshotPart;
+                    if (parseSnapshotPart(in->data, static_cast<size_t>(in->len), snapshotPart)) {
+                        PROFILE_ZONE("snapshot");
+                        const SnapshotHeader& header = snapshotPart.header;
+                        if (!snapshotTicks.accept(header.tick)) continue; // stale
+                        if (header.partIndex == 0) NetStats::instance().onSequence(in->address, header.tick);
                     
-                    // Read boat state if present
-                    if (header.hasBoat && in->len >= offset + sizeof(BoatState)) {
-                        BoatState boatState;
-                        std::memcpy(&boatState, in->data + offset, sizeof(boatState));
-                        boat->setBoatState(boatState.x, boatState.y, boatState.rotation, 
-                                          boatState.navDirX, boatState.navDirY, boatState.isMoving != 0);
-                        offset += sizeof(BoatState);
-                    }
+                        // Boat state rides in part 0
+                        if (header.hasBoat) {
+                            const BoatState& boatState = snapshotPart.boat;
+                            boat->setBoatState(boatState.x, boatState.y, boatState.rotation, 
+                                              boatState.navDirX, boatState.navDirY, boatState.isMoving != 0);
+                        }
                     
-                    size_t expected = offset + header.playerCount * sizeof(PlayerState);
-                    if (in->len >= expected) {
-                        PlayerState* states = reinterpret_cast<PlayerState*>(in->data + offset);
-                        for (uint32_t i = 0; i < header.playerCount; ++i) {
-                            if (states[i].id == clientId) {
-                                // Handle boarding state first
-                                bool wasOnBoat = boat->isPlayerOnBoard(player);
-                                bool shouldBeOnBoat = states[i].isOnBoat != 0;
+                        {
+                            const PlayerState* states = snapshotPart.players.data();
+                            for (uint32_t i = 0; i < header.playerCount; ++i) {
+                                if (states[i].id == clientId) {
+                                    // Handle boarding state first
+                                    bool wasOnBoat = boat->isPlayerOnBoard(player);
+                                    bool shouldBeOnBoat = states[i].isOnBoat != 0;
                                 
-                                // Handle boarding/leaving transitions
-                                if (shouldBeOnBoat && !wasOnBoat) {
-                                    // Need to board - use world position, boardBoat will convert to local
-                                    Vector2* pos = player->getPosition();
-                                    pos->x = states[i].x;
-                                    pos->y = states[i].y;
-                                    boat->boardBoat(player);
-                                } else if (!shouldBeOnBoat && wasOnBoat) {
-                                    // Need to leave - leaveBoat will convert to world position
-                                    boat->leaveBoat(player);
-                                    Vector2* pos = player->getPosition();
-                                    pos->x = states[i].x;
-                                    pos->y = states[i].y;
-                                } else {
-                                    // No state change, just update position
-                                    Vector2* pos = player->getPosition();
-                                    if (shouldBeOnBoat) {
-                                        // On boat - server sends world pos, convert to local
-                                        Vector2 boatWorld = boat->getWorldPosition();
-                                        pos->x = states[i].x - boatWorld.x;
-                                        pos->y = states[i].y - boatWorld.y;
+                                    // Handle boarding/leaving transitions
+                                    if (shouldBeOnBoat && !wasOnBoat) {
+                                        // Need to board - use world position, boardBoat will convert to local
+                                        player->setPosition({states[i].x, states[i].y});
+                                        boat->boardBoat(player);
+                                    } else if (!shouldBeOnBoat && wasOnBoat) {
+                                        // Need to leave - leaveBoat will convert to world position
+                                        boat->leaveBoat(player);
+                                        player->setPosition({states[i].x, states[i].y});
                                     } else {
-                                        // Not on boat - server sends world pos, use directly
-                                        pos->x = states[i].x;
-                                        pos->y = states[i].y;
+                                        // No state change, just update position
+                                        if (shouldBeOnBoat) {
+                                            // On boat - server sends world pos, convert to local
+                                            player->setPosition(player->worldToLocal({states[i].x, states[i].y}));
+                                        } else {
+                                            // Not on boat - server sends world pos, use directly
+                                            player->setPosition({states[i].x, states[i].y});
+                                        }
                                     }
-                                }
                                 
-                                player->setVelocity({states[i].vx, states[i].vy});
-                                player->setRodVisible(states[i].isHooking != 0);
-                                // Sync health from authoritative host
-                                player->setHp(states[i].hp);
-                                player->setMaxHp(states[i].maxHp);
-                                // Do NOT sync local player's fishing hook from network snapshot (client should control its own hook) 
-                            } else {
-                                Player* remote = getOrCreateRemotePlayer(states[i].id);
-                                if (!remote) continue;
+                                    player->setVelocity({states[i].vx, states[i].vy});
+                                    player->setRodVisible(states[i].isHooking != 0);
+                                    // Sync health from authoritative host
+                                    player->setHp(states[i].hp);
+                                    player->setMaxHp(states[i].maxHp);
+                                    // Do NOT sync local player's fishing hook from network snapshot (client should control its own hook) 
+                                } else {
+                                    Player* remote = getOrCreateRemotePlayer(states[i].id);
+                                    if (!remote) continue;
                                 
-                                // Handle remote player boarding state
-                                bool wasOnBoat = boat->isPlayerOnBoard(remote);
-                                bool shouldBeOnBoat = states[i].isOnBoat != 0;
-                                // (fishing hook syncing moved below to ensure boarding/position changes applied first)
+                                    // Handle remote player boarding state
+                                    bool wasOnBoat = boat->isPlayerOnBoard(remote);
+                                    bool shouldBeOnBoat = states[i].isOnBoat != 0;
+                                    // (fishing hook syncing moved below to ensure boarding/position changes applied first)
                                 
-                                if (shouldBeOnBoat && !wasOnBoat) {
-                                    Vector2* rpos = remote->getPosition();
-                                    rpos->x = states[i].x;
-                                    rpos->y = states[i].y;
-                                    boat->boardBoat(remote);
-                                } else if (!shouldBeOnBoat && wasOnBoat) {
-                                    boat->leaveBoat(remote);
-                                    Vector2* rpos = remote->getPosition();
-                                    rpos->x = states[i].x;
-                                    rpos->y = states[i].y;
-                                } else {
-                                    Vector2* rpos = remote->getPosition();
-                                    if (shouldBeOnBoat) {
-                                        Vector2 boatWorld = boat->getWorldPosition();
-                                        rpos->x = states[i].x - boatWorld.x;
-                                        rpos->y = states[i].y - boatWorld.y;
+                                    if (shouldBeOnBoat && !wasOnBoat) {
+                                        remote->setPosition({states[i].x, states[i].y});
+                                        boat->boardBoat(remote);
+                                    } else if (!shouldBeOnBoat && wasOnBoat) {
+                                        boat->leaveBoat(remote);
+                                        remote->setPosition({states[i].x, states[i].y});
                                     } else {
-                                        rpos->x = states[i].x;
-                                        rpos->y = states[i].y;
+                                        if (shouldBeOnBoat) {
+                                            remote->setPosition(remote->worldToLocal({states[i].x, states[i].y}));
+                                        } else {
+                                            remote->setPosition({states[i].x, states[i].y});
+                                        }
                                     }
-                                }
                                 
-                                remote->setVelocity({states[i].vx, states[i].vy});
-                                remote->setRodVisible(states[i].isHooking != 0);
-                                // Sync health
-                                remote->setHp(states[i].hp);
-                                remote->setMaxHp(states[i].maxHp);
-                                // Sync equipment
-                                if (states[i].equipment == Player::EQUIP_HARPOON) remote->equipHarpoon();
-                                else if (states[i].equipment == Player::EQUIP_ROD) remote->equipRod();
-                                else remote->equip(Player::EQUIP_NONE);
-
-                                // Sync fishing hook for remote player only (after applying boarding/position)
-                                if (remote->getFishingProjectile()) {
-                                    if (states[i].fishingHookActive) {
-                                        Vector2 hookPos = {states[i].fishingHookX, states[i].fishingHookY};
-                                        Vector2 hookTarget = {states[i].fishingHookTargetX, states[i].fishingHookTargetY};
-                                        if (!remote->getFishingProjectile()->getIsActive()) {
-                                            // Use the correct target for remote cast
-                                            Vector2 direction = {hookTarget.x - hookPos.x, hookTarget.y - hookPos.y};
-                                            // When reproducing remote casts from snapshots, do not play attract sounds on this client
-                                            remote->getFishingProjectile()->cast(hookPos, direction, hookTarget, 200.0f, false);
-                                        }
-                                        // Snapshot indicates active -> cancel any pending retract
-                                        remote->getFishingProjectile()->cancelPendingRetract();
-                                        // Always update position and ensure visible if active
-                                        Vector2* pos = remote->getFishingProjectile()->getPosition();
-                                        pos->x = hookPos.x;
-                                        pos->y = hookPos.y;
-                                        remote->getFishingProjectile()->setVisible(true);
-                                    } else {
-                                        if (remote->getFishingProjectile()->getIsActive()) {
-                                            // Start a short debounce before retracting to avoid snapshot jitter flicker
-                                            remote->getFishingProjectile()->startRetractDebounce(0.12f);
+                                    remote->setVelocity({states[i].vx, states[i].vy});
+                                    remote->setRodVisible(states[i].isHooking != 0);
+                                    // Sync health
+                                    remote->setHp(states[i].hp);
+                                    remote->setMaxHp(states[i].maxHp);
+                                    // Sync equipment
+                                    if (states[i].equipment == Player::EQUIP_HARPOON) remote->equipHarpoon();
+                                    else if (states[i].equipment == Player::EQUIP_ROD) remote->equipRod();
+                                    else remote->equip(Player::EQUIP_NONE);
+
+                                    // Sync fishing hook for remote player only (after applying boarding/position)
+                                    if (remote->getFishingProjectile()) {
+                                        if (states[i].fishingHookActive) {
+                                            Vector2 hookPos = {states[i].fishingHookX, states[i].fishingHookY};
+                                            Vector2 hookTarget = {states[i].fishingHookTargetX, states[i].fishingHookTargetY};
+                                            if (!remote->getFishingProjectile()->getIsActive()) {
+                                                // Use the correct target for remote cast
+                                                Vector2 direction = {hookTarget.x - hookPos.x, hookTarget.y - hookPos.y};
+                                                // When reproducing remote casts from snapshots, do not play attract sounds on this client
+                                                remote->getFishingProjectile()->cast(hookPos, direction, hookTarget, 200.0f, false);
+                                            }
+                                            // Snapshot indicates active -> cancel any pending retract
+                                            remote->getFishingProjectile()->cancelPendingRetract();
+                                            // Always update position and ensure visible if active
+                                            remote->getFishingProjectile()->setPosition(hookPos);
+                                            remote->getFishingProjectile()->setVisible(true);
+                                        } else {
+                                            if (remote->getFishingProjectile()->getIsActive()) {
+                                                // Start a short debounce before retracting to avoid snapshot jitter flicker
+                                                remote->getFishingProjectile()->startRetractDebounce(0.12f);
+                                            }
                                         }
                                     }
-                                }
 
-                                // Sync harpoon projectile if present
-                                if (remote->getGun() && remote->getGun()->getProjectile()) {
-                                    Projectile* rp = remote->getGun()->getProjectile();
-                                    if (states[i].projectileActive) {
-                                        Vector2 ppos = { states[i].projectileX, states[i].projectileY };
-                                        Vector2 ptarget = { states[i].projectileTargetX, states[i].projectileTargetY };
-                                        if (!rp->isActive()) {
-                                            // Activate projectile at reported position/target
-                                            if (std::find(gameObjects.begin(), gameObjects.end(), rp) == gameObjects.end()) gameObjects.push_back(rp);
-                                            rp->setState(ppos, ptarget, true);
+                                    // Sync harpoon projectile if present
+                                    if (remote->getGun() && remote->getGun()->getProjectile()) {
+                                        Projectile* rp = remote->getGun()->getProjectile();
+                                        if (states[i].projectileActive) {
+                                            Vector2 ppos = { states[i].projectileX, states[i].projectileY };
+                                            Vector2 ptarget = { states[i].projectileTargetX, states[i].projectileTargetY };
+                                            if (!rp->isActive()) {
+                                                // Activate projectile at reported position/target
+                                                gameObjects.add(rp);
+                                                rp->setState(ppos, ptarget, true);
+                                            } else {
+                                                // Update position to match snapshot
+                                                rp->setPosition(ppos);
+                                                rp->setVisible(true);
+                                            }
                                         } else {
-                                            // Update position to match snapshot
-                                            Vector2* rpos = rp->getPosition();
-                                            rpos->x = ppos.x;
-                                            rpos->y = ppos.y;
-                                            rp->setVisible(true);
-                                        }
-                                    } else {
-                                        if (rp->isActive()) {
-                                            // deactivate to avoid snapshot jitter
-                                            rp->setState(rp->getWorldPosition(), rp->getTargetPos(), false);
+                                            if (rp->isActive()) {
+                                                // deactivate to avoid snapshot jitter
+                                                rp->setState(rp->getWorldPosition(), rp->getTargetPos(), false);
+                                            }
                                         }
                                     }
                                 }
                             }
+                            continue;
                         }
-                        continue;
                     }
                 }
-            }
-            SDLNet_FreePacket(in);
-            // Interpolate remote players using velocity between snapshots
-            for (auto& [id, remote] : remotePlayers) {
-                remote->applyVelocity(static_cast<float>(dt));
-            }
-        }
-        // Ensure environment chunks exist around current player location
-        ensureChunksAround(renderer, player->getWorldPosition(), 1);
-
-        // Skip game updates when navigation UI is active or inventory is open
-        if(!navigationUIActive && !inventoryOpen){
-            // Update all objects first
-            for(GameObject* obj: gameObjects){
-                obj->update(static_cast<float>(dt));
-            }
-
-            // Then handle collisions - process each unique pair only once
-            std::vector<ICollidable*> colliders;
-            for(GameObject* obj: gameObjects){
-                if(ICollidable* collider = dynamic_cast<ICollidable*>(obj)){
-                    if(!collider->isAlive()) continue;
-                    colliders.push_back(collider);
+                // Interpolate remote players using velocity between snapshots
+                for (auto& [id, remote] : remotePlayers) {
+                    remote->applyVelocity(static_cast<float>(dt));
                 }
             }
-
-            std::set<std::pair<ICollidable*, ICollidable*>> collisionPairsToRemove;
-
-            for(auto pair : collisionPairs){
-                if(!pair.first->isAlive() || !pair.second->isAlive()){
-                    // One of the colliders is dead, remove the pair
-                    collisionPairsToRemove.insert(pair);
-                }
+            // Ensure environment chunks exist around current player location
+            {
+                PERF_ZONE("ensureChunksAround", PerfSection::Chunks);
+                ensureChunksAround(renderer, player->getWorldPosition(), 1);
             }
 
-            for (const auto& pair : collisionPairsToRemove) {
-                collisionPairs.erase(pair);
-            }
-            collisionPairsToRemove.clear();
+            // Skip game updates when navigation UI is active or inventory is open
+            if(!navigationUIActive && !inventoryOpen){
+                // Update all objects first (fish and projectiles in parallel, see UpdatePhase)
+                {
+                    PERF_ZONE("object update", PerfSection::Update);
+                    UpdatePhase::updateObjects(gameObjects.objects(), static_cast<float>(dt));
+                }
 
-            for(size_t i = 0; i < colliders.size(); ++i){
-                for(size_t j = i + 1; j < colliders.size(); ++j){
-                    ICollidable* collider = colliders[i];
-                    ICollidable* otherCollider = colliders[j];
-                    
-                    auto shapeA = collider->getCollisionBox();
-                    auto shapeB = otherCollider->getCollisionBox();
-                    
-                    bool isColliding = checkCollision(shapeA, shapeB);
-                    
-                    
-                    
-                    // Use consistent pair ordering (smaller pointer first)
-                    auto pair = (collider < otherCollider) ? 
-                        std::make_pair(collider, otherCollider) : 
-                        std::make_pair(otherCollider, collider);
-                    
-                    bool wasColliding = collisionPairs.find(pair) != collisionPairs.end();
-                    
-                    if(wasColliding){
-                        if(!isColliding){
-                            // Collision ended
-                            collider->onCollisionLeave(otherCollider);
-                            otherCollider->onCollisionLeave(collider);
-                            collisionPairs.erase(pair);
-                        } else {
-                            // Collision continuing
-                            collider->onCollisionStay(otherCollider);
-                            otherCollider->onCollisionStay(collider);
-                        }
-                    } else if(isColliding){
-                        // New collision
-                        collider->onCollisionEnter(otherCollider);
-                        otherCollider->onCollisionEnter(collider);
-                        collisionPairs.insert(pair);
-                    }
+                // Then handle collisions - process each unique pair only once
+                {
+                    PERF_ZONE("collision", PerfSection::Collision);
+                    runCollisionPhase(gameObjects.objects(), collisionPairs);
                 }
-            }
             
-            // Host broadcasts snapshot
-            if (isHost && udpSocket) {
-                broadcastSnapshot();
+                // Host broadcasts snapshot
+                if (isHost && udpSocket) {
+                    PERF_ZONE("broadcastSnapshot", PerfSection::Network);
+                    broadcastSnapshot();
+                }
             }
-        }
         
-        // (moved) fishing minigame update runs earlier now to ensure input sees the visible indicator
-
-        // Move any caught fishes toward the player's world position and spawn UI icons when they reach the player
-        if (!fishesMovingToPlayer.empty() && player) {
-            std::vector<GameObject*> remaining;
-            for (auto* fish : fishesMovingToPlayer) {
-                if (!fish) continue;
-                Vector2* fpos = fish->getPosition();
-                Vector2 playerPos = player->getWorldPosition();
-                float dx = playerPos.x - fpos->x;
-                float dy = playerPos.y - fpos->y;
-                float dist = std::sqrt(dx*dx + dy*dy);
-                float moveSpeed = 160.0f; // pixels per second
-                float step = moveSpeed * static_cast<float>(dt);
-                if (dist <= step + 1.0f) {
-                    // Collected: remove fish from world and add to first empty inventory slot
-                    auto it = std::find(gameObjects.begin(), gameObjects.end(), fish);
-                    if (it != gameObjects.end()) gameObjects.erase(it);
-                    // Find first empty slot
-                    int slotIndex = -1;
-                    for (int si = 0; si < INV_COLS * INV_ROWS; ++si) {
-                        if (!inventorySlots[si]) { slotIndex = si; break; }
-                    }
-                    if (slotIndex >= 0 && renderer) {
-                        int cols = INV_COLS; int rows = INV_ROWS; int cellSize = INV_CELL_SIZE; int padding = INV_PADDING;
-                        int gridWidth = cols * cellSize + (cols - 1) * padding;
-                        int gridHeight = rows * cellSize + (rows - 1) * padding;
-                        int startX = (WIN_WIDTH - gridWidth) / 2;
-                        int startY = (WIN_HEIGHT - gridHeight) / 2;
-                        int srow = slotIndex / cols;
-                        int scol = slotIndex % cols;
-                        SDL_Rect dstRect = { startX + scol * (cellSize + padding), startY + srow * (cellSize + padding), cellSize, cellSize };
-                        // Create a static UI icon in that slot (start hidden; shown only when inventoryOpen)
-                        // Do NOT add to gameObjects - we'll render icons only while inventory is open
-                        UIGameObject* icon = new UIGameObject({static_cast<float>(dstRect.x), static_cast<float>(dstRect.y)}, {1.0f,1.0f}, "./sprites/fish.bmp", renderer, LAYER_UI);
-                        icon->getSize()->x = static_cast<float>(cellSize);
-                        icon->getSize()->y = static_cast<float>(cellSize);
-                        icon->setVisible(false); // hide until inventory is opened
-                        inventorySlots[slotIndex] = icon;
-                        SDL_Log("Fish added to inventory slot %d", slotIndex);
-                        delete fish;
+            // Move any caught fishes toward the player's world position and spawn UI icons when they reach the player
+            if (!fishesMovingToPlayer.empty() && player) {
+                PROFILE_ZONE("fish collection");
+                // Swapped with fishesMovingToPlayer below; both buffers keep their capacity
+                static std::vector<EntityHandle> remaining;
+                remaining.clear();
+                for (EntityHandle handle : fishesMovingToPlayer) {
+                    GameObject* fish = gameObjects.get(handle);
+                    if (!fish || fish->isMarkedForDeletion()) continue;
+                    const Vector2* fpos = fish->getPosition();
+                    Vector2 playerPos = player->getWorldPosition();
+                    float dx = playerPos.x - fpos->x;
+                    float dy = playerPos.y - fpos->y;
+                    float dist = std::sqrt(dx*dx + dy*dy);
+                    float moveSpeed = 160.0f; // pixels per second
+                    float step = moveSpeed * static_cast<float>(dt);
+                    if (dist <= step + 1.0f) {
+                        // Collected: the fish leaves the world at the end of the frame; add it to the first empty inventory slot
+                        fish->markForDeletion();
+                        // Find first empty slot
+                        int slotIndex = -1;
+                        for (int si = 0; si < INV_COLS * INV_ROWS; ++si) {
+                            if (!inventorySlots[si]) { slotIndex = si; break; }
+                        }
+                        if (slotIndex >= 0 && renderer) {
+                            int cols = INV_COLS; int rows = INV_ROWS; int cellSize = INV_CELL_SIZE; int padding = INV_PADDING;
+                            int gridWidth = cols * cellSize + (cols - 1) * padding;
+                            int gridHeight = rows * cellSize + (rows - 1) * padding;
+                            int startX = (WIN_WIDTH - gridWidth) / 2;
+                            int startY = (WIN_HEIGHT - gridHeight) / 2;
+                            int srow = slotIndex / cols;
+                            int scol = slotIndex % cols;
+                            SDL_Rect dstRect = { startX + scol * (cellSize + padding), startY + srow * (cellSize + padding), cellSize, cellSize };
+                            // Create a static UI icon in that slot (start hidden; shown only when inventoryOpen)
+                            // Do NOT add to gameObjects - we'll render icons only while inventory is open
+                            UIGameObject* icon = new FishIcon({static_cast<float>(dstRect.x), static_cast<float>(dstRect.y)}, renderer);
+                            icon->setSize({static_cast<float>(cellSize), static_cast<float>(cellSize)});
+                            icon->setVisible(false); // hide until inventory is opened
+                            inventorySlots[slotIndex] = icon;
+                            SDL_Log("Fish added to inventory slot %d", slotIndex);
+                        } else {
+                            // Inventory full: just drop the fish
+                            SDL_Log("Inventory full, fish discarded");
+                        }
                     } else {
-                        // Inventory full: just delete the fish
-                        delete fish;
-                        SDL_Log("Inventory full, fish discarded");
+                        // Move toward player
+                        fish->changePosition((dx / dist) * step, (dy / dist) * step);
+                        remaining.push_back(handle);
                     }
-                } else {
-                    // Move toward player
-                    fpos->x += (dx / dist) * step;
-                    fpos->y += (dy / dist) * step;
-                    remaining.push_back(fish);
                 }
+                fishesMovingToPlayer.swap(remaining);
             }
-            fishesMovingToPlayer = std::move(remaining);
         }
-
-        // Two-phase cleanup: first gather, then remove from list, then delete to avoid use-after-free
-       
+        // Too far behind (debugger, window drag): drop the backlog instead of spiralling
+        if (ticksThisFrame == MAX_TICKS_PER_FRAME) tickAccumulator = std::min(tickAccumulator, tickSeconds);
 
         // Ensure inventory icons are only visible when the inventory UI is open
         for (int si = 0; si < INV_COLS * INV_ROWS; ++si) {
             if (inventorySlots[si]) inventorySlots[si]->setVisible(inventoryOpen);
         }
-        camera->render(renderer,gameObjects);
+        renderInterpolator.apply(gameObjects.objects(), static_cast<float>(tickAccumulator / tickSeconds));
+        {
+            PERF_ZONE("Camera::render", PerfSection::Render);
+            camera->render(renderer,gameObjects.objects());
+        }
 
 
         // Render fishing lines after game objects but before UI
+        PERF_ZONE_NAMED(linesZone, "fishing lines", PerfSection::Render);
         if (player->getFishingProjectile()) {
             player->getFishingProjectile()->renderLine(renderer, camera->getPosition(), camera->getZoom());
             player->getFishingProjectile()->renderParticles(renderer, camera->getPosition(), camera->getZoom());
@@ -2550,9 +2790,14 @@ int main(int argc, char* argv[]) {
                 remote->getFishingProjectile()->renderParticles(renderer, camera->getPosition(), camera->getZoom());
             }
         }
+        linesZone.end();
+
+        // Everything drawn from here to the present is UI
+        PERF_ZONE_NAMED(uiZone, "UI", PerfSection::UI);
 
         // Inventory UI rendering
         if (inventoryOpen) {
+            PROFILE_ZONE("inventory UI");
             // Darken the entire screen
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // More opaque black
@@ -2571,7 +2816,7 @@ int main(int argc, char* argv[]) {
             // Load the inventory sprite once
             static SDL_Texture* invTex = nullptr;
             if (!invTex) {
-                SDL_Surface* surf = SDL_LoadBMP("./sprites/Inventory.bmp");
+                SDL_Surface* surf = loadSpriteSurface("./sprites/Inventory.bmp");
                 if (surf) {
                     invTex = SDL_CreateTextureFromSurface(renderer, surf);
                     SDL_FreeSurface(surf);
@@ -2595,27 +2840,15 @@ int main(int argc, char* argv[]) {
                     // If a slot is occupied, draw the fish icon explicitly (only when inventory UI is visible)
                     int slotIndex = row * cols + col;
                     if (slotIndex >= 0 && slotIndex < INV_COLS * INV_ROWS && inventorySlots[slotIndex]) {
-                        // Load fish texture once
-                        static SDL_Texture* invFishTex = nullptr;
-                        if (!invFishTex) {
-                            SDL_Surface* fishSurf = SDL_LoadBMP("./sprites/fish.bmp");
-                            if (fishSurf) {
-                                invFishTex = SDL_CreateTextureFromSurface(renderer, fishSurf);
-                                SDL_FreeSurface(fishSurf);
-                            }
-                        }
+                        SDL_Texture* invFishTex = SpriteCache::instance().texture(renderer, CaughtFish::SPRITE);
                         if (invFishTex) {
                             SDL_RenderCopy(renderer, invFishTex, nullptr, &dstRect);
                         }
                         // Keep internal icon position/size in sync in case other code reads it
                         UIGameObject* icon = inventorySlots[slotIndex];
                         icon->setVisible(inventoryOpen);
-                        Vector2* ipos = icon->getPosition();
-                        ipos->x = static_cast<float>(dstRect.x);
-                        ipos->y = static_cast<float>(dstRect.y);
-                        Vector2* isz = icon->getSize();
-                        isz->x = static_cast<float>(dstRect.w);
-                        isz->y = static_cast<float>(dstRect.h);
+                        icon->setPosition({static_cast<float>(dstRect.x), static_cast<float>(dstRect.y)});
+                        icon->setSize({static_cast<float>(dstRect.w), static_cast<float>(dstRect.h)});
                     }
                 }
             }
@@ -2623,6 +2856,7 @@ int main(int argc, char* argv[]) {
 
         // Lighthouse shop UI rendering
         if (lighthouseShopOpen) {
+            PROFILE_ZONE("shop UI");
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 100); // lighter dim
             SDL_Rect screenRect = {0, 0, WIN_WIDTH, WIN_HEIGHT};
@@ -2656,20 +2890,11 @@ int main(int argc, char* argv[]) {
                 lighthouseShopTitle = new Text({static_cast<float>(titleRect.x + 8), static_cast<float>(titleRect.y + 6)}, "Lighthouse Shop", "./fonts/font.ttf", 20, renderer, SDL_Color{0,0,0,255}, LAYER_UI);
                 // do not add to gameObjects; render it directly above the panel to ensure visibility
             } else {
-                Vector2* tpos = lighthouseShopTitle->getPosition();
-                tpos->x = static_cast<float>(titleRect.x + 8);
-                tpos->y = static_cast<float>(titleRect.y + 6);
+                lighthouseShopTitle->setPosition({static_cast<float>(titleRect.x + 8), static_cast<float>(titleRect.y + 6)});
             }
 
             // Draw grid and fish icons
-            static SDL_Texture* shopFishTex = nullptr;
-            if (!shopFishTex) {
-                SDL_Surface* fishSurf = SDL_LoadBMP("./sprites/fish.bmp");
-                if (fishSurf) {
-                    shopFishTex = SDL_CreateTextureFromSurface(renderer, fishSurf);
-                    SDL_FreeSurface(fishSurf);
-                }
-            }
+            SDL_Texture* shopFishTex = SpriteCache::instance().texture(renderer, CaughtFish::SPRITE);
 
             for (int row = 0; row < rows; ++row) {
                 for (int col = 0; col < cols; ++col) {
@@ -2705,9 +2930,7 @@ int main(int argc, char* argv[]) {
                 // Do NOT add to gameObjects; we render it directly after the panel to ensure visibility
             } else {
                 // Update position and text
-                Vector2* pos = lighthouseSellAllLabel->getPosition();
-                pos->x = static_cast<float>(sellBtn.x + 8);
-                pos->y = static_cast<float>(sellBtn.y + 4);
+                lighthouseSellAllLabel->setPosition({static_cast<float>(sellBtn.x + 8), static_cast<float>(sellBtn.y + 4)});
                 lighthouseSellAllLabel->setText(std::string("Sell All (") + std::to_string(fishCount) + ")");
             }
 
@@ -2716,25 +2939,13 @@ int main(int argc, char* argv[]) {
             lighthouseShopRect = { startX, startY, gridWidth, bottom - startY };
 
             // After drawing the button, draw the labels directly so they appear on top of the panel
-            if (lighthouseShopTitle && lighthouseShopTitle->getSprite()) {
-                SDL_Texture* t = lighthouseShopTitle->getSprite();
-                Vector2* tpos = lighthouseShopTitle->getPosition();
-                Vector2* tsz = lighthouseShopTitle->getSize();
-                SDL_Rect td = { static_cast<int>(tpos->x), static_cast<int>(tpos->y), static_cast<int>(tsz->x), static_cast<int>(tsz->y) };
-                SDL_RenderCopy(renderer, t, nullptr, &td);
-            }
-
-            if (lighthouseSellAllLabel && lighthouseSellAllLabel->getSprite()) {
-                SDL_Texture* s = lighthouseSellAllLabel->getSprite();
-                Vector2* spos = lighthouseSellAllLabel->getPosition();
-                Vector2* ssz = lighthouseSellAllLabel->getSize();
-                SDL_Rect sd = { static_cast<int>(spos->x), static_cast<int>(spos->y), static_cast<int>(ssz->x), static_cast<int>(ssz->y) };
-                SDL_RenderCopy(renderer, s, nullptr, &sd);
-            }
+            if (lighthouseShopTitle) lighthouseShopTitle->drawUI(renderer);
+            if (lighthouseSellAllLabel) lighthouseSellAllLabel->drawUI(renderer);
         }
 
         // Render navigation UI overlay if active
         if(navigationUIActive){
+            PROFILE_ZONE("navigation UI");
             // Darken the entire screen
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180); // Semi-transparent black
@@ -2764,7 +2975,7 @@ int main(int argc, char* argv[]) {
                 // Draw navigation indicator based on mouse position
                 if(navigationIndicatorTexture){
                     int mouseX, mouseY;
-                    SDL_GetMouseState(&mouseX, &mouseY);
+                    NetRecorder::instance().mouseState(&mouseX, &mouseY);
                     
                     // Calculate angle from center to mouse
                     float dx = static_cast<float>(mouseX - centerX);
@@ -2797,6 +3008,7 @@ int main(int argc, char* argv[]) {
 
         // Draw fishing minigame overlay if active (draw near the hook)
         if (fishingMinigameActive) {
+            PROFILE_ZONE("minigame UI");
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             // Dim small area behind the bar for legibility
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 120);
@@ -2863,6 +3075,7 @@ int main(int argc, char* argv[]) {
 
         // Draw equipment wheel overlay if open
         if (equipmentWheelOpen) {
+            PROFILE_ZONE("equipment wheel UI");
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
             SDL_Rect screenRect = {0, 0, WIN_WIDTH, WIN_HEIGHT};
@@ -2877,7 +3090,7 @@ int main(int argc, char* argv[]) {
 
             // Determine hover based on current mouse position
             int mx, my;
-            SDL_GetMouseState(&mx, &my);
+            NetRecorder::instance().mouseState(&mx, &my);
             equipmentWheelSelected = (mx < cx) ? 0 : 1;
 
             // Draw left (Rod)
@@ -2897,11 +3110,11 @@ int main(int argc, char* argv[]) {
             // Draw labels using Text objects (cached)
             if (!equipmentLabelRod) equipmentLabelRod = new Text({static_cast<float>(leftBtn.x + 8), static_cast<float>(leftBtn.y + btnSize + 8)}, "Rod", "./fonts/font.ttf", 18, renderer, SDL_Color{255,255,255,255}, LAYER_UI);
             else {
-                Vector2* p = equipmentLabelRod->getPosition(); p->x = static_cast<float>(leftBtn.x + 8); p->y = static_cast<float>(leftBtn.y + btnSize + 8);
+                equipmentLabelRod->setPosition({static_cast<float>(leftBtn.x + 8), static_cast<float>(leftBtn.y + btnSize + 8)});
             }
             if (!equipmentLabelHarpoon) equipmentLabelHarpoon = new Text({static_cast<float>(rightBtn.x + 8), static_cast<float>(rightBtn.y + btnSize + 8)}, "Harpoon", "./fonts/font.ttf", 18, renderer, SDL_Color{255,255,255,255}, LAYER_UI);
             else {
-                Vector2* p = equipmentLabelHarpoon->getPosition(); p->x = static_cast<float>(rightBtn.x + 8); p->y = static_cast<float>(rightBtn.y + btnSize + 8);
+                equipmentLabelHarpoon->setPosition({static_cast<float>(rightBtn.x + 8), static_cast<float>(rightBtn.y + btnSize + 8)});
             }
 
             // Create or update small icons for rod / harpoon gun
@@ -2938,35 +3151,64 @@ int main(int argc, char* argv[]) {
                 SDL_RenderCopy(renderer, equipmentIconHarpoon->getSprite(), nullptr, &td);
             }
 
-            if (equipmentLabelRod && equipmentLabelRod->getSprite()) {
-                SDL_Texture* t = equipmentLabelRod->getSprite(); Vector2* tpos = equipmentLabelRod->getPosition(); Vector2* tsz = equipmentLabelRod->getSize(); SDL_Rect td = { static_cast<int>(tpos->x), static_cast<int>(tpos->y), static_cast<int>(tsz->x), static_cast<int>(tsz->y) }; SDL_RenderCopy(renderer, t, nullptr, &td);
-            }
-            if (equipmentLabelHarpoon && equipmentLabelHarpoon->getSprite()) {
-                SDL_Texture* t = equipmentLabelHarpoon->getSprite(); Vector2* tpos = equipmentLabelHarpoon->getPosition(); Vector2* tsz = equipmentLabelHarpoon->getSize(); SDL_Rect td = { static_cast<int>(tpos->x), static_cast<int>(tpos->y), static_cast<int>(tsz->x), static_cast<int>(tsz->y) }; SDL_RenderCopy(renderer, t, nullptr, &td);
-            }
+            equipmentLabelRod->drawUI(renderer);
+            equipmentLabelHarpoon->drawUI(renderer);
 
             // Small instruction text
-            Text* hint = new Text({static_cast<float>(cx - 80), static_cast<float>(cy + btnSize + 36)}, "Click side to equip · Right-click to cancel", "./fonts/font.ttf", 14, renderer, SDL_Color{200,200,200,200}, LAYER_UI);
-            if (hint && hint->getSprite()) { SDL_Texture* t = hint->getSprite(); Vector2* tpos = hint->getPosition(); Vector2* tsz = hint->getSize(); SDL_Rect td = { static_cast<int>(tpos->x), static_cast<int>(tpos->y), static_cast<int>(tsz->x), static_cast<int>(tsz->y) }; SDL_RenderCopy(renderer, t, nullptr, &td); }
-            delete hint; // transient
+            if (!equipmentWheelHint) equipmentWheelHint = new Text({0.0f, 0.0f}, "Click side to equip · Right-click to cancel", "./fonts/font.ttf", 14, renderer, SDL_Color{200,200,200,200}, LAYER_UI);
+            equipmentWheelHint->setPosition({static_cast<float>(cx - 80), static_cast<float>(cy + btnSize + 36)});
+            equipmentWheelHint->drawUI(renderer);
         }
 
-        // Apply global night overlay (darken everything based on sun intensity)
-        {
-            Uint8 nightAlpha = static_cast<Uint8>((1.0f - g_sunIntensity) * 220.0f);
-            if (nightAlpha > 2) {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, nightAlpha);
-                SDL_Rect screenRect = {0, 0, WIN_WIDTH, WIN_HEIGHT};
-                SDL_RenderFillRect(renderer, &screenRect);
-            }
+        if (netStatsOverlayVisible && ttfInitialized) {
+            PROFILE_ZONE("net overlay");
+            renderNetStatsOverlay(renderer);
+        }
+        if (PerfHud::instance().isVisible()) {
+            PROFILE_ZONE("perf HUD");
+            camera->renderOverlays(renderer);
         }
+        uiZone.end();
 
         // Present the final frame once
-        SDL_RenderPresent(renderer);
+        {
+            PERF_ZONE("SDL_RenderPresent", PerfSection::Present);
+            SDL_RenderPresent(renderer);
+        }
+        AllocTracker::instance().endFrame(frameCount);
+        renderInterpolator.restore();
+        destroyMarkedObjects();
+
+        if (NetRecorder::instance().wantsStateHash()) {
+            NetRecorder::instance().onStateHash(computeStateHash());
+        }
+    }
+
+    int exitCode = 0;
+    if (NetRecorder::instance().isReplaying()) {
+        NetRecorder& rec = NetRecorder::instance();
+        double wallSeconds = (SDL_GetPerformanceCounter() - loopStart) / freq;
+        double simSeconds = ticksRun * tickSeconds;
+        SDL_Log("Replay finished: %llu frames, %.2fs simulated in %.2fs wall (%.1fx), %u/%u state hashes matched, packets out %llu (recorded %llu)",
+            static_cast<unsigned long long>(frameCount), simSeconds, wallSeconds, wallSeconds > 0.0 ? simSeconds / wallSeconds : 0.0,
+            rec.getHashChecks() - rec.getHashMismatches(), rec.getHashChecks(),
+            static_cast<unsigned long long>(rec.getReplayedPacketsOut()), static_cast<unsigned long long>(rec.getRecordedPacketsOut()));
+        if (rec.getHashMismatches() > 0) exitCode = 2;
     }
+    NetRecorder::instance().stop();
+
+    for (Text* t : netStatsOverlayLines) delete t;
+    netStatsOverlayLines.clear();
 
     if (udpSocket) {
+        // Say goodbye so peers free our player now instead of waiting for the timeout
+        if (isHost) {
+            for (auto& [peerKey, peer] : clientPeers) sendDisconnect(peer.address, 0, DISCONNECT_HOST_SHUTDOWN);
+        } else if (clientConnState == ClientConnState::Connected) {
+            sendDisconnect(hostAddr, clientId, DISCONNECT_QUIT);
+        }
+        NetStats::instance().dumpNow();
+        NetSim::instance().flush();
         SDLNet_UDP_Close(udpSocket);
         SDLNet_Quit();
     }
@@ -2981,13 +3223,24 @@ int main(int argc, char* argv[]) {
     // Shutdown audio
     SoundManager::instance().quit();
 
+    // Glyph atlases and fonts go before the renderer and TTF
+    FontCache::instance().clear();
+    SpriteCache::instance().clear();
+    AssetPack::instance().close(); // after the sounds and sprites drawing from it
+
     // Shutdown TTF if initialized
     if (ttfInitialized) {
         TTF_Quit();
     }
 
+    JobSystem::instance().shutdown();
+#ifdef STRANDED_PROFILE
+    if (!tracePath.empty()) Profiler::instance().writeChromeTrace(tracePath);
+#else
+    if (!tracePath.empty()) std::cerr << "Warning: --trace ignored, profiler zones are compiled out of this build\n";
+#endif
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "InputBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+// Frames buffered beyond this are dropped (client far ahead or a stalled host)
+static const size_t MAX_BUFFERED = 256;
+// Ticks the buffer must stay deeper than needed before it starts skipping frames;
+// from then on one frame is skipped per tick until it is back at the target
+static const uint32_t CATCH_UP_TICKS = 30;
+
+bool InputJitterBuffer::hasActions(const InputFrame& frame) {
+    return frame.boardBoat || frame.toggleBoatMovement || frame.toggleHook ||
+           frame.mouseDown || frame.equipAction || frame.fireWeapon;
+}
+
+void InputJitterBuffer::mergeActions(InputFrame& into, const InputFrame& from) {
+    // Toggles applied twice cancel out
+    into.boardBoat ^= from.boardBoat;
+    into.toggleBoatMovement ^= from.toggleBoatMovement;
+    if (from.toggleHook) {
+        into.toggleHook ^= from.toggleHook;
+        if (into.toggleHook) {
+            into.hookTargetX = from.hookTargetX;
+            into.hookTargetY = from.hookTargetY;
+            into.hookStartX = from.hookStartX;
+            into.hookStartY = from.hookStartY;
+        }
+    }
+    // A click or shot the kept frame already has wins; the earlier one is lost
+    if (from.mouseDown && !into.mouseDown) {
+        into.mouseDown = from.mouseDown;
+        into.mouseX = from.mouseX;
+        into.mouseY = from.mouseY;
+    }
+    if (from.fireWeapon && !into.fireWeapon) {
+        into.fireWeapon = from.fireWeapon;
+        into.weaponTargetX = from.weaponTargetX;
+        into.weaponTargetY = from.weaponTargetY;
+    }
+    if (from.equipAction && !into.equipAction) into.equipAction = from.equipAction;
+}
+
+void InputJitterBuffer::dropOne() {
+    // Prefer the oldest frame without actions; only a run of action frames gets merged
+    for (auto it = frames.begin(); it != frames.end(); ++it) {
+        if (!hasActions(it->second)) {
+            frames.erase(it);
+            return;
+        }
+    }
+    auto oldest = frames.begin();
+    mergeActions(std::next(oldest)->second, oldest->second);
+    frames.erase(oldest);
+}
+
+void InputJitterBuffer::receive(uint32_t latestSeq, const std::vector<InputFrame>& incoming, double nowSeconds) {
+    for (size_t i = 0; i < incoming.size(); ++i) {
+        uint32_t seq = latestSeq - static_cast<uint32_t>(i);
+        if (hasConsumed && static_cast<int32_t>(seq - lastConsumed) <= 0) continue; // already applied
+        frames.emplace(seq, incoming[i]); // keeps the first copy of a redundant frame
+    }
+    while (frames.size() > MAX_BUFFERED) dropOne();
+
+    // Only in-order datagrams say anything about spacing; reordered ones are ignored
+    if (hasArrival && static_cast<int32_t>(latestSeq - lastArrivalSeq) <= 0) return;
+    if (hasArrival) {
+        float seqDelta = static_cast<float>(latestSeq - lastArrivalSeq);
+        float gap = static_cast<float>(nowSeconds - lastArrivalSeconds);
+        seqIntervalSeconds += (gap / seqDelta - seqIntervalSeconds) / 64.0f;
+        float deviation = std::fabs(gap - seqDelta * seqIntervalSeconds);
+        jitterSeconds += (deviation - jitterSeconds) / 16.0f;
+    }
+    hasArrival = true;
+    lastArrivalSeq = latestSeq;
+    lastArrivalSeconds = nowSeconds;
+}
+
+bool InputJitterBuffer::consume(InputFrame& out, float tickSeconds) {
+    // Hold enough frames to ride out twice the measured jitter, plus the one being applied
+    float jitterTicks = tickSeconds > 0.0f ? 2.0f * jitterSeconds / tickSeconds : 0.0f;
+    targetDepth = static_cast<uint32_t>(std::clamp(1.0f + std::ceil(jitterTicks), 1.0f, static_cast<float>(MAX_DEPTH)));
+
+    if (!started) {
+        if (frames.size() < targetDepth) return false;
+        started = true;
+    }
+    if (frames.empty()) {
+        // Ran dry: refill to the target depth before playing out again
+        ++underruns;
+        started = false;
+        return false;
+    }
+
+    auto it = frames.begin();
+    if (hasConsumed && it->first != lastConsumed + 1) {
+        // The next frame is missing. A later datagram still carries it unless newer
+        // frames have already pushed it out of the redundancy window.
+        uint32_t newest = frames.rbegin()->first;
+        if (static_cast<int32_t>(newest - (lastConsumed + 1)) < INPUT_REDUNDANCY) {
+            ++underruns;
+            return false;
+        }
+    }
+    out = it->second;
+    lastConsumed = it->first;
+    hasConsumed = true;
+    frames.erase(it);
+
+    // Running deeper than needed adds latency: once that has lasted a while, skip a
+    // frame every tick until back at the target. Two frames are folded into one only
+    // when at most one of them has actions, so no cast or shot is lost.
+    if (frames.size() > targetDepth + 1) {
+        if (++deepTicks >= CATCH_UP_TICKS && frames.begin()->first == lastConsumed + 1 &&
+            !(hasActions(out) && hasActions(frames.begin()->second))) {
+            InputFrame next = frames.begin()->second;
+            mergeActions(next, out);
+            out = next;
+            lastConsumed = frames.begin()->first;
+            frames.erase(frames.begin());
+            ++skipped;
+        }
+    } else {
+        deepTicks = 0;
+    }
+    return true;
+}
+
+void InputJitterBuffer::reset() {
+    *this = InputJitterBuffer{};
+}
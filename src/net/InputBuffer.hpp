@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "Packets.hpp"
+
+// Host-side jitter buffer for one client's input frames. Datagrams are stored by
+// sequence as they arrive; the simulation takes exactly one frame per tick, so a
+// burst of datagrams no longer applies several frames in one tick and a gap no
+// longer stalls. The playout delay (target depth) follows the measured arrival
+// jitter; when the buffer runs deeper than needed for a while, it skips a frame
+// per tick until back at the target. Skipped and overflowing frames hand their
+// one-shot actions to a frame that is applied, so no cast or shot is lost.
+class InputJitterBuffer {
+public:
+    static constexpr int MAX_DEPTH = 16;
+
+    // Store the frames of one INPT datagram (newest first, frame i = latestSeq - i).
+    // nowSeconds is the host's simulation clock when the datagram was read.
+    void receive(uint32_t latestSeq, const std::vector<InputFrame>& frames, double nowSeconds);
+
+    // Once per simulation tick. Returns false when there is nothing to apply this
+    // tick (still filling, or underrun); the player then keeps its held keys.
+    bool consume(InputFrame& out, float tickSeconds);
+
+    void reset();
+
+    uint32_t getDepth() const { return static_cast<uint32_t>(frames.size()); }
+    uint32_t getTargetDepth() const { return targetDepth; }
+    float getJitterMs() const { return jitterSeconds * 1000.0f; }
+    uint32_t getUnderruns() const { return underruns; }
+    uint32_t getSkipped() const { return skipped; }
+
+private:
+    static bool hasActions(const InputFrame& frame);
+    // Moves the one-shot actions of a frame that will not be applied onto one that will
+    static void mergeActions(InputFrame& into, const InputFrame& from);
+    // Overflow: drops the oldest frame without actions, or merges the oldest into the next
+    void dropOne();
+
+    std::map<uint32_t, InputFrame> frames; // by sequence, only > lastConsumed
+    bool started = false; // playout begins once the buffer first reaches the target depth
+    uint32_t lastConsumed = 0;
+    bool hasConsumed = false;
+
+    // Arrival jitter (RFC 3550 style): deviation of datagram spacing from the
+    // spacing their sequence numbers imply
+    bool hasArrival = false;
+    uint32_t lastArrivalSeq = 0;
+    double lastArrivalSeconds = 0.0;
+    float seqIntervalSeconds = 1.0f / 60.0f; // smoothed client send interval per sequence
+    float jitterSeconds = 0.0f;
+
+    uint32_t targetDepth = 2;
+    uint32_t deepTicks = 0; // consecutive ticks spent above the target
+    uint32_t underruns = 0;
+    uint32_t skipped = 0;
+};
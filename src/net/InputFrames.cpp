@@ -0,0 +1,82 @@
+#include "InputFrames.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Delta-encoded fields, in mask bit order
+struct InputField {
+    size_t offset;
+    size_t size;
+};
+
+#define INPUT_FIELD(name) InputField{offsetof(InputFrame, name), sizeof(InputFrame::name)}
+static const InputField INPUT_FIELDS[] = {
+    INPUT_FIELD(moveFlags), INPUT_FIELD(boardBoat), INPUT_FIELD(toggleBoatMovement),
+    INPUT_FIELD(hasBoatControl), INPUT_FIELD(toggleHook), INPUT_FIELD(boatNavDirX),
+    INPUT_FIELD(boatNavDirY), INPUT_FIELD(mouseDown), INPUT_FIELD(mouseX),
+    INPUT_FIELD(mouseY), INPUT_FIELD(hookTargetX), INPUT_FIELD(hookTargetY),
+    INPUT_FIELD(hookStartX), INPUT_FIELD(hookStartY), INPUT_FIELD(equipAction),
+    INPUT_FIELD(fireWeapon), INPUT_FIELD(weaponTargetX), INPUT_FIELD(weaponTargetY),
+};
+#undef INPUT_FIELD
+
+static const size_t INPUT_FIELD_COUNT = sizeof(INPUT_FIELDS) / sizeof(INPUT_FIELDS[0]);
+static_assert(INPUT_FIELD_COUNT <= 32, "input field mask is a uint32_t");
+
+std::vector<uint8_t> buildInputPacket(uint32_t clientId, uint32_t latestSeq, const std::deque<InputFrame>& frames) {
+    size_t count = std::min(frames.size(), static_cast<size_t>(INPUT_REDUNDANCY));
+    InputPacketHeader header{MAGIC_INPT, clientId, latestSeq, static_cast<uint8_t>(count)};
+
+    std::vector<uint8_t> buf(sizeof(header));
+    std::memcpy(buf.data(), &header, sizeof(header));
+    if (count == 0) return buf;
+
+    const uint8_t* first = reinterpret_cast<const uint8_t*>(&frames[0]);
+    buf.insert(buf.end(), first, first + sizeof(InputFrame));
+    for (size_t i = 1; i < count; ++i) {
+        const uint8_t* prev = reinterpret_cast<const uint8_t*>(&frames[i - 1]);
+        const uint8_t* cur = reinterpret_cast<const uint8_t*>(&frames[i]);
+        uint32_t mask = 0;
+        for (size_t f = 0; f < INPUT_FIELD_COUNT; ++f) {
+            const InputField& field = INPUT_FIELDS[f];
+            if (std::memcmp(prev + field.offset, cur + field.offset, field.size) != 0) mask |= (1u << f);
+        }
+        const uint8_t* m = reinterpret_cast<const uint8_t*>(&mask);
+        buf.insert(buf.end(), m, m + sizeof(mask));
+        for (size_t f = 0; f < INPUT_FIELD_COUNT; ++f) {
+            if (!(mask & (1u << f))) continue;
+            const InputField& field = INPUT_FIELDS[f];
+            buf.insert(buf.end(), cur + field.offset, cur + field.offset + field.size);
+        }
+    }
+    return buf;
+}
+
+bool parseInputPacket(const uint8_t* data, size_t len, InputPacketHeader& header, std::vector<InputFrame>& frames) {
+    frames.clear();
+    if (len < sizeof(InputPacketHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC_INPT || header.frameCount == 0) return false;
+
+    size_t offset = sizeof(header);
+    if (len < offset + sizeof(InputFrame)) return false;
+    frames.resize(header.frameCount);
+    std::memcpy(&frames[0], data + offset, sizeof(InputFrame));
+    offset += sizeof(InputFrame);
+
+    for (size_t i = 1; i < header.frameCount; ++i) {
+        uint32_t mask;
+        if (len < offset + sizeof(mask)) return false;
+        std::memcpy(&mask, data + offset, sizeof(mask));
+        offset += sizeof(mask);
+        frames[i] = frames[i - 1];
+        uint8_t* cur = reinterpret_cast<uint8_t*>(&frames[i]);
+        for (size_t f = 0; f < INPUT_FIELD_COUNT; ++f) {
+            if (!(mask & (1u << f))) continue;
+            const InputField& field = INPUT_FIELDS[f];
+            if (len < offset + field.size) return false;
+            std::memcpy(cur + field.offset, data + offset, field.size);
+            offset += field.size;
+        }
+    }
+    return true;
+}
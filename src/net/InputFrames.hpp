@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Packets.hpp"
+
+// Encode an INPT datagram from the newest frames (newest first, at most
+// INPUT_REDUNDANCY are used); frames[0] carries latestSeq.
+std::vector<uint8_t> buildInputPacket(uint32_t clientId, uint32_t latestSeq, const std::deque<InputFrame>& frames);
+
+// Decode one datagram; frames come back newest first. Returns false if it is not
+// a well-formed INPT packet.
+bool parseInputPacket(const uint8_t* data, size_t len, InputPacketHeader& header, std::vector<InputFrame>& frames);
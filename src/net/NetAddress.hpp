@@ -0,0 +1,9 @@
+#pragma once
+
+#include <SDL_net.h>
+#include <cstdint>
+
+// Hashable key for a UDP endpoint (host and port as stored by SDL_net)
+inline uint64_t netAddressKey(const IPaddress& addr) {
+    return (static_cast<uint64_t>(addr.host) << 16) | addr.port;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL_net.h>
+
+#include "NetRecorder.hpp"
+#include "Packets.hpp"
+#include "NetSim.hpp"
+#include "NetStats.hpp"
+
+// Thin wrappers over SDLNet_UDP_Send/Recv so every datagram is accounted in NetStats
+// and captured by NetRecorder. While replaying, sends never reach the wire and
+// receives come from the log instead of the socket.
+// With --netsim, sends are shaped by NetSim and every call pumps its queue.
+// Sends use pkt->address as the destination, same as SDLNet_UDP_Send with channel -1.
+inline int netSend(UDPsocket sock, UDPpacket* pkt) {
+    NetStats::instance().onSend(pkt->address, pkt->data, pkt->len);
+    NetRecorder& recorder = NetRecorder::instance();
+    recorder.onPacketOut(pkt->address, pkt->data, pkt->len);
+    if (recorder.isReplaying()) return 1;
+    return NetSim::instance().send(sock, pkt);
+}
+
+inline int netRecv(UDPsocket sock, UDPpacket* pkt) {
+    NetRecorder& recorder = NetRecorder::instance();
+    if (!recorder.isReplaying()) NetSim::instance().pump();
+    int r = recorder.isReplaying() ? recorder.nextPacketIn(pkt) : SDLNet_UDP_Recv(sock, pkt);
+    if (r > 0) {
+        NetStats::instance().onRecv(pkt->address, pkt->data, pkt->len);
+        recorder.onPacketIn(pkt->address, pkt->data, pkt->len);
+    }
+    return r;
+}
+
+// NET_MTU sized packets for the per-tick send and receive paths, allocated once
+// instead of per call. Main thread only; copy anything you keep out of them.
+// Sends and receives use separate packets so a receive loop can reply.
+inline UDPpacket* netSendPacket() {
+    static UDPpacket* pkt = SDLNet_AllocPacket(NET_MTU);
+    return pkt;
+}
+
+inline UDPpacket* netRecvPacket() {
+    static UDPpacket* pkt = SDLNet_AllocPacket(NET_MTU);
+    return pkt;
+}
@@ -0,0 +1,371 @@
+#include "NetRecorder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static const uint32_t REPLAY_MAGIC = 0x4C505253; // 'SRPL'
+static const uint32_t REPLAY_VERSION = 3;
+static const size_t RECORD_FLUSH_BYTES = 64 * 1024;
+
+enum : uint8_t {
+    REC_FRAME = 'F',
+    REC_EVENT = 'E',
+    REC_KEYS = 'K',
+    REC_MOUSE = 'M',
+    REC_PACKET_IN = 'I',
+    REC_PACKET_OUT = 'O',
+    REC_HASH = 'H',
+};
+
+static bool toRecorded(const SDL_Event& e, RecordedEvent& r) {
+    std::memset(&r, 0, sizeof(r));
+    r.type = e.type;
+    switch (e.type) {
+        case SDL_QUIT:
+            return true;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            r.sym = e.key.keysym.sym;
+            r.scancode = static_cast<uint16_t>(e.key.keysym.scancode);
+            r.mod = e.key.keysym.mod;
+            r.repeat = e.key.repeat;
+            return true;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            r.button = e.button.button;
+            r.clicks = e.button.clicks;
+            r.x = e.button.x;
+            r.y = e.button.y;
+            return true;
+        case SDL_MOUSEMOTION:
+            r.x = e.motion.x;
+            r.y = e.motion.y;
+            return true;
+        case SDL_MOUSEWHEEL:
+            r.x = e.wheel.x;
+            r.y = e.wheel.y;
+            return true;
+        default:
+            return false; // window/system events don't affect the simulation
+    }
+}
+
+static SDL_Event fromRecorded(const RecordedEvent& r) {
+    SDL_Event e;
+    std::memset(&e, 0, sizeof(e));
+    e.type = r.type;
+    switch (r.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            e.key.state = (r.type == SDL_KEYDOWN) ? SDL_PRESSED : SDL_RELEASED;
+            e.key.keysym.sym = r.sym;
+            e.key.keysym.scancode = static_cast<SDL_Scancode>(r.scancode);
+            e.key.keysym.mod = r.mod;
+            e.key.repeat = r.repeat;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            e.button.state = (r.type == SDL_MOUSEBUTTONDOWN) ? SDL_PRESSED : SDL_RELEASED;
+            e.button.button = r.button;
+            e.button.clicks = r.clicks;
+            e.button.x = r.x;
+            e.button.y = r.y;
+            break;
+        case SDL_MOUSEMOTION:
+            e.motion.x = r.x;
+            e.motion.y = r.y;
+            break;
+        case SDL_MOUSEWHEEL:
+            e.wheel.x = r.x;
+            e.wheel.y = r.y;
+            break;
+        default:
+            break;
+    }
+    return e;
+}
+
+NetRecorder& NetRecorder::instance() {
+    static NetRecorder inst;
+    return inst;
+}
+
+NetRecorder::~NetRecorder() {
+    stop();
+}
+
+bool NetRecorder::startRecording(const std::string& path, uint32_t sessionSeed, uint32_t worldSeed, bool isHost, const IPaddress& hostAddr, uint16_t tickRate) {
+    stop();
+    recordFile = std::fopen(path.c_str(), "wb");
+    if (!recordFile) {
+        std::cerr << "Warning: could not open replay log '" << path << "' for writing\n";
+        return false;
+    }
+    ReplayFileHeader header{REPLAY_MAGIC, REPLAY_VERSION, sessionSeed, worldSeed, static_cast<uint8_t>(isHost ? 1 : 0), hostAddr.host, hostAddr.port, tickRate};
+    recordBuffer.reserve(RECORD_FLUSH_BYTES * 2);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&header);
+    recordBuffer.insert(recordBuffer.end(), p, p + sizeof(header));
+    frameIndex = 0;
+    std::fill(keys.begin(), keys.end(), 0);
+    SDL_Log("Recording session to %s (seed %u)", path.c_str(), sessionSeed);
+    return true;
+}
+
+bool NetRecorder::startReplay(const std::string& path, uint32_t& sessionSeed, uint32_t& worldSeed, bool& isHost, IPaddress& hostAddr, uint16_t& tickRate) {
+    stop();
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Could not open replay log '" << path << "'\n";
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    log.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    size_t got = log.empty() ? 0 : std::fread(log.data(), 1, log.size(), f);
+    std::fclose(f);
+    log.resize(got);
+
+    ReplayFileHeader header;
+    readPos = 0;
+    if (!read(&header, sizeof(header)) || header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION) {
+        std::cerr << "'" << path << "' is not a replay log this build understands\n";
+        log.clear();
+        return false;
+    }
+    sessionSeed = header.sessionSeed;
+    worldSeed = header.worldSeed;
+    isHost = header.isHost != 0;
+    hostAddr.host = header.hostAddrHost;
+    hostAddr.port = header.hostAddrPort;
+    tickRate = header.tickRate;
+
+    replaying = true;
+    frameIndex = 0;
+    hashChecks = hashMismatches = 0;
+    recordedPacketsOut = replayedPacketsOut = 0;
+    std::fill(keys.begin(), keys.end(), 0);
+    SDL_Log("Replaying %s (%zu bytes, seed %u, %s)", path.c_str(), log.size(), sessionSeed, isHost ? "host" : "client");
+    return true;
+}
+
+void NetRecorder::stop() {
+    if (recordFile) {
+        if (!recordBuffer.empty()) std::fwrite(recordBuffer.data(), 1, recordBuffer.size(), recordFile);
+        recordBuffer.clear();
+        std::fclose(recordFile);
+        recordFile = nullptr;
+    }
+    replaying = false;
+    log.clear();
+    frameEvents.clear();
+    framePackets.clear();
+}
+
+void NetRecorder::writeRecord(uint8_t type, const void* payload, size_t len) {
+    recordBuffer.push_back(type);
+    const uint8_t* p = static_cast<const uint8_t*>(payload);
+    recordBuffer.insert(recordBuffer.end(), p, p + len);
+    if (recordBuffer.size() >= RECORD_FLUSH_BYTES) {
+        std::fwrite(recordBuffer.data(), 1, recordBuffer.size(), recordFile);
+        recordBuffer.clear();
+    }
+}
+
+void NetRecorder::writePacket(uint8_t type, const IPaddress& addr, const uint8_t* data, int len) {
+    uint8_t head[8];
+    uint16_t len16 = static_cast<uint16_t>(len);
+    std::memcpy(head, &addr.host, 4);
+    std::memcpy(head + 4, &addr.port, 2);
+    std::memcpy(head + 6, &len16, 2);
+    recordBuffer.push_back(type);
+    recordBuffer.insert(recordBuffer.end(), head, head + sizeof(head));
+    recordBuffer.insert(recordBuffer.end(), data, data + len);
+    if (recordBuffer.size() >= RECORD_FLUSH_BYTES) {
+        std::fwrite(recordBuffer.data(), 1, recordBuffer.size(), recordFile);
+        recordBuffer.clear();
+    }
+}
+
+bool NetRecorder::read(void* out, size_t len) {
+    if (readPos + len > log.size()) return false;
+    std::memcpy(out, log.data() + readPos, len);
+    readPos += len;
+    return true;
+}
+
+bool NetRecorder::beginFrame(double& dt) {
+    if (recordFile) {
+        ++frameIndex;
+        writeRecord(REC_FRAME, &dt, sizeof(dt));
+        return true;
+    }
+    if (!replaying) return true;
+
+    frameEvents.clear();
+    framePackets.clear();
+    frameHasHash = false;
+
+    uint8_t type = 0;
+    if (!read(&type, 1) || type != REC_FRAME || !read(&dt, sizeof(dt))) return false;
+    ++frameIndex;
+
+    // Pull every record up to the next frame marker
+    while (readPos < log.size() && log[readPos] != REC_FRAME) {
+        type = log[readPos++];
+        bool ok = true;
+        switch (type) {
+            case REC_EVENT: {
+                RecordedEvent r;
+                ok = read(&r, sizeof(r));
+                if (ok) frameEvents.push_back(fromRecorded(r));
+                break;
+            }
+            case REC_KEYS: {
+                uint16_t count = 0;
+                ok = read(&count, sizeof(count));
+                std::fill(keys.begin(), keys.end(), 0);
+                for (uint16_t i = 0; ok && i < count; ++i) {
+                    uint16_t sc = 0;
+                    ok = read(&sc, sizeof(sc));
+                    if (ok && sc < keys.size()) keys[sc] = 1;
+                }
+                break;
+            }
+            case REC_MOUSE:
+                ok = read(&mouseX, sizeof(int32_t)) && read(&mouseY, sizeof(int32_t)) && read(&mouseButtons, sizeof(uint32_t));
+                break;
+            case REC_PACKET_IN:
+            case REC_PACKET_OUT: {
+                ReplayPacket pkt;
+                uint16_t len = 0;
+                ok = read(&pkt.address.host, 4) && read(&pkt.address.port, 2) && read(&len, 2) && readPos + len <= log.size();
+                if (!ok) break;
+                if (type == REC_PACKET_IN) {
+                    pkt.data.assign(log.begin() + readPos, log.begin() + readPos + len);
+                    framePackets.push_back(std::move(pkt));
+                } else {
+                    ++recordedPacketsOut;
+                }
+                readPos += len;
+                break;
+            }
+            case REC_HASH:
+                ok = read(&frameHash, sizeof(frameHash));
+                frameHasHash = ok;
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            std::cerr << "Replay log corrupt at byte " << readPos << " (frame " << frameIndex << ")\n";
+            readPos = log.size();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NetRecorder::pollEvent(SDL_Event& event) {
+    if (replaying) {
+        // Keep the window responsive, but only let the user abort the replay
+        SDL_Event real;
+        while (SDL_PollEvent(&real)) {
+            if (real.type == SDL_QUIT) {
+                event = real;
+                return true;
+            }
+        }
+        if (frameEvents.empty()) return false;
+        event = frameEvents.front();
+        frameEvents.pop_front();
+        return true;
+    }
+    if (!SDL_PollEvent(&event)) return false;
+    if (recordFile) {
+        RecordedEvent r;
+        if (toRecorded(event, r)) writeRecord(REC_EVENT, &r, sizeof(r));
+    }
+    return true;
+}
+
+void NetRecorder::captureInputState() {
+    if (!recordFile) return;
+
+    int numKeys = 0;
+    const Uint8* cur = SDL_GetKeyboardState(&numKeys);
+    size_t n = std::min(static_cast<size_t>(numKeys), keys.size());
+    if (std::memcmp(cur, keys.data(), n) != 0) {
+        std::memcpy(keys.data(), cur, n);
+        std::vector<uint16_t> down;
+        for (size_t i = 0; i < n; ++i) {
+            if (keys[i]) down.push_back(static_cast<uint16_t>(i));
+        }
+        uint16_t count = static_cast<uint16_t>(down.size());
+        std::vector<uint8_t> payload(sizeof(count) + down.size() * sizeof(uint16_t));
+        std::memcpy(payload.data(), &count, sizeof(count));
+        if (!down.empty()) std::memcpy(payload.data() + sizeof(count), down.data(), down.size() * sizeof(uint16_t));
+        writeRecord(REC_KEYS, payload.data(), payload.size());
+    }
+
+    int x = 0, y = 0;
+    Uint32 buttons = SDL_GetMouseState(&x, &y);
+    if (x != mouseX || y != mouseY || buttons != mouseButtons) {
+        mouseX = x;
+        mouseY = y;
+        mouseButtons = buttons;
+        int32_t payload[3] = {x, y, static_cast<int32_t>(buttons)};
+        writeRecord(REC_MOUSE, payload, sizeof(payload));
+    }
+}
+
+const Uint8* NetRecorder::keyboardState() {
+    if (replaying) return keys.data();
+    return SDL_GetKeyboardState(nullptr);
+}
+
+Uint32 NetRecorder::mouseState(int* x, int* y) {
+    if (replaying) {
+        if (x) *x = mouseX;
+        if (y) *y = mouseY;
+        return mouseButtons;
+    }
+    return SDL_GetMouseState(x, y);
+}
+
+void NetRecorder::onPacketOut(const IPaddress& to, const uint8_t* data, int len) {
+    if (recordFile) writePacket(REC_PACKET_OUT, to, data, len);
+    else if (replaying) ++replayedPacketsOut;
+}
+
+void NetRecorder::onPacketIn(const IPaddress& from, const uint8_t* data, int len) {
+    if (recordFile) writePacket(REC_PACKET_IN, from, data, len);
+}
+
+int NetRecorder::nextPacketIn(UDPpacket* pkt) {
+    if (framePackets.empty()) return 0;
+    ReplayPacket& rp = framePackets.front();
+    int len = std::min(static_cast<int>(rp.data.size()), pkt->maxlen);
+    std::memcpy(pkt->data, rp.data.data(), len);
+    pkt->len = len;
+    pkt->address = rp.address;
+    framePackets.pop_front();
+    return 1;
+}
+
+void NetRecorder::onStateHash(uint64_t hash) {
+    if (recordFile) {
+        writeRecord(REC_HASH, &hash, sizeof(hash));
+        return;
+    }
+    if (!replaying || !frameHasHash) return;
+    ++hashChecks;
+    if (hash != frameHash) {
+        if (hashMismatches == 0) {
+            SDL_Log("Replay diverged at frame %llu: state hash %016llx, recorded %016llx",
+                static_cast<unsigned long long>(frameIndex), static_cast<unsigned long long>(hash), static_cast<unsigned long long>(frameHash));
+        }
+        ++hashMismatches;
+    }
+}
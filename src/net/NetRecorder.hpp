@@ -0,0 +1,129 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_net.h>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Records a session (frame dt, local input, every datagram in and out, periodic
+// state hashes) to a compact binary log, and plays it back without touching the
+// network. Replays feed the recorded datagrams through netRecv (NetIO.hpp) and
+// the recorded events through pollEvent, so receiveInputs and the client receive
+// path run unchanged; the state hashes tell whether the replay stayed identical.
+//
+// Log layout: ReplayFileHeader, then records of [uint8 type][payload]:
+//   'F' frame      double dt
+//   'E' event      RecordedEvent
+//   'K' keys       uint16 count, uint16 scancodes[count]  (keys held, only when changed)
+//   'M' mouse      int32 x, int32 y, uint32 buttons       (only when changed)
+//   'I'/'O' packet uint32 host, uint16 port, uint16 len, bytes[len]
+//   'H' hash       uint64 state hash for the current frame
+
+#pragma pack(push, 1)
+struct ReplayFileHeader {
+    uint32_t magic; // 'SRPL'
+    uint32_t version;
+    uint32_t sessionSeed;
+    uint32_t worldSeed; // hosts: chunks derive from it (clients learn theirs from the recorded ACPT)
+    uint8_t isHost;
+    uint32_t hostAddrHost; // client recordings: where the host lived (packets are filtered by it)
+    uint16_t hostAddrPort;
+    uint16_t tickRate; // simulation ticks per second; frames are replayed into the same ticks
+};
+
+// The subset of SDL_Event the game reacts to
+struct RecordedEvent {
+    uint32_t type;
+    int32_t sym;
+    uint16_t scancode;
+    uint16_t mod;
+    uint8_t repeat;
+    uint8_t button;
+    uint8_t clicks;
+    int32_t x;
+    int32_t y;
+};
+#pragma pack(pop)
+
+class NetRecorder {
+public:
+    static NetRecorder& instance();
+
+    // Frames between state hashes
+    static constexpr uint32_t HASH_INTERVAL = 30;
+
+    bool startRecording(const std::string& path, uint32_t sessionSeed, uint32_t worldSeed, bool isHost, const IPaddress& hostAddr, uint16_t tickRate);
+    // Loads the whole log; fills in what the session needs to be reconstructed
+    bool startReplay(const std::string& path, uint32_t& sessionSeed, uint32_t& worldSeed, bool& isHost, IPaddress& hostAddr, uint16_t& tickRate);
+    void stop();
+
+    bool isRecording() const { return recordFile != nullptr; }
+    bool isReplaying() const { return replaying; }
+
+    // Call at the top of every frame. Recording stores dt; replay overwrites dt with the
+    // recorded value and returns false once the log is exhausted.
+    bool beginFrame(double& dt);
+
+    // Drop-in for SDL_PollEvent. During replay real events are drained (only SDL_QUIT passes)
+    // and recorded events are returned instead.
+    bool pollEvent(SDL_Event& event);
+    // Call after the event loop so held keys / mouse position are part of the log
+    void captureInputState();
+    // Replay-aware SDL_GetKeyboardState / SDL_GetMouseState
+    const Uint8* keyboardState();
+    Uint32 mouseState(int* x, int* y);
+
+    void onPacketOut(const IPaddress& to, const uint8_t* data, int len);
+    void onPacketIn(const IPaddress& from, const uint8_t* data, int len);
+    // Replay: next recorded incoming datagram of this frame, 0 when there are no more
+    int nextPacketIn(UDPpacket* pkt);
+
+    bool wantsStateHash() const { return (isRecording() || replaying) && frameIndex % HASH_INTERVAL == 0; }
+    void onStateHash(uint64_t hash);
+
+    // Replay results
+    uint64_t getFrameIndex() const { return frameIndex; }
+    uint32_t getHashChecks() const { return hashChecks; }
+    uint32_t getHashMismatches() const { return hashMismatches; }
+    uint64_t getRecordedPacketsOut() const { return recordedPacketsOut; }
+    uint64_t getReplayedPacketsOut() const { return replayedPacketsOut; }
+
+private:
+    NetRecorder() = default;
+    ~NetRecorder();
+
+    struct ReplayPacket {
+        IPaddress address;
+        std::vector<uint8_t> data;
+    };
+
+    void writeRecord(uint8_t type, const void* payload, size_t len);
+    void writePacket(uint8_t type, const IPaddress& addr, const uint8_t* data, int len);
+    bool read(void* out, size_t len);
+
+    FILE* recordFile = nullptr;
+    std::vector<uint8_t> recordBuffer; // batched writes, flushed when large and on stop()
+
+    bool replaying = false;
+    std::vector<uint8_t> log;
+    size_t readPos = 0;
+    std::deque<SDL_Event> frameEvents;
+    std::deque<ReplayPacket> framePackets;
+    bool frameHasHash = false;
+    uint64_t frameHash = 0;
+
+    uint64_t frameIndex = 0;
+    uint32_t hashChecks = 0;
+    uint32_t hashMismatches = 0;
+    uint64_t recordedPacketsOut = 0;
+    uint64_t replayedPacketsOut = 0;
+
+    // Input state: last written (recording) or current (replay)
+    std::vector<Uint8> keys = std::vector<Uint8>(SDL_NUM_SCANCODES, 0);
+    int mouseX = 0;
+    int mouseY = 0;
+    Uint32 mouseButtons = 0;
+};
@@ -0,0 +1,196 @@
+#include "NetSim.hpp"
+#include "NetAddress.hpp"
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+// Named starting points; latency is one way, so RTT is roughly twice the value
+// when both ends run the same profile
+struct NetSimProfile {
+    const char* name;
+    NetSimConfig config;
+};
+
+static NetSimProfile makeProfile(const char* name, float latencyMs, float jitterMs, float loss, float dup, float reorder, float kbps) {
+    NetSimProfile p{name, NetSimConfig{}};
+    p.config.latencyMs = latencyMs;
+    p.config.jitterMs = jitterMs;
+    p.config.lossPercent = loss;
+    p.config.duplicatePercent = dup;
+    p.config.reorderPercent = reorder;
+    p.config.bandwidthKbps = kbps;
+    return p;
+}
+
+static const NetSimProfile PROFILES[] = {
+    // name, latency ms, jitter ms, loss %, dup %, reorder %, kbps
+    makeProfile("lan", 1.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f),
+    makeProfile("wan", 30.0f, 5.0f, 0.5f, 0.0f, 0.2f, 10000.0f),
+    makeProfile("intercontinental", 80.0f, 10.0f, 1.0f, 0.0f, 0.5f, 5000.0f),
+    makeProfile("lte", 45.0f, 20.0f, 1.5f, 0.2f, 1.0f, 3000.0f),
+    makeProfile("bad", 120.0f, 40.0f, 5.0f, 1.0f, 3.0f, 512.0f),
+};
+
+NetSim& NetSim::instance() {
+    static NetSim inst;
+    return inst;
+}
+
+uint64_t NetSim::nowMicros() {
+    static const double toMicros = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    return static_cast<uint64_t>(static_cast<double>(SDL_GetPerformanceCounter()) * toMicros);
+}
+
+bool NetSim::applyProfile(const std::string& name) {
+    for (const NetSimProfile& p : PROFILES) {
+        if (name == p.name) {
+            uint32_t seed = config.seed;
+            config = p.config;
+            config.seed = seed;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NetSim::configure(const std::string& spec) {
+    std::stringstream ss(spec);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        if (token.empty()) continue;
+        size_t eq = token.find('=');
+        if (eq == std::string::npos) {
+            if (!applyProfile(token)) {
+                std::cerr << "Unknown netsim profile '" << token << "' (lan, wan, intercontinental, lte, bad)\n";
+                return false;
+            }
+            continue;
+        }
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+        try {
+            if (key == "latency") config.latencyMs = std::max(0.0f, std::stof(value));
+            else if (key == "jitter") config.jitterMs = std::max(0.0f, std::stof(value));
+            else if (key == "loss") config.lossPercent = std::clamp(std::stof(value), 0.0f, 100.0f);
+            else if (key == "dup") config.duplicatePercent = std::clamp(std::stof(value), 0.0f, 100.0f);
+            else if (key == "reorder") config.reorderPercent = std::clamp(std::stof(value), 0.0f, 100.0f);
+            else if (key == "kbps") config.bandwidthKbps = std::max(0.0f, std::stof(value));
+            else if (key == "queue") config.queueMs = std::max(0.0f, std::stof(value));
+            else if (key == "seed") config.seed = static_cast<uint32_t>(std::stoul(value));
+            else {
+                std::cerr << "Unknown netsim option '" << key << "' (latency, jitter, loss, dup, reorder, kbps, queue, seed)\n";
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Bad value for netsim option '" << key << "': " << value << "\n";
+            return false;
+        }
+    }
+    enabled = true;
+    if (config.seed != 0) rng.seed(config.seed);
+    SDL_Log("Network simulator: %s", describe().c_str());
+    return true;
+}
+
+void NetSim::setSeed(uint32_t seed) {
+    if (config.seed == 0) rng.seed(seed);
+}
+
+bool NetSim::chance(float percent) {
+    return percent > 0.0f && uniform(0.0f, 100.0f) < percent;
+}
+
+float NetSim::uniform(float lo, float hi) {
+    std::uniform_real_distribution<float> dist(lo, hi);
+    return dist(rng);
+}
+
+bool NetSim::laterThan(const Pending& a, const Pending& b) {
+    if (a.deliverAtUs != b.deliverAtUs) return a.deliverAtUs > b.deliverAtUs;
+    return a.order > b.order;
+}
+
+void NetSim::enqueue(UDPsocket sock, const IPaddress& to, const uint8_t* data, int len, uint64_t nowUs) {
+    PeerLink& link = links[{sock, netAddressKey(to)}];
+    uint64_t departUs = nowUs;
+    if (config.bandwidthKbps > 0.0f) {
+        // Serialise onto the per-peer link; a backlog longer than the queue is tail-dropped
+        uint64_t startUs = std::max(nowUs, link.linkFreeAtUs);
+        if (startUs - nowUs > static_cast<uint64_t>(config.queueMs * 1000.0f)) {
+            ++counters.queueDropped;
+            return;
+        }
+        uint64_t txUs = static_cast<uint64_t>(len * 8 * 1000.0f / config.bandwidthKbps);
+        link.linkFreeAtUs = startUs + txUs;
+        departUs = link.linkFreeAtUs;
+    }
+
+    float delayMs = config.latencyMs + (config.jitterMs > 0.0f ? uniform(-config.jitterMs, config.jitterMs) : 0.0f);
+    uint64_t deliverUs = departUs + static_cast<uint64_t>(std::max(0.0f, delayMs) * 1000.0f);
+    if (chance(config.reorderPercent)) {
+        // Held back past its successors, which do not wait for it
+        deliverUs += static_cast<uint64_t>(uniform(10.0f, 10.0f + config.latencyMs + 2.0f * config.jitterMs) * 1000.0f);
+        ++counters.reordered;
+    } else {
+        deliverUs = std::max(deliverUs, link.lastDeliverAtUs);
+        link.lastDeliverAtUs = deliverUs;
+    }
+
+    queue.push_back(Pending{deliverUs, nextOrder++, sock, to, std::vector<uint8_t>(data, data + len)});
+    std::push_heap(queue.begin(), queue.end(), laterThan);
+}
+
+int NetSim::send(UDPsocket sock, UDPpacket* pkt) {
+    if (!enabled) return SDLNet_UDP_Send(sock, -1, pkt);
+    pump();
+    if (chance(config.lossPercent)) {
+        ++counters.dropped;
+        return 1; // the sender cannot tell a lost datagram from a delivered one
+    }
+    uint64_t nowUs = nowMicros();
+    enqueue(sock, pkt->address, pkt->data, pkt->len, nowUs);
+    if (chance(config.duplicatePercent)) {
+        enqueue(sock, pkt->address, pkt->data, pkt->len, nowUs);
+        ++counters.duplicated;
+    }
+    return 1;
+}
+
+void NetSim::transmit(const Pending& p) {
+    UDPpacket out{};
+    out.channel = -1;
+    out.data = const_cast<Uint8*>(p.data.data());
+    out.len = static_cast<int>(p.data.size());
+    out.maxlen = out.len;
+    out.address = p.address;
+    if (SDLNet_UDP_Send(p.socket, -1, &out) > 0) ++counters.sent;
+}
+
+void NetSim::pump() {
+    if (queue.empty()) return;
+    uint64_t nowUs = nowMicros();
+    while (!queue.empty() && queue.front().deliverAtUs <= nowUs) {
+        std::pop_heap(queue.begin(), queue.end(), laterThan);
+        transmit(queue.back());
+        queue.pop_back();
+    }
+}
+
+void NetSim::flush() {
+    std::sort(queue.begin(), queue.end(), [](const Pending& a, const Pending& b) { return laterThan(b, a); });
+    for (const Pending& p : queue) transmit(p);
+    queue.clear();
+}
+
+std::string NetSim::describe() const {
+    std::string rate = config.bandwidthKbps > 0.0f ? std::to_string(static_cast<int>(config.bandwidthKbps)) + " kbps" : "unlimited";
+    char buf[200];
+    std::snprintf(buf, sizeof(buf), "netsim %.0f+/-%.0f ms, loss %.1f%%, dup %.1f%%, reorder %.1f%%, %s | sent %llu lost %llu qdrop %llu queued %zu",
+        config.latencyMs, config.jitterMs, config.lossPercent, config.duplicatePercent, config.reorderPercent,
+        rate.c_str(),
+        static_cast<unsigned long long>(counters.sent), static_cast<unsigned long long>(counters.dropped),
+        static_cast<unsigned long long>(counters.queueDropped), queue.size());
+    return buf;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL_net.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// In-process network condition simulator. Outgoing datagrams are delayed, dropped,
+// duplicated, reordered and rate-limited per link (sending socket and destination)
+// before they reach the socket, so a loopback session behaves like a WAN link without netem/root. Each
+// process shapes its own egress: run host and clients with the same --netsim spec
+// for symmetric conditions (the round trip then sees the latency twice).
+//
+// Spec: a profile name and/or comma-separated key=value overrides, e.g.
+//   --netsim wan
+//   --netsim lte,loss=5
+//   --netsim latency=80,jitter=20,loss=2,dup=1,reorder=5,kbps=512,seed=7
+struct NetSimConfig {
+    float latencyMs = 0.0f; // one-way delay added to every datagram
+    float jitterMs = 0.0f; // +/- uniform variation on top of latency (order is kept unless reordered)
+    float lossPercent = 0.0f;
+    float duplicatePercent = 0.0f;
+    float reorderPercent = 0.0f; // datagrams held back so later ones overtake them
+    float bandwidthKbps = 0.0f; // per-peer link rate, 0 = unlimited
+    float queueMs = 250.0f; // bandwidth backlog beyond this is tail-dropped
+    uint32_t seed = 0; // 0 = keep whatever setSeed() chose
+};
+
+struct NetSimCounters {
+    uint64_t sent = 0; // datagrams that reached the socket (duplicates included)
+    uint64_t dropped = 0; // random loss
+    uint64_t queueDropped = 0; // bandwidth backlog overflow
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;
+};
+
+class NetSim {
+public:
+    static NetSim& instance();
+
+    // Parses a spec (see above); prints the problem and returns false on a bad one
+    bool configure(const std::string& spec);
+    bool isEnabled() const { return enabled; }
+    const NetSimConfig& getConfig() const { return config; }
+    const NetSimCounters& getCounters() const { return counters; }
+    // Seeds the simulator's RNG unless the spec fixed one
+    void setSeed(uint32_t seed);
+
+    // Drop-in for SDLNet_UDP_Send(sock, -1, pkt): queues the datagram (copied) and
+    // returns 1, or sends straight through when disabled
+    int send(UDPsocket sock, UDPpacket* pkt);
+    // Sends every queued datagram whose time has come. Cheap when nothing is due.
+    void pump();
+    // Sends everything still queued right away; call before closing sockets so
+    // goodbyes (DISC) are not lost with the queue
+    void flush();
+
+    // One-line summary for overlays and reports
+    std::string describe() const;
+
+private:
+    NetSim() = default;
+
+    struct Pending {
+        uint64_t deliverAtUs;
+        uint64_t order; // ties broken by queue order
+        UDPsocket socket;
+        IPaddress address;
+        std::vector<uint8_t> data;
+    };
+    struct PeerLink {
+        uint64_t lastDeliverAtUs = 0; // keeps in-order delivery under jitter
+        uint64_t linkFreeAtUs = 0; // when the simulated link finishes the current backlog
+    };
+
+    static uint64_t nowMicros();
+    static bool laterThan(const Pending& a, const Pending& b); // heap order
+    bool applyProfile(const std::string& name);
+    void enqueue(UDPsocket sock, const IPaddress& to, const uint8_t* data, int len, uint64_t nowUs);
+    void transmit(const Pending& p);
+    bool chance(float percent);
+    float uniform(float lo, float hi);
+
+    bool enabled = false;
+    NetSimConfig config;
+    NetSimCounters counters;
+    std::mt19937 rng;
+    std::vector<Pending> queue; // min-heap on (deliverAtUs, order)
+    // Keyed by sending socket and netAddressKey, so every bot socket in one process
+    // gets its own link to the host
+    std::map<std::pair<UDPsocket, uint64_t>, PeerLink> links;
+    uint64_t nextOrder = 0;
+};
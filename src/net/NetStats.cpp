@@ -0,0 +1,275 @@
+#include "NetStats.hpp"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const int MSG_COUNT = static_cast<int>(NetMsg::Count);
+
+const char* netMsgName(NetMsg type) {
+    switch (type) {
+        case NetMsg::Snapshot: return "snapshot";
+        case NetMsg::Input: return "input";
+        case NetMsg::Particle: return "PART";
+        case NetMsg::ParticlePos: return "PPOS";
+        case NetMsg::HookArrival: return "HKAR";
+        case NetMsg::FishSpawn: return "AFSP";
+        case NetMsg::FishRequest: return "AFRQ";
+        case NetMsg::FishProjectile: return "FPRJ";
+        case NetMsg::Daytime: return "DAYT";
+        case NetMsg::Ping: return "PING";
+        case NetMsg::Pong: return "PONG";
+        case NetMsg::Connection: return "conn";
+        default: return "other";
+    }
+}
+
+static std::string formatAddress(const IPaddress& addr) {
+    // SDL_net stores host and port in network byte order
+    uint32_t h = SDL_SwapBE32(addr.host);
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u:%u", (h >> 24) & 0xFF, (h >> 16) & 0xFF, (h >> 8) & 0xFF, h & 0xFF, SDL_SwapBE16(addr.port));
+    return buf;
+}
+
+NetStats& NetStats::instance() {
+    static NetStats inst;
+    return inst;
+}
+
+uint64_t NetStats::nowMicros() {
+    static const double toMicros = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    return static_cast<uint64_t>(static_cast<double>(SDL_GetPerformanceCounter()) * toMicros);
+}
+
+NetMsg NetStats::classifyPacket(const uint8_t* data, int len) const {
+    if (len >= 4) {
+        uint32_t magic;
+        std::memcpy(&magic, data, sizeof(magic));
+        switch (magic) {
+            case MAGIC_PART: return NetMsg::Particle;
+            case MAGIC_PPOS: return NetMsg::ParticlePos;
+            case MAGIC_HKAR: return NetMsg::HookArrival;
+            case MAGIC_AFSP: return NetMsg::FishSpawn;
+            case MAGIC_AFRQ: return NetMsg::FishRequest;
+            case MAGIC_FPRJ: return NetMsg::FishProjectile;
+            case MAGIC_DAYT: return NetMsg::Daytime;
+            case MAGIC_PING: return NetMsg::Ping;
+            case MAGIC_PONG: return NetMsg::Pong;
+            case MAGIC_SNAP: return NetMsg::Snapshot;
+            case MAGIC_CONN: case MAGIC_ACPT: case MAGIC_DISC: return NetMsg::Connection;
+            case MAGIC_INPT: return NetMsg::Input;
+            default: break;
+        }
+    }
+    return NetMsg::Other;
+}
+
+NetPeerStats& NetStats::peer(const IPaddress& addr) {
+    NetPeerStats& p = peers[netAddressKey(addr)];
+    p.address = addr;
+    return p;
+}
+
+void NetStats::onSend(const IPaddress& to, const uint8_t* data, int len) {
+    int t = static_cast<int>(classifyPacket(data, len));
+    NetPeerStats& p = peer(to);
+    p.totalOut[t].bytes += len; ++p.totalOut[t].packets;
+    p.windowOut[t].bytes += len; ++p.windowOut[t].packets;
+}
+
+void NetStats::onRecv(const IPaddress& from, const uint8_t* data, int len) {
+    int t = static_cast<int>(classifyPacket(data, len));
+    NetPeerStats& p = peer(from);
+    p.totalIn[t].bytes += len; ++p.totalIn[t].packets;
+    p.windowIn[t].bytes += len; ++p.windowIn[t].packets;
+}
+
+void NetStats::onPong(const IPaddress& from, const PingPacket& pong) {
+    uint64_t now = nowMicros();
+    if (now < pong.sendTimeUs) return;
+    float rtt = static_cast<float>(now - pong.sendTimeUs) / 1000.0f;
+    NetPeerStats& p = peer(from);
+    if (p.pongs == 0) {
+        p.rttMinMs = rtt;
+    } else {
+        p.jitterMs += (std::fabs(rtt - p.rttMs) - p.jitterMs) / 16.0f;
+        if (rtt < p.rttMinMs) p.rttMinMs = rtt;
+    }
+    p.rttMs = rtt;
+    ++p.pongs;
+}
+
+void NetStats::onSequence(const IPaddress& from, uint32_t seq) {
+    NetPeerStats& p = peer(from);
+    if (!p.hasSeq) {
+        p.hasSeq = true;
+        p.lastSeq = seq;
+        ++p.windowExpected;
+        ++p.windowReceived;
+        return;
+    }
+    int32_t delta = static_cast<int32_t>(seq - p.lastSeq);
+    if (delta <= 0) return; // duplicate or reordered; already counted as missing when skipped
+    p.windowExpected += static_cast<uint32_t>(delta);
+    ++p.windowReceived;
+    p.lastSeq = seq;
+}
+
+void NetStats::setPeerId(const IPaddress& addr, uint32_t id) {
+    peer(addr).peerId = id;
+}
+
+void NetStats::setInputBuffer(const IPaddress& addr, uint32_t depth, uint32_t targetDepth, float jitterMs, uint32_t underruns) {
+    NetPeerStats& p = peer(addr);
+    p.inputDepth = depth;
+    p.inputTargetDepth = targetDepth;
+    p.inputJitterMs = jitterMs;
+    p.inputUnderruns = underruns;
+}
+
+void NetStats::removePeer(const IPaddress& addr) {
+    peers.erase(netAddressKey(addr));
+}
+
+void NetStats::update(float dt) {
+    elapsedSeconds += dt;
+    windowTimer += dt;
+    if (windowTimer >= 1.0f) {
+        float scale = 1.0f / windowTimer;
+        for (auto& [key, p] : peers) {
+            for (int t = 0; t < MSG_COUNT; ++t) {
+                p.rateIn[t].bytes = static_cast<uint64_t>(p.windowIn[t].bytes * scale);
+                p.rateIn[t].packets = static_cast<uint64_t>(p.windowIn[t].packets * scale);
+                p.rateOut[t].bytes = static_cast<uint64_t>(p.windowOut[t].bytes * scale);
+                p.rateOut[t].packets = static_cast<uint64_t>(p.windowOut[t].packets * scale);
+                p.windowIn[t] = NetTraffic{};
+                p.windowOut[t] = NetTraffic{};
+            }
+            if (p.windowExpected > 0) {
+                uint32_t lost = p.windowExpected > p.windowReceived ? p.windowExpected - p.windowReceived : 0;
+                p.lossPercent = 100.0f * static_cast<float>(lost) / static_cast<float>(p.windowExpected);
+            }
+            p.windowExpected = 0;
+            p.windowReceived = 0;
+        }
+        windowTimer = 0.0f;
+        ++windowGeneration;
+    }
+
+    if (!dumpPath.empty()) {
+        dumpTimer += dt;
+        if (dumpTimer >= dumpInterval) {
+            dumpTimer = 0.0f;
+            dumpNow();
+        }
+    }
+}
+
+void NetStats::setDumpPath(const std::string& path, float intervalSeconds) {
+    dumpPath = path;
+    dumpInterval = intervalSeconds > 0.0f ? intervalSeconds : 5.0f;
+    dumpTimer = 0.0f;
+    dumpHeaderWritten = false;
+}
+
+void NetStats::dumpNow() {
+    if (dumpPath.empty()) return;
+    bool asJson = dumpPath.size() >= 5 && dumpPath.compare(dumpPath.size() - 5, 5, ".json") == 0;
+
+    // Truncate on the first dump of the session, append afterwards
+    std::ofstream out(dumpPath, dumpHeaderWritten ? std::ios::app : std::ios::trunc);
+    if (!out) {
+        std::cerr << "Warning: could not open net stats dump '" << dumpPath << "'\n";
+        return;
+    }
+
+    if (asJson) {
+        nlohmann::json frame;
+        frame["time"] = elapsedSeconds;
+        frame["role"] = isHost ? "host" : "client";
+        nlohmann::json peerList = nlohmann::json::array();
+        for (const auto& [key, p] : peers) {
+            nlohmann::json pj;
+            pj["address"] = formatAddress(p.address);
+            pj["peerId"] = p.peerId;
+            pj["rttMs"] = p.rttMs;
+            pj["rttMinMs"] = p.rttMinMs;
+            pj["jitterMs"] = p.jitterMs;
+            pj["lossPercent"] = p.lossPercent;
+            if (isHost) {
+                pj["inputDepth"] = p.inputDepth;
+                pj["inputTargetDepth"] = p.inputTargetDepth;
+                pj["inputJitterMs"] = p.inputJitterMs;
+                pj["inputUnderruns"] = p.inputUnderruns;
+            }
+            nlohmann::json types = nlohmann::json::object();
+            for (int t = 0; t < MSG_COUNT; ++t) {
+                if (p.totalIn[t].packets == 0 && p.totalOut[t].packets == 0) continue;
+                types[netMsgName(static_cast<NetMsg>(t))] = {
+                    {"inBytesPerSec", p.rateIn[t].bytes}, {"inPacketsPerSec", p.rateIn[t].packets},
+                    {"outBytesPerSec", p.rateOut[t].bytes}, {"outPacketsPerSec", p.rateOut[t].packets},
+                    {"inBytesTotal", p.totalIn[t].bytes}, {"outBytesTotal", p.totalOut[t].bytes}
+                };
+            }
+            pj["types"] = types;
+            peerList.push_back(pj);
+        }
+        frame["peers"] = peerList;
+        out << frame.dump() << "\n";
+    } else {
+        if (!dumpHeaderWritten) {
+            out << "time,role,peer,peerId,type,inBytesPerSec,inPacketsPerSec,outBytesPerSec,outPacketsPerSec,inBytesTotal,outBytesTotal,rttMs,jitterMs,lossPercent\n";
+        }
+        for (const auto& [key, p] : peers) {
+            std::string addr = formatAddress(p.address);
+            for (int t = 0; t < MSG_COUNT; ++t) {
+                if (p.totalIn[t].packets == 0 && p.totalOut[t].packets == 0) continue;
+                out << elapsedSeconds << ',' << (isHost ? "host" : "client") << ',' << addr << ',' << p.peerId << ','
+                    << netMsgName(static_cast<NetMsg>(t)) << ','
+                    << p.rateIn[t].bytes << ',' << p.rateIn[t].packets << ','
+                    << p.rateOut[t].bytes << ',' << p.rateOut[t].packets << ','
+                    << p.totalIn[t].bytes << ',' << p.totalOut[t].bytes << ','
+                    << p.rttMs << ',' << p.jitterMs << ',' << p.lossPercent << '\n';
+            }
+        }
+    }
+    dumpHeaderWritten = true;
+}
+
+std::vector<std::string> NetStats::formatOverlay() const {
+    std::vector<std::string> lines;
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "Net (%s) - %zu peer%s", isHost ? "host" : "client", peers.size(), peers.size() == 1 ? "" : "s");
+    lines.push_back(buf);
+    for (const auto& [key, p] : peers) {
+        uint64_t inBytes = 0, outBytes = 0;
+        for (int t = 0; t < MSG_COUNT; ++t) {
+            inBytes += p.rateIn[t].bytes;
+            outBytes += p.rateOut[t].bytes;
+        }
+        std::snprintf(buf, sizeof(buf), "%s id=%u  rtt %.1f ms (min %.1f)  jitter %.1f ms  loss %.1f%%",
+            formatAddress(p.address).c_str(), p.peerId, p.rttMs, p.rttMinMs, p.jitterMs, p.lossPercent);
+        lines.push_back(buf);
+        std::snprintf(buf, sizeof(buf), "  in %.1f kB/s  out %.1f kB/s", inBytes / 1024.0, outBytes / 1024.0);
+        lines.push_back(buf);
+        if (isHost) {
+            std::snprintf(buf, sizeof(buf), "  input buffer %u/%u frames  arrival jitter %.1f ms  underruns %u",
+                p.inputDepth, p.inputTargetDepth, p.inputJitterMs, p.inputUnderruns);
+            lines.push_back(buf);
+        }
+        for (int t = 0; t < MSG_COUNT; ++t) {
+            const NetTraffic& ri = p.rateIn[t];
+            const NetTraffic& ro = p.rateOut[t];
+            if (ri.packets == 0 && ro.packets == 0) continue;
+            std::snprintf(buf, sizeof(buf), "  %-9s in %6.2f kB/s %4u pkt/s   out %6.2f kB/s %4u pkt/s",
+                netMsgName(static_cast<NetMsg>(t)),
+                ri.bytes / 1024.0, static_cast<unsigned>(ri.packets),
+                ro.bytes / 1024.0, static_cast<unsigned>(ro.packets));
+            lines.push_back(buf);
+        }
+    }
+    return lines;
+}
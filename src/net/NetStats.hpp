@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_net.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NetAddress.hpp"
+#include "Packets.hpp"
+
+// Message types we account bandwidth for, keyed off each packet's magic
+// (see NetStats::classifyPacket).
+enum class NetMsg : uint8_t {
+    Snapshot,
+    Input,
+    Particle,
+    ParticlePos,
+    HookArrival,
+    FishSpawn,
+    FishRequest,
+    FishProjectile,
+    Daytime,
+    Ping,
+    Pong,
+    Connection, // CONN / ACPT / DISC handshake
+    Other,
+    Count
+};
+
+const char* netMsgName(NetMsg type);
+
+struct NetTraffic {
+    uint64_t bytes = 0;
+    uint64_t packets = 0;
+};
+
+struct NetPeerStats {
+    IPaddress address{};
+    uint32_t peerId = 0; // client id (host side) or 0 for the host (client side)
+
+    // Lifetime totals and the last completed one-second window, per message type
+    NetTraffic totalIn[static_cast<int>(NetMsg::Count)];
+    NetTraffic totalOut[static_cast<int>(NetMsg::Count)];
+    NetTraffic rateIn[static_cast<int>(NetMsg::Count)];  // per second
+    NetTraffic rateOut[static_cast<int>(NetMsg::Count)]; // per second
+
+    // Latency from PING/PONG round trips
+    float rttMs = 0.0f;
+    float rttMinMs = 0.0f;
+    float jitterMs = 0.0f; // smoothed mean deviation between consecutive RTT samples (RFC 3550 style)
+    uint32_t pongs = 0;
+
+    // Loss from gaps in the peer's sequence stream (input seq on the host, snapshot tick on clients)
+    float lossPercent = 0.0f;
+
+    // Host only: the client's input jitter buffer (InputBuffer.hpp)
+    uint32_t inputDepth = 0;
+    uint32_t inputTargetDepth = 0;
+    float inputJitterMs = 0.0f;
+    uint32_t inputUnderruns = 0;
+
+private:
+    friend class NetStats;
+    NetTraffic windowIn[static_cast<int>(NetMsg::Count)];
+    NetTraffic windowOut[static_cast<int>(NetMsg::Count)];
+    bool hasSeq = false;
+    uint32_t lastSeq = 0;
+    uint32_t windowExpected = 0;
+    uint32_t windowReceived = 0;
+};
+
+// Per-peer network counters for host and client. All datagrams should go through
+// netSend/netRecv (NetIO.hpp) so they are accounted here.
+class NetStats {
+public:
+    static NetStats& instance();
+    // Clock used for PingPacket::sendTimeUs
+    static uint64_t nowMicros();
+
+    // Role shown in the overlay and dumps
+    void setIsHost(bool host) { isHost = host; }
+    NetMsg classifyPacket(const uint8_t* data, int len) const;
+
+    void onSend(const IPaddress& to, const uint8_t* data, int len);
+    void onRecv(const IPaddress& from, const uint8_t* data, int len);
+    void onPong(const IPaddress& from, const PingPacket& pong);
+    // Feed a per-peer monotonically increasing sequence number to estimate loss
+    void onSequence(const IPaddress& from, uint32_t seq);
+    void setPeerId(const IPaddress& addr, uint32_t id);
+    void setInputBuffer(const IPaddress& addr, uint32_t depth, uint32_t targetDepth, float jitterMs, uint32_t underruns);
+    void removePeer(const IPaddress& addr);
+
+    // Call once per frame; rolls the one-second rate windows and writes periodic dumps
+    void update(float dt);
+
+    // Periodic dump: ".json" paths get one JSON object per line, anything else CSV rows
+    void setDumpPath(const std::string& path, float intervalSeconds);
+    void dumpNow();
+
+    const std::unordered_map<uint64_t, NetPeerStats>& getPeers() const { return peers; }
+    // Human readable summary for the debug overlay, one string per line
+    std::vector<std::string> formatOverlay() const;
+    // Incremented whenever the rate window rolls, so the overlay knows when to re-render
+    uint32_t getWindowGeneration() const { return windowGeneration; }
+
+private:
+    NetStats() = default;
+
+    NetPeerStats& peer(const IPaddress& addr);
+
+    std::unordered_map<uint64_t, NetPeerStats> peers;
+    bool isHost = false;
+    float windowTimer = 0.0f;
+    float elapsedSeconds = 0.0f;
+    uint32_t windowGeneration = 0;
+
+    std::string dumpPath;
+    float dumpInterval = 5.0f;
+    float dumpTimer = 0.0f;
+    bool dumpHeaderWritten = false;
+};
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstdint>
+
+// Wire formats shared by the game (host/client) and the headless tools.
+// Every packet starts with a four-character magic packed little-endian (e.g. 'PING' -> 0x474E4950).
+
+// Largest datagram we send. Stays under the common 1280-byte IPv6 minimum MTU
+// so nothing gets fragmented at the IP layer; receive buffers use the same size.
+constexpr int NET_MTU = 1200;
+
+constexpr uint32_t MAGIC_PART = 0x54524150; // 'PART' seeded attract particles (host -> clients)
+constexpr uint32_t MAGIC_PPOS = 0x534F5050; // 'PPOS' explicit particle start positions (host -> clients)
+constexpr uint32_t MAGIC_HKAR = 0x52414B48; // 'HKAR' authoritative hook arrival (host -> clients)
+constexpr uint32_t MAGIC_AFSP = 0x50534641; // 'AFSP' attacking fish spawn (host -> clients)
+constexpr uint32_t MAGIC_AFRQ = 0x51524641; // 'AFRQ' attacking fish request (client -> host)
+constexpr uint32_t MAGIC_FPRJ = 0x4A525046; // 'FPRJ' fish projectile spawn (host -> clients)
+constexpr uint32_t MAGIC_DAYT = 0x54415944; // 'DAYT' day/night sync (host -> client)
+constexpr uint32_t MAGIC_PING = 0x474E4950; // 'PING' latency probe (either direction)
+constexpr uint32_t MAGIC_PONG = 0x474E4F50; // 'PONG' latency probe echo
+constexpr uint32_t MAGIC_SNAP = 0x50414E53; // 'SNAP' snapshot part (host -> clients)
+constexpr uint32_t MAGIC_CONN = 0x4E4E4F43; // 'CONN' connect request (client -> host)
+constexpr uint32_t MAGIC_ACPT = 0x54504341; // 'ACPT' connect accepted, carries the assigned id (host -> client)
+constexpr uint32_t MAGIC_DISC = 0x43534944; // 'DISC' disconnect notice (either direction)
+constexpr uint32_t MAGIC_INPT = 0x54504E49; // 'INPT' redundant input frames (client -> host)
+
+// Bump whenever a wire format changes; the host rejects mismatched clients
+constexpr uint32_t NET_PROTOCOL_VERSION = 3;
+// Bump whenever generateInitialEnvironment produces different objects for the same seed;
+// clients can only share the host's world when both run the same generator
+constexpr uint32_t WORLD_GENERATOR_VERSION = 1;
+// A peer we have not heard from (any packet, including PING) for this long is dropped
+constexpr float NET_TIMEOUT_SECONDS = 5.0f;
+// Id the client uses before the host has assigned one
+constexpr uint32_t INVALID_CLIENT_ID = 0xFFFFFFFFu;
+
+#pragma pack(push, 1)
+struct ParticlePacket {
+    uint32_t magic; // 'PART'
+    uint32_t ownerId;
+    uint32_t seed;
+    float startX;
+    float startY;
+    float destX;
+    float destY;
+    float delay; // seconds until spawn (host-determined)
+    uint8_t count;
+    float duration;
+    int32_t zIndex;
+    float spread;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+struct HookArrivalPacket {
+    uint32_t magic; // 'HKAR'
+    uint32_t ownerId;
+    float x;
+    float y;
+};
+#pragma pack(pop)
+
+// AttackingFish spawn packet (host -> clients)
+#pragma pack(push, 1)
+struct AttackingFishSpawnPacket {
+    uint32_t magic; // 'AFSP'
+    uint32_t entityId;
+    uint32_t ownerId; // player who triggered/spawned this fish
+    float x;
+    float y;
+};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+struct AttackingFishRequestPacket {
+    uint32_t magic; // 'AFRQ' client->host request
+    uint32_t ownerId; // requesting player's id
+    float x;
+    float y;
+};
+#pragma pack(pop)
+
+// Fish projectile spawn packet (host -> clients)
+#pragma pack(push, 1)
+struct FishProjectileSpawnPacket {
+    uint32_t magic; // 'FPRJ'
+    uint32_t projectileId;
+    uint32_t ownerEntityId;
+    uint32_t targetPlayerId; // 0 = host, others = client IDs
+    float startX;
+    float startY;
+};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+struct DaytimePacket {
+    uint32_t magic; // 'DAYT'
+    float dayTimeSeconds; // current time of day (seconds since cycle start)
+    float cycleDurationSeconds; // seconds per full day-night cycle
+};
+#pragma pack(pop)
+
+// Header for packet containing explicit particle start positions
+#pragma pack(push, 1)
+struct ParticlePositionsHeader {
+    uint32_t magic; // 'PPOS'
+    uint32_t ownerId;
+    float delay; // seconds until spawn
+    uint8_t count; // number of particle start positions
+    float duration; // particle lifetime
+    int32_t zIndex;
+    float destX;
+    float destY;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+struct ParticlePos {
+    float sx;
+    float sy;
+};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+// One frame of client input. Edge-triggered fields (boardBoat, toggleBoatMovement,
+// toggleHook, mouseDown, equipAction, fireWeapon) are set only on the frame the
+// action happened.
+struct InputFrame {
+    uint8_t moveFlags; // bits: 0=up, 1=down, 2=left, 3=right
+    uint8_t boardBoat; // 0=no action, 1=toggle boarding
+    uint8_t toggleBoatMovement; // 0=no action, 1=toggle start/stop
+    uint8_t hasBoatControl; // 0=no, 1=has navigation direction update
+    uint8_t toggleHook; // 0=no action, 1=toggle hook
+    float boatNavDirX;
+    float boatNavDirY;
+    uint8_t mouseDown; // 0 = none, 1 = left click
+    int32_t mouseX;
+    int32_t mouseY;
+    int32_t hookTargetX;
+    int32_t hookTargetY;
+    int32_t hookStartX;
+    int32_t hookStartY;
+
+    uint8_t equipAction; // 0 = none, 1 = equip rod, 2 = equip harpoon
+    uint8_t fireWeapon; // 0 = none, 1 = fire weapon (harpoon)
+    int32_t weaponTargetX;
+    int32_t weaponTargetY;
+};
+
+// Input datagram: the newest frameCount frames, newest first, frame i having
+// sequence latestSeq - i. Frame 0 is sent whole; each older frame is a uint32
+// field mask followed by the fields that differ from the frame before it (see
+// InputFrames.cpp). A lost datagram costs nothing as long as one of the next
+// INPUT_REDUNDANCY - 1 arrives; the host applies only sequences it has not seen.
+struct InputPacketHeader {
+    uint32_t magic; // 'INPT'
+    uint32_t clientId;
+    uint32_t latestSeq;
+    uint8_t frameCount;
+};
+
+constexpr int INPUT_REDUNDANCY = 8;
+
+struct BoatState {
+    float x, y;
+    float rotation;
+    float navDirX, navDirY;
+    uint8_t isMoving;
+};
+
+struct PlayerState {
+    uint32_t id;
+    float x, y;
+    float vx, vy;  // velocity
+    uint8_t animFrame;
+    uint8_t isOnBoat; // 0 = not on boat, 1 = on boat
+    uint8_t isHooking; // 0 = not hooking, 1 = hooking
+    uint8_t fishingHookActive; // 0 = not active, 1 = active
+    float fishingHookX, fishingHookY; // world position of hook
+    float fishingHookTargetX, fishingHookTargetY; // mouse destination
+
+    // Equipment & projectile (harpoon) state
+    uint8_t equipment; // 0=none, 1=rod, 2=harpoon
+    uint8_t projectileActive; // 0 = not active, 1 = active
+    float projectileX, projectileY; // world position of projectile
+    float projectileTargetX, projectileTargetY; // projectile destination
+
+    // Health
+    float hp;
+    float maxHp;
+};
+
+// Snapshots are split into self-contained parts that each fit in NET_MTU bytes
+// (see Snapshot.hpp). Part 0 carries the boat; every part carries its own players.
+struct SnapshotHeader {
+    uint32_t magic; // 'SNAP'
+    uint32_t tick;
+    uint16_t partIndex;
+    uint16_t partCount;
+    uint16_t playerCount; // players in this part
+    uint8_t hasBoat;
+};
+#pragma pack(pop)
+
+// Latency probe. The receiver echoes the packet back unchanged except for the
+// magic ('PING' -> 'PONG'), so sendTimeUs is only meaningful to the sender.
+#pragma pack(push, 1)
+struct PingPacket {
+    uint32_t magic; // 'PING' or 'PONG'
+    uint32_t clientId;
+    uint32_t seq;
+    uint64_t sendTimeUs;
+};
+#pragma pack(pop)
+
+// Session handshake. The client repeats CONN until it receives ACPT; the nonce
+// lets the host recognise a retransmit (same nonce -> same id) versus a client
+// that restarted on the same address (new nonce -> new session).
+#pragma pack(push, 1)
+struct ConnectPacket {
+    uint32_t magic; // 'CONN'
+    uint32_t protocolVersion;
+    uint32_t nonce;
+};
+
+struct AcceptPacket {
+    uint32_t magic; // 'ACPT'
+    uint32_t nonce; // echoed from CONN
+    uint32_t clientId; // server-assigned, never 0 (the host)
+    uint32_t worldSeed; // chunks derive from this (see chunkSeed in main.cpp)
+    uint32_t generatorVersion; // WORLD_GENERATOR_VERSION of the host
+};
+
+enum DisconnectReason : uint8_t {
+    DISCONNECT_QUIT = 0,
+    DISCONNECT_TIMEOUT = 1,
+    DISCONNECT_VERSION_MISMATCH = 2,
+    DISCONNECT_HOST_SHUTDOWN = 3,
+};
+
+struct DisconnectPacket {
+    uint32_t magic; // 'DISC'
+    uint32_t clientId; // the peer that left (host -> clients), or the sender (client -> host)
+    uint8_t reason; // DisconnectReason
+};
+#pragma pack(pop)
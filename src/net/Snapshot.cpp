@@ -0,0 +1,88 @@
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <cstring>
+
+size_t snapshotPlayersPerPart(size_t mtu, bool withBoat) {
+    size_t overhead = sizeof(SnapshotHeader) + (withBoat ? sizeof(BoatState) : 0);
+    if (mtu <= overhead) return 0;
+    return (mtu - overhead) / sizeof(PlayerState);
+}
+
+std::vector<std::vector<uint8_t>> buildSnapshotParts(uint32_t tick, const BoatState* boat,
+                                                     const std::vector<PlayerState>& players,
+                                                     size_t mtu) {
+    std::vector<std::vector<uint8_t>> parts;
+    const size_t firstCapacity = snapshotPlayersPerPart(mtu, boat != nullptr);
+    const size_t restCapacity = snapshotPlayersPerPart(mtu, false);
+    if (restCapacity == 0) return parts;
+
+    // Work out how many parts we need so every header can carry the final count
+    size_t partCount = 1;
+    if (players.size() > firstCapacity) {
+        partCount += (players.size() - firstCapacity + restCapacity - 1) / restCapacity;
+    }
+
+    size_t next = 0;
+    for (size_t partIndex = 0; partIndex < partCount; ++partIndex) {
+        bool withBoat = (partIndex == 0 && boat != nullptr);
+        size_t capacity = (partIndex == 0) ? firstCapacity : restCapacity;
+        size_t count = std::min(capacity, players.size() - next);
+
+        SnapshotHeader header{};
+        header.magic = MAGIC_SNAP;
+        header.tick = tick;
+        header.partIndex = static_cast<uint16_t>(partIndex);
+        header.partCount = static_cast<uint16_t>(partCount);
+        header.playerCount = static_cast<uint16_t>(count);
+        header.hasBoat = withBoat ? 1 : 0;
+
+        std::vector<uint8_t> buf(sizeof(header) + (withBoat ? sizeof(BoatState) : 0) + count * sizeof(PlayerState));
+        size_t offset = 0;
+        std::memcpy(buf.data(), &header, sizeof(header));
+        offset += sizeof(header);
+        if (withBoat) {
+            std::memcpy(buf.data() + offset, boat, sizeof(BoatState));
+            offset += sizeof(BoatState);
+        }
+        if (count > 0) {
+            std::memcpy(buf.data() + offset, players.data() + next, count * sizeof(PlayerState));
+        }
+        next += count;
+        parts.push_back(std::move(buf));
+    }
+    return parts;
+}
+
+bool parseSnapshotPart(const uint8_t* data, size_t len, SnapshotPart& out) {
+    if (len < sizeof(SnapshotHeader)) return false;
+    std::memcpy(&out.header, data, sizeof(SnapshotHeader));
+    if (out.header.magic != MAGIC_SNAP) return false;
+    if (out.header.partIndex >= out.header.partCount) return false;
+
+    size_t offset = sizeof(SnapshotHeader);
+    if (out.header.hasBoat) {
+        if (len < offset + sizeof(BoatState)) return false;
+        std::memcpy(&out.boat, data + offset, sizeof(BoatState));
+        offset += sizeof(BoatState);
+    }
+
+    size_t expected = offset + static_cast<size_t>(out.header.playerCount) * sizeof(PlayerState);
+    if (len < expected) return false;
+    out.players.resize(out.header.playerCount);
+    if (out.header.playerCount > 0) {
+        std::memcpy(out.players.data(), data + offset, out.header.playerCount * sizeof(PlayerState));
+    }
+    return true;
+}
+
+bool SnapshotTickFilter::accept(uint32_t tick) {
+    if (haveTick && static_cast<int32_t>(tick - latestTick) < 0) return false; // wraps with the tick counter
+    haveTick = true;
+    latestTick = tick;
+    return true;
+}
+
+void SnapshotTickFilter::reset() {
+    haveTick = false;
+    latestTick = 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Packets.hpp"
+
+// One decoded snapshot datagram. Parts are independent: a client can apply any
+// part on its own, so losing one part only delays the players it carried.
+struct SnapshotPart {
+    SnapshotHeader header{};
+    BoatState boat{};
+    std::vector<PlayerState> players;
+};
+
+// Maximum number of players that fit in one part of the given size
+size_t snapshotPlayersPerPart(size_t mtu, bool withBoat);
+
+// Split a full snapshot into datagrams no larger than mtu. The boat rides in part 0;
+// players keep their order, so put the most relevant ones (e.g. the host) first.
+std::vector<std::vector<uint8_t>> buildSnapshotParts(uint32_t tick, const BoatState* boat,
+                                                     const std::vector<PlayerState>& players,
+                                                     size_t mtu = NET_MTU);
+
+// Decode one datagram. Returns false if it is not a well-formed snapshot part.
+bool parseSnapshotPart(const uint8_t* data, size_t len, SnapshotPart& out);
+
+// Client: drops snapshot parts older than the newest tick applied. Ticks restart
+// low in a new session, so reset it whenever the session ends.
+class SnapshotTickFilter {
+public:
+    // True if a part of this tick should be applied (not older than the newest seen)
+    bool accept(uint32_t tick);
+    void reset();
+
+private:
+    uint32_t latestTick = 0;
+    bool haveTick = false;
+};
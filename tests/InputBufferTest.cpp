@@ -0,0 +1,202 @@
+// InputJitterBuffer under simulated network conditions: a client sends one
+// INPT datagram per frame (INPUT_REDUNDANCY frames each) and the host reads
+// whatever has arrived before each 60 Hz tick, then consumes one frame.
+// Every 7th frame carries a click; each check requires that every click is
+// applied exactly once and in order.
+//
+//   StrandedInputBufferTest          # exit code 0 when every case passes
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "net/InputBuffer.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            std::printf("  FAIL %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+            std::printf(__VA_ARGS__);                            \
+            std::printf("\n");                                   \
+            ++failures;                                          \
+        }                                                        \
+    } while (0)
+
+struct LinkConditions {
+    double sendHz = 60.0;
+    double latencyMs = 40.0;
+    double jitterMs = 0.0;  // uniform extra delay, so datagrams can overtake each other
+    double lossPercent = 0.0;
+    double seconds = 30.0;
+};
+
+struct RunResult {
+    std::set<uint32_t> clicksSent;    // sequences with a click, old enough to have been played
+    std::multiset<uint32_t> clicksApplied;
+    uint32_t ticks = 0;
+    uint32_t applied = 0;
+    uint32_t maxDepthLate = 0;  // deepest the buffer got in the second half
+    bool inOrder = true;
+    InputJitterBuffer buffer;
+};
+
+static InputFrame frameFor(uint32_t seq) {
+    InputFrame f{};
+    f.moveFlags = static_cast<uint8_t>(seq & 0xF);
+    if (seq % 7 == 0) {
+        f.mouseDown = 1;
+        f.mouseX = static_cast<int32_t>(seq);
+    }
+    return f;
+}
+
+static RunResult run(const LinkConditions& link, uint32_t seed) {
+    struct Datagram {
+        double arrival;
+        uint32_t latestSeq;
+    };
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double tickSeconds = 1.0 / 60.0;
+
+    std::vector<Datagram> inFlight;
+    uint32_t sent = 0;
+    RunResult r;
+    int32_t lastClick = -1;
+    for (double now = 0.0; now < link.seconds; now += tickSeconds) {
+        // Client: one datagram per send interval up to now
+        while (sent / link.sendHz <= now) {
+            ++sent;
+            if (unit(rng) * 100.0 < link.lossPercent) continue;
+            double delay = (link.latencyMs + unit(rng) * link.jitterMs) / 1000.0;
+            inFlight.push_back({sent / link.sendHz + delay, sent});
+        }
+        // Host: read what arrived in arrival order, then run one tick
+        std::sort(inFlight.begin(), inFlight.end(), [](const Datagram& a, const Datagram& b) { return a.arrival < b.arrival; });
+        size_t delivered = 0;
+        for (; delivered < inFlight.size() && inFlight[delivered].arrival <= now; ++delivered) {
+            uint32_t latest = inFlight[delivered].latestSeq;
+            std::vector<InputFrame> frames;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(INPUT_REDUNDANCY) && i < latest; ++i) frames.push_back(frameFor(latest - i));
+            r.buffer.receive(latest, frames, now);
+        }
+        inFlight.erase(inFlight.begin(), inFlight.begin() + delivered);
+
+        InputFrame out;
+        if (r.buffer.consume(out, static_cast<float>(tickSeconds))) {
+            ++r.applied;
+            if (out.mouseDown) {
+                if (out.mouseX <= lastClick) r.inOrder = false;
+                lastClick = out.mouseX;
+                r.clicksApplied.insert(static_cast<uint32_t>(out.mouseX));
+            }
+        }
+        ++r.ticks;
+        if (now > link.seconds / 2) r.maxDepthLate = std::max(r.maxDepthLate, r.buffer.getDepth());
+    }
+    // Clicks the host has had a second to play out
+    for (uint32_t seq = 1; seq + static_cast<uint32_t>(link.sendHz) < sent; ++seq) {
+        if (seq % 7 == 0) r.clicksSent.insert(seq);
+    }
+    return r;
+}
+
+static void checkClicks(const RunResult& r) {
+    uint32_t missing = 0, duplicated = 0;
+    for (uint32_t seq : r.clicksSent) {
+        size_t n = r.clicksApplied.count(seq);
+        if (n == 0) ++missing;
+        if (n > 1) ++duplicated;
+    }
+    CHECK(missing == 0, "%u of %zu clicks never applied", missing, r.clicksSent.size());
+    CHECK(duplicated == 0, "%u clicks applied twice", duplicated);
+    CHECK(r.inOrder, "clicks applied out of order");
+}
+
+static void testSteady() {
+    std::printf("steady 60 Hz link\n");
+    RunResult r = run(LinkConditions{}, 1);
+    checkClicks(r);
+    CHECK(r.buffer.getUnderruns() <= 2, "%u underruns", r.buffer.getUnderruns());
+    CHECK(r.applied + 10 >= r.ticks, "%u frames applied in %u ticks", r.applied, r.ticks);
+}
+
+static void testJitter() {
+    for (double jitter : {10.0, 40.0, 80.0}) {
+        std::printf("jitter %.0f ms\n", jitter);
+        LinkConditions link;
+        link.jitterMs = jitter;
+        RunResult r = run(link, 2);
+        checkClicks(r);
+        // The target depth covers the jitter, so once settled the buffer rarely runs dry
+        CHECK(r.buffer.getTargetDepth() >= 1 + static_cast<uint32_t>(jitter / 1000.0 * 60.0 / 2.0),
+              "target depth %u too shallow for %.0f ms", r.buffer.getTargetDepth(), jitter);
+        CHECK(r.applied * 100 >= r.ticks * 90, "%u frames applied in %u ticks", r.applied, r.ticks);
+    }
+}
+
+static void testLoss() {
+    for (double loss : {5.0, 20.0}) {
+        std::printf("loss %.0f%% with 20 ms jitter\n", loss);
+        LinkConditions link;
+        link.jitterMs = 20.0;
+        link.lossPercent = loss;
+        RunResult r = run(link, 3);
+        // Redundancy brings back every frame unless INPUT_REDUNDANCY datagrams in a row are lost
+        checkClicks(r);
+    }
+}
+
+static void testClientAhead() {
+    std::printf("client running 5%% fast\n");
+    LinkConditions link;
+    link.sendHz = 63.0;
+    link.seconds = 60.0;
+    RunResult r = run(link, 4);
+    checkClicks(r);
+    // Without catching up the buffer would be about 180 frames deep by the end
+    CHECK(r.maxDepthLate <= r.buffer.getTargetDepth() + 8, "buffer %u deep (target %u)", r.maxDepthLate, r.buffer.getTargetDepth());
+    CHECK(r.buffer.getSkipped() > 0, "no frames skipped");
+}
+
+static void testOverflow() {
+    std::printf("overflow while the host is stalled\n");
+    InputJitterBuffer buffer;
+    // 400 frames arrive before the host applies any, every other one a click
+    std::set<int32_t> clicks;
+    for (uint32_t latest = 1; latest <= 400; ++latest) {
+        InputFrame f{};
+        if (latest % 2 == 0) {
+            f.mouseDown = 1;
+            f.mouseX = static_cast<int32_t>(latest);
+            clicks.insert(static_cast<int32_t>(latest));
+        }
+        buffer.receive(latest, {f}, latest / 60.0);
+    }
+    CHECK(buffer.getDepth() <= 256, "%u frames buffered", buffer.getDepth());
+    std::set<int32_t> applied;
+    InputFrame out;
+    for (int tick = 0; tick < 1000; ++tick) {
+        // InputFrame is packed, so copy the field before binding it to a reference
+        if (buffer.consume(out, 1.0f / 60.0f) && out.mouseDown) applied.insert(static_cast<int32_t>(out.mouseX));
+    }
+    CHECK(applied == clicks, "%zu of %zu clicks applied", applied.size(), clicks.size());
+}
+
+int main() {
+    testSteady();
+    testJitter();
+    testLoss();
+    testClientAhead();
+    testOverflow();
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all input buffer checks passed\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Snapshot parts and the client's stale-tick filter: parts round-trip through
+// build/parse, older ticks are dropped within a session, and a reset (the
+// client reconnecting, or the host restarting) accepts low ticks again.
+//
+//   StrandedSnapshotTest             # exit code 0 when every case passes
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "net/Snapshot.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            std::printf("  FAIL %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+            std::printf(__VA_ARGS__);                            \
+            std::printf("\n");                                   \
+            ++failures;                                          \
+        }                                                        \
+    } while (0)
+
+static void testRoundTrip() {
+    std::printf("parts round-trip\n");
+    std::vector<PlayerState> players(40);
+    for (size_t i = 0; i < players.size(); ++i) players[i].id = static_cast<uint32_t>(i + 1);
+    BoatState boat{};
+    boat.x = 12.5f;
+    std::vector<std::vector<uint8_t>> parts = buildSnapshotParts(77, &boat, players, 512);
+    CHECK(parts.size() > 1, "%zu parts for %zu players in 512 bytes", parts.size(), players.size());
+    size_t seen = 0;
+    for (const std::vector<uint8_t>& bytes : parts) {
+        SnapshotPart part;
+        CHECK(bytes.size() <= 512, "part of %zu bytes", bytes.size());
+        CHECK(parseSnapshotPart(bytes.data(), bytes.size(), part), "part did not parse");
+        CHECK(part.header.tick == 77, "tick %u", part.header.tick);
+        for (const PlayerState& p : part.players) {
+            CHECK(p.id == seen + 1, "player %u out of order (expected %zu)", p.id, seen + 1);
+            ++seen;
+        }
+    }
+    CHECK(seen == players.size(), "%zu of %zu players decoded", seen, players.size());
+}
+
+static void testStaleTicks() {
+    std::printf("stale ticks within a session\n");
+    SnapshotTickFilter filter;
+    CHECK(filter.accept(500), "first tick dropped");
+    CHECK(filter.accept(500), "second part of the same tick dropped");
+    CHECK(!filter.accept(499), "older tick applied");
+    CHECK(filter.accept(501), "newer tick dropped");
+    // The tick counter wraps; a tick just past the wrap is still newer
+    SnapshotTickFilter wrapping;
+    CHECK(wrapping.accept(0xFFFFFFF0u), "tick before the wrap dropped");
+    CHECK(wrapping.accept(3), "tick after the wrap dropped");
+    CHECK(!wrapping.accept(0xFFFFFFF8u), "tick from before the wrap applied after it");
+}
+
+static void testReconnect() {
+    std::printf("reconnect to a restarted host\n");
+    SnapshotTickFilter filter;
+    for (uint32_t tick = 1; tick <= 5000; ++tick) filter.accept(tick);
+    // Without a reset the new session's low ticks all look stale and the client freezes
+    CHECK(!filter.accept(10), "low tick applied before the reset");
+    filter.reset();
+    uint32_t accepted = 0;
+    for (uint32_t tick = 1; tick <= 100; ++tick) accepted += filter.accept(tick) ? 1 : 0;
+    CHECK(accepted == 100, "%u of 100 ticks accepted after reconnecting", accepted);
+    CHECK(!filter.accept(50), "stale tick applied in the new session");
+}
+
+int main() {
+    testRoundTrip();
+    testStaleTicks();
+    testReconnect();
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all snapshot checks passed\n");
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Cooks the game's loose assets into one asset pack (see core/AssetPack.hpp):
+// sprites decoded to ARGB8888, their hitboxes detected up front and sounds
+// converted to the mixer's output format, so the game loads them without
+// decoding anything.
+//
+//   StrandedAssetCooker                         # ./sprites, ./sounds -> assets.spak
+//   StrandedAssetCooker --root .. --out build/assets.spak
+//
+// The Stranded build runs it after linking and puts the pack next to the executable.
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/AssetPack.hpp"
+#include "core/JobSystem.hpp"
+#include "game/ICollidable.hpp"
+
+// SoundManager::init defaults; the game plays cooked sounds only when the mixer opened with these
+constexpr int COOK_SOUND_FREQUENCY = 44100;
+constexpr SDL_AudioFormat COOK_SOUND_FORMAT = AUDIO_S16SYS;
+constexpr int COOK_SOUND_CHANNELS = 2;
+constexpr int COOK_MIN_CLUSTER_SIZE = 50; // ICollidable's default
+
+struct CookedAsset {
+    std::string name;
+    AssetPackType type;
+    uint32_t params[3] = {0, 0, 0};
+    std::vector<uint8_t> data;
+
+    CookedAsset(std::string name, AssetPackType type) : name(std::move(name)), type(type) {}
+};
+
+static std::vector<std::filesystem::path> listFiles(const std::filesystem::path& dir, const char* extension) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == extension) files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end()); // same pack for the same files
+    return files;
+}
+
+static bool cookSprite(const std::filesystem::path& file, const std::string& name, std::vector<CookedAsset>& out) {
+    const std::string path = file.string();
+    SDL_Surface* loaded = SDL_LoadBMP(path.c_str());
+    SDL_Surface* surface = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+    if (loaded) SDL_FreeSurface(loaded);
+    if (!surface) {
+        std::fprintf(stderr, "Warning: skipping sprite '%s': %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+    CookedAsset sprite(name, ASSET_SPRITE);
+    sprite.params[0] = static_cast<uint32_t>(surface->w);
+    sprite.params[1] = static_cast<uint32_t>(surface->h);
+    const size_t rowBytes = static_cast<size_t>(surface->w) * 4;
+    sprite.data.resize(rowBytes * surface->h);
+    SDL_LockSurface(surface);
+    for (int y = 0; y < surface->h; ++y) {
+        std::memcpy(sprite.data.data() + y * rowBytes, static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch, rowBytes);
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+    out.push_back(std::move(sprite));
+
+    // Detected from the image as the game would load it, so packed and loose hitboxes match
+    if (SDL_Surface* image = IMG_Load(path.c_str())) {
+        CookedAsset hitboxes(name, ASSET_HITBOXES);
+        hitboxes.params[0] = static_cast<uint32_t>(image->w);
+        hitboxes.params[1] = static_cast<uint32_t>(image->h);
+        hitboxes.params[2] = COOK_MIN_CLUSTER_SIZE;
+        std::vector<Rectangle> boxes = ICollidable::autoDetectHitboxes(image, COOK_MIN_CLUSTER_SIZE);
+        SDL_FreeSurface(image);
+        hitboxes.data.resize(boxes.size() * 4 * sizeof(float));
+        float* dst = reinterpret_cast<float*>(hitboxes.data.data());
+        for (const Rectangle& box : boxes) {
+            *dst++ = box.begin.x;
+            *dst++ = box.begin.y;
+            *dst++ = box.end.x;
+            *dst++ = box.end.y;
+        }
+        out.push_back(std::move(hitboxes));
+    }
+    return true;
+}
+
+static bool cookSound(const std::filesystem::path& file, const std::string& name, std::vector<CookedAsset>& out) {
+    const std::string path = file.string();
+    SDL_AudioSpec spec;
+    Uint8* buffer = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(path.c_str(), &spec, &buffer, &length)) {
+        std::fprintf(stderr, "Warning: skipping sound '%s': %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, COOK_SOUND_FORMAT, COOK_SOUND_CHANNELS, COOK_SOUND_FREQUENCY) < 0) {
+        std::fprintf(stderr, "Warning: skipping sound '%s': %s\n", path.c_str(), SDL_GetError());
+        SDL_FreeWAV(buffer);
+        return false;
+    }
+    CookedAsset sound(name, ASSET_SOUND);
+    sound.params[0] = COOK_SOUND_FREQUENCY;
+    sound.params[1] = COOK_SOUND_FORMAT;
+    sound.params[2] = COOK_SOUND_CHANNELS;
+    sound.data.resize(static_cast<size_t>(length) * std::max(1, cvt.len_mult));
+    std::memcpy(sound.data.data(), buffer, length);
+    SDL_FreeWAV(buffer);
+    cvt.buf = sound.data.data();
+    cvt.len = static_cast<int>(length);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        std::fprintf(stderr, "Warning: skipping sound '%s': %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+    sound.data.resize(cvt.needed ? static_cast<size_t>(cvt.len_cvt) : length);
+    out.push_back(std::move(sound));
+    return true;
+}
+
+static bool writePack(const std::string& outPath, const std::vector<CookedAsset>& assets) {
+    std::vector<AssetPackEntry> table(assets.size());
+    uint64_t offset = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * assets.size();
+    for (size_t i = 0; i < assets.size(); ++i) {
+        AssetPackEntry& e = table[i];
+        std::memset(&e, 0, sizeof(e));
+        std::memcpy(e.name, assets[i].name.c_str(), assets[i].name.size() + 1);
+        e.type = assets[i].type;
+        offset = (offset + 15) & ~uint64_t(15);
+        e.offset = offset;
+        e.size = assets[i].data.size();
+        std::memcpy(e.params, assets[i].params, sizeof(e.params));
+        offset += e.size;
+    }
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    AssetPackHeader header{ASSET_PACK_MAGIC, ASSET_PACK_VERSION, static_cast<uint32_t>(assets.size()), 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(AssetPackEntry) * table.size()));
+    uint64_t written = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * table.size();
+    static const char padding[16] = {};
+    for (size_t i = 0; i < assets.size(); ++i) {
+        file.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+        file.write(reinterpret_cast<const char*>(assets[i].data.data()), static_cast<std::streamsize>(assets[i].data.size()));
+        written = table[i].offset + table[i].size;
+    }
+    return static_cast<bool>(file);
+}
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path root = ".";
+    std::string outPath = "assets.spak";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--root dir] [--out assets.spak]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SDL_SetMainReady();
+    JobSystem::instance().start(); // hitbox detection runs rows on the pool
+
+    std::vector<CookedAsset> assets;
+    int sprites = 0, sounds = 0;
+    for (const char* folder : {"sprites", "sounds"}) {
+        const bool isSprite = std::strcmp(folder, "sprites") == 0;
+        for (const auto& file : listFiles(root / folder, isSprite ? ".bmp" : ".wav")) {
+            std::string name = AssetPack::key(std::string(folder) + "/" + file.filename().string());
+            if (name.size() >= ASSET_PACK_NAME_SIZE) {
+                std::fprintf(stderr, "Warning: skipping '%s', name longer than %zu bytes\n", name.c_str(), ASSET_PACK_NAME_SIZE - 1);
+                continue;
+            }
+            if (isSprite && cookSprite(file, name, assets)) ++sprites;
+            if (!isSprite && cookSound(file, name, assets)) ++sounds;
+        }
+    }
+    JobSystem::instance().shutdown();
+
+    if (!writePack(outPath, assets)) {
+        std::fprintf(stderr, "Could not write '%s'\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("Cooked %d sprites and %d sounds into %s\n", sprites, sounds, outPath.c_str());
+    return 0;
+}
@@ -0,0 +1,455 @@
+// Headless benchmark for engine hot paths. Links the game headers and engine
+// sources without main.cpp, opens no window (SDL dummy video driver) and draws
+// into a software renderer backed by a plain surface.
+//
+//   StrandedBench                            # all scenarios, JSON on stdout
+//   StrandedBench --iterations 200 --out bench.json
+//   StrandedBench --only collision --colliders 4000
+//
+// Every scenario runs a few untimed warm-up iterations, then times each
+// iteration separately and reports mean, p50, p99, min and max in
+// milliseconds plus heap allocations and bytes per iteration (AllocTracker,
+// always built into this target, counts them on every thread). Inputs come
+// from --seed, so two runs with the same flags do the same work. Run it from
+// the build directory: sprites are loaded from ./sprites like in the game.
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <SDL_net.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "core/AllocTracker.hpp"
+#include "core/JobSystem.hpp"
+#include "game/Camera.hpp"
+#include "game/CollisionPhase.hpp"
+#include "game/GameObject.hpp"
+#include "game/IAnimatable.hpp"
+#include "game/ICollidable.hpp"
+#include "game/Lighting.hpp"
+#include "game/ParticleSystem.hpp"
+#include "game/Player.hpp"
+#include "game/SpriteCache.hpp"
+#include "game/TileLayer.hpp"
+#include "game/Tilemap.hpp"
+#include "game/World.hpp"
+#include "game/WorldGen.hpp"
+#include "net/Snapshot.hpp"
+
+// ---- Globals the game headers expect from main.cpp -----------------------------
+
+World gameObjects;
+Player* player = nullptr;
+std::unordered_map<uint32_t, Player*> remotePlayers;
+float g_sunIntensity = 1.0f;
+float g_lighthouseGlowBaseRadius = 60.0f;
+float g_lighthouseGlowExtraRadius = 120.0f;
+float g_lighthouseGlowIntensityMultiplier = 24.0f;
+float g_dayTimeSeconds = 0.0f;
+
+void hostBroadcastParticleForHook(const Vector2&) {}
+void openLighthouseShop() {}
+
+// ---- Harness ---------------------------------------------------------------------
+
+struct BenchConfig {
+    int iterations = 50;
+    int warmup = 3;
+    int chunks = 16;        // chunks planned and built per iteration
+    int particles = 20000;  // particles stepped per iteration
+    int colliders = 2000;   // colliders in the collision phase
+    int players = 64;       // players per snapshot
+    int sprites = 2000;     // objects drawn per frame
+    int lights = 256;       // lights in the night render scenario
+    int jobs = -1;          // worker threads, -1 = cores - 1
+    uint32_t seed = 1;
+    std::string only;       // run scenarios whose name contains this
+    std::string out;        // JSON file, stdout when empty
+    int width = 1280;
+    int height = 720;
+};
+
+struct Scenario {
+    std::string name;
+    int n;
+    std::function<void()> prepare; // untimed, before each iteration (may be empty)
+    std::function<void()> run;
+};
+
+struct ScenarioResult {
+    std::string name;
+    int n = 0;
+    std::vector<double> ms;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+// Nearest-rank percentile of an ascending list
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+static ScenarioResult runScenario(const Scenario& s, const BenchConfig& cfg) {
+    ScenarioResult r;
+    r.name = s.name;
+    r.n = s.n;
+    r.ms.reserve(cfg.iterations);
+    for (int i = 0; i < cfg.warmup; ++i) {
+        if (s.prepare) s.prepare();
+        s.run();
+    }
+    for (int i = 0; i < cfg.iterations; ++i) {
+        if (s.prepare) s.prepare();
+        AllocCounts before = AllocTracker::total();
+        auto start = std::chrono::steady_clock::now();
+        s.run();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        AllocCounts made = AllocTracker::total() - before;
+        r.allocs += made.allocs;
+        r.bytes += made.bytes;
+        r.ms.push_back(elapsed.count());
+    }
+    return r;
+}
+
+static nlohmann::json toJson(const ScenarioResult& r) {
+    std::vector<double> sorted = r.ms;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double t : sorted) sum += t;
+    double count = static_cast<double>(std::max<size_t>(sorted.size(), 1));
+    return {
+        {"name", r.name},
+        {"n", r.n},
+        {"iterations", sorted.size()},
+        {"mean_ms", sum / count},
+        {"p50_ms", percentile(sorted, 0.50)},
+        {"p99_ms", percentile(sorted, 0.99)},
+        {"min_ms", sorted.empty() ? 0.0 : sorted.front()},
+        {"max_ms", sorted.empty() ? 0.0 : sorted.back()},
+        {"allocs_per_iter", static_cast<double>(r.allocs) / count},
+        {"bytes_per_iter", static_cast<double>(r.bytes) / count},
+    };
+}
+
+static void deleteObjects(std::vector<GameObject*>& objs) {
+    for (GameObject* obj : objs) delete obj;
+    objs.clear();
+}
+
+// Planning logs every island candidate; the benchmark measures the work, not the logging
+static void silentLog(void*, int, SDL_LogPriority, const char*) {}
+
+static int parseInt(const char* s, int minimum) {
+    return std::max(minimum, std::atoi(s));
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--iterations" && hasValue) cfg.iterations = parseInt(argv[++i], 1);
+        else if (arg == "--warmup" && hasValue) cfg.warmup = parseInt(argv[++i], 0);
+        else if (arg == "--chunks" && hasValue) cfg.chunks = parseInt(argv[++i], 1);
+        else if (arg == "--particles" && hasValue) cfg.particles = parseInt(argv[++i], 1);
+        else if (arg == "--colliders" && hasValue) cfg.colliders = parseInt(argv[++i], 2);
+        else if (arg == "--players" && hasValue) cfg.players = parseInt(argv[++i], 1);
+        else if (arg == "--sprites" && hasValue) cfg.sprites = parseInt(argv[++i], 1);
+        else if (arg == "--lights" && hasValue) cfg.lights = parseInt(argv[++i], 0);
+        else if (arg == "--jobs" && hasValue) cfg.jobs = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) cfg.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--only" && hasValue) cfg.only = argv[++i];
+        else if (arg == "--out" && hasValue) cfg.out = argv[++i];
+        else {
+            std::fprintf(stderr,
+                "Usage: %s [--iterations n] [--warmup n] [--chunks n] [--particles n] [--colliders n]\n"
+                "          [--players n] [--sprites n] [--lights n] [--jobs n] [--seed n] [--only name] [--out file.json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    SDL_LogSetOutputFunction(silentLog, nullptr);
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, cfg.width, cfg.height, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        std::cerr << "Could not create software renderer: " << SDL_GetError() << "\n";
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Surface* tileSurface = SDL_LoadBMP("./sprites/water1.bmp");
+    if (!tileSurface) {
+        std::cerr << "Could not load ./sprites/water1.bmp (run from the build directory): " << SDL_GetError() << "\n";
+        SDL_Quit();
+        return 1;
+    }
+    int tileW = tileSurface->w, tileH = tileSurface->h;
+    SDL_Texture* tileTexture = SDL_CreateTextureFromSurface(renderer, tileSurface);
+    SDL_FreeSurface(tileSurface);
+
+    JobSystem::instance().start(cfg.jobs);
+
+    std::mt19937 rng(cfg.seed);
+    std::vector<Scenario> scenarios;
+
+    // World generation: plan N chunks on the job system, then create their objects
+    // the way buildEnvironment does (islands load their sprite and detect hitboxes)
+    std::vector<GameObject*> chunkObjects;
+    scenarios.push_back({"chunks", cfg.chunks,
+        [&] { deleteObjects(chunkObjects); },
+        [&] {
+            const int chunkSize = 512;
+            const int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(cfg.chunks)))));
+            std::vector<ChunkPlan> plans(cfg.chunks);
+            std::vector<Rectangle> areas(cfg.chunks);
+            std::vector<JobSystem::Handle> handles;
+            for (int i = 0; i < cfg.chunks; ++i) {
+                int cx = i % side, cy = i / side;
+                areas[i] = Rectangle{{cx * static_cast<float>(chunkSize), cy * static_cast<float>(chunkSize)},
+                                     {(cx + 1) * static_cast<float>(chunkSize), (cy + 1) * static_cast<float>(chunkSize)}};
+                uint32_t seed = ((static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u) ^ cfg.seed) | 1u;
+                handles.push_back(JobSystem::instance().submit([&plans, &areas, i, seed, tileW, tileH] {
+                    plans[i] = planChunk(areas[i], seed, tileW, tileH);
+                }));
+            }
+            JobSystem::instance().waitAll(handles);
+            for (const ChunkPlan& plan : plans) {
+                for (const Vector2& pos : plan.tiles) {
+                    chunkObjects.push_back(new GameObject(pos, {1.0f, 1.0f}, tileTexture, renderer, LAYER_ENVIRONMENT));
+                }
+                for (const Vector2& pos : plan.islands) {
+                    chunkObjects.push_back(new ICollidable(pos, {1.0f, 1.0f}, "./sprites/island.bmp", renderer, true, LAYER_ENVIRONMENT));
+                }
+            }
+        }});
+
+    // Particles: one long-lived burst stepped once per iteration
+    ParticleSystem particles(renderer);
+    particles.emitFromSeed(cfg.seed, {0.0f, 0.0f}, {4000.0f, 4000.0f}, cfg.particles, SDL_Color{255, 255, 255, 255}, 1.0e6f, LAYER_PARTICLE, 400.0f);
+    scenarios.push_back({"particles", cfg.particles, nullptr, [&] {
+        particles.update(1.0f / 60.0f);
+    }});
+
+    // Collision: a crowd of box colliders and complex islands jittered every
+    // iteration, so enter, stay and leave callbacks all show up
+    std::vector<GameObject*> colliderObjects;
+    std::vector<Vector2> colliderHome;
+    CollisionPairSet collisionPairs;
+    {
+        float extent = std::sqrt(static_cast<float>(cfg.colliders)) * 48.0f;
+        std::uniform_real_distribution<float> coord(0.0f, extent);
+        for (int i = 0; i < cfg.colliders; ++i) {
+            Vector2 pos{coord(rng), coord(rng)};
+            bool complex = i % 8 == 0;
+            colliderObjects.push_back(new ICollidable(pos, {1.0f, 1.0f}, complex ? "./sprites/island.bmp" : "./sprites/CollideTest.bmp",
+                                                      renderer, complex, LAYER_ENVIRONMENT));
+            colliderHome.push_back(pos);
+        }
+    }
+    std::uniform_real_distribution<float> jitter(-12.0f, 12.0f);
+    scenarios.push_back({"collision", cfg.colliders,
+        [&] {
+            for (size_t i = 0; i < colliderObjects.size(); ++i) {
+                colliderObjects[i]->setPosition({colliderHome[i].x + jitter(rng), colliderHome[i].y + jitter(rng)});
+            }
+        },
+        [&] { runCollisionPhase(colliderObjects, collisionPairs); }});
+
+    // Snapshots: split N players into datagrams and decode every part again
+    std::vector<PlayerState> playerStates(cfg.players);
+    {
+        std::uniform_real_distribution<float> coord(-2000.0f, 2000.0f);
+        for (int i = 0; i < cfg.players; ++i) {
+            PlayerState& s = playerStates[i];
+            s = PlayerState{};
+            s.id = static_cast<uint32_t>(i + 1);
+            s.x = coord(rng); s.y = coord(rng);
+            s.vx = coord(rng) * 0.01f; s.vy = coord(rng) * 0.01f;
+            s.isHooking = static_cast<uint8_t>(i % 3 == 0);
+        }
+    }
+    BoatState boatState{100.0f, 200.0f, 45.0f, 1.0f, 0.0f, 1};
+    uint32_t snapshotTick = 0;
+    size_t decodedPlayers = 0;
+    scenarios.push_back({"snapshot", cfg.players, nullptr, [&] {
+        std::vector<std::vector<uint8_t>> parts = buildSnapshotParts(++snapshotTick, &boatState, playerStates);
+        SnapshotPart part;
+        for (const std::vector<uint8_t>& data : parts) {
+            if (parseSnapshotPart(data.data(), data.size(), part)) decodedPlayers += part.players.size();
+        }
+    }});
+
+    // Hitbox detection, one scenario per sprite so regressions point at an image
+    std::vector<std::pair<std::string, SDL_Surface*>> spriteSurfaces;
+    {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("./sprites", ec)) {
+            if (entry.path().extension() != ".bmp") continue;
+            if (SDL_Surface* s = SDL_LoadBMP(entry.path().string().c_str())) {
+                spriteSurfaces.push_back({entry.path().filename().string(), s});
+            }
+        }
+        std::sort(spriteSurfaces.begin(), spriteSurfaces.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+    size_t hitboxCount = 0;
+    for (const auto& [file, surface] : spriteSurfaces) {
+        SDL_Surface* s = surface;
+        scenarios.push_back({"hitboxes/" + file, s->w * s->h, nullptr, [s, &hitboxCount] {
+            hitboxCount += ICollidable::autoDetectHitboxes(s).size();
+        }});
+    }
+
+    // Rendering: N sprites from the game's images scattered over the view, drawn by Camera
+    std::vector<GameObject*> sceneObjects;
+    {
+        const char* sceneSprites[] = {"./sprites/Fish.bmp", "./sprites/tree.bmp", "./sprites/coin.bmp", "./sprites/Boy.bmp", "./sprites/island2.bmp"};
+        std::vector<SDL_Texture*> textures;
+        for (const char* path : sceneSprites) {
+            if (SDL_Surface* s = SDL_LoadBMP(path)) {
+                textures.push_back(SDL_CreateTextureFromSurface(renderer, s));
+                SDL_FreeSurface(s);
+            }
+        }
+        textures.push_back(tileTexture);
+        std::uniform_real_distribution<float> x(-64.0f, static_cast<float>(cfg.width));
+        std::uniform_real_distribution<float> y(-64.0f, static_cast<float>(cfg.height));
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        for (int i = 0; i < cfg.sprites; ++i) {
+            GameObject* obj = new GameObject({x(rng), y(rng)}, {1.0f, 1.0f}, textures[i % textures.size()], renderer, i % 4);
+            obj->setRotation(i % 5 == 0 ? angle(rng) : 0.0f);
+            sceneObjects.push_back(obj);
+        }
+    }
+    // Owns render textures, so it goes before the renderer at the end
+    auto camera = std::make_unique<Camera>(Vector2{0.0f, 0.0f}, Vector2{static_cast<float>(cfg.width), static_cast<float>(cfg.height)}, 1.0f);
+    scenarios.push_back({"render", cfg.sprites, [] { g_sunIntensity = 1.0f; }, [&] {
+        camera->render(renderer, sceneObjects);
+        SDL_RenderPresent(renderer);
+    }});
+
+    // Same scene at night with N lights on the sprites, so the lightmap pass is included
+    std::vector<std::unique_ptr<Light>> sceneLights;
+    for (int i = 0; i < cfg.lights && i < static_cast<int>(sceneObjects.size()); ++i) {
+        Uint8 shade = static_cast<Uint8>(128 + (i * 37) % 128);
+        sceneLights.push_back(std::make_unique<Light>(sceneObjects[i], Vector2{0.5f, 0.5f}, 60.0f + (i % 7) * 15.0f,
+                                                      SDL_Color{255, shade, 160, 255}));
+    }
+    scenarios.push_back({"render/night", cfg.lights, [] { g_sunIntensity = 0.1f; }, [&] {
+        camera->render(renderer, sceneObjects);
+        SDL_RenderPresent(renderer);
+    }});
+
+    // Animation: N walking figures sharing one clip, each advanced by one 60 Hz frame
+    std::vector<GameObject*> animatedObjects;
+    {
+        const char* walkFrames[] = {"./sprites/Boy_Walk1.bmp", "./sprites/Boy_Walk2.bmp", "./sprites/Boy_Walk3.bmp", "./sprites/Boy_Walk4.bmp"};
+        for (int i = 0; i < cfg.sprites; ++i) {
+            animatedObjects.push_back(new IAnimatable({0.0f, 0.0f}, {2.0f, 2.0f}, walkFrames, 4, renderer, 0.1f, LAYER_PLAYER));
+        }
+    }
+    scenarios.push_back({"animate", cfg.sprites, nullptr, [&] {
+        for (GameObject* obj : animatedObjects) obj->update(1.0f / 60.0f);
+    }});
+
+    // Entity store: the sprites join the world, every other one leaves and comes back, then all leave
+    scenarios.push_back({"world/churn", cfg.sprites, nullptr, [&] {
+        for (GameObject* obj : sceneObjects) gameObjects.add(obj);
+        for (size_t i = 0; i < sceneObjects.size(); i += 2) gameObjects.remove(sceneObjects[i]);
+        for (size_t i = 0; i < sceneObjects.size(); i += 2) gameObjects.add(sceneObjects[i]);
+        for (GameObject* obj : sceneObjects) gameObjects.remove(obj);
+    }});
+
+    // Tilemap: a 100x100 tilemap.json layout, as the tileset editor writes it, read into cells
+    const int tilemapSide = 100;
+    std::string tilemapText;
+    {
+        nlohmann::json layout = {{"tileWidth", 16}, {"tileHeight", 16}, {"mapWidth", tilemapSide}, {"mapHeight", tilemapSide}};
+        nlohmann::json rows = nlohmann::json::array();
+        for (int y = 0; y < tilemapSide; ++y) {
+            nlohmann::json row = nlohmann::json::array();
+            for (int x = 0; x < tilemapSide; ++x) row.push_back({{"x", static_cast<int>(rng() % 8)}, {"y", static_cast<int>(rng() % 8)}});
+            rows.push_back(std::move(row));
+        }
+        layout["tiles"] = std::move(rows);
+        tilemapText = layout.dump(2);
+    }
+    size_t parsedTiles = 0;
+    scenarios.push_back({"tilemap/parse", tilemapSide * tilemapSide, nullptr, [&] {
+        Tilemap map;
+        if (Tilemap::parse(tilemapText, map)) parsedTiles += map.cells.size();
+    }});
+    // The same layout as one TileLayer over the water texture, drawn by Camera (cells in view only)
+    std::vector<GameObject*> tileLayerScene;
+    {
+        Tilemap map;
+        if (Tilemap::parse(tilemapText, map)) tileLayerScene.push_back(new TileLayer({0.0f, 0.0f}, std::move(map), tileTexture, renderer, LAYER_ENVIRONMENT));
+    }
+    scenarios.push_back({"tilemap/render", tilemapSide * tilemapSide, [] { g_sunIntensity = 1.0f; }, [&] {
+        camera->render(renderer, tileLayerScene);
+        SDL_RenderPresent(renderer);
+    }});
+
+    nlohmann::json results = nlohmann::json::array();
+    for (const Scenario& s : scenarios) {
+        if (!cfg.only.empty() && s.name.find(cfg.only) == std::string::npos) continue;
+        results.push_back(toJson(runScenario(s, cfg)));
+    }
+
+    nlohmann::json report = {
+        {"benchmark", "StrandedBench"},
+        {"workers", JobSystem::instance().getWorkerCount()},
+        {"seed", cfg.seed},
+        {"iterations", cfg.iterations},
+        {"warmup", cfg.warmup},
+        {"scenarios", results},
+        // Keeps the measured results observable so the work cannot be optimized away
+        {"checksum", decodedPlayers + hitboxCount + chunkObjects.size() + collisionPairs.size() + parsedTiles},
+    };
+    if (cfg.out.empty()) {
+        std::cout << report.dump(2) << "\n";
+    } else {
+        std::ofstream file(cfg.out);
+        if (!file) {
+            std::cerr << "Warning: could not write '" << cfg.out << "'\n";
+        } else {
+            file << report.dump(2) << "\n";
+            std::cout << "Wrote " << results.size() << " scenario results to " << cfg.out << "\n";
+        }
+    }
+
+    JobSystem::instance().shutdown();
+    deleteObjects(chunkObjects);
+    deleteObjects(colliderObjects);
+    sceneLights.clear();
+    deleteObjects(sceneObjects);
+    deleteObjects(animatedObjects);
+    deleteObjects(tileLayerScene);
+    for (auto& entry : spriteSurfaces) SDL_FreeSurface(entry.second);
+    camera.reset();
+    SpriteCache::instance().clear();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    SDL_Quit();
+    return 0;
+}
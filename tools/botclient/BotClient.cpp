@@ -0,0 +1,517 @@
+// Headless load generator: opens N UDP sockets against a running host and drives
+// each one like a real client (walking, boarding, casting, harpoon fire, AFRQ).
+// Reports per-bot bandwidth, snapshot rate and ping latency so the host's CPU and
+// bandwidth ceiling can be found on a single box over loopback.
+//
+//   StrandedBot --connect 127.0.0.1 7777 --bots 32 --duration 60
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <SDL_net.h>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <csignal>
+#include <deque>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "net/InputFrames.hpp"
+#include "net/NetSim.hpp"
+#include "net/Packets.hpp"
+#include "net/Snapshot.hpp"
+
+static std::atomic<bool> g_stop{false};
+
+struct BotConfig {
+    std::string hostName = "127.0.0.1";
+    int port = 7777;
+    int botCount = 8;
+    float durationSeconds = 60.0f; // 0 = run until interrupted
+    float inputHz = 60.0f;         // the real client sends one input frame per rendered frame
+    float pingHz = 2.0f;
+    float reportSeconds = 5.0f;
+    float afrqIntervalSeconds = 20.0f; // mean seconds between AFRQ requests per bot, 0 = never
+    uint32_t seed = 1;
+    std::string csvPath;
+    std::string netsimSpec;
+};
+
+struct BotStats {
+    uint64_t bytesOut = 0;
+    uint64_t bytesIn = 0;
+    uint64_t packetsOut = 0;
+    uint64_t packetsIn = 0;
+    uint64_t snapshots = 0;
+    uint64_t snapshotBytes = 0;
+    uint64_t pongs = 0;
+    double rttSumMs = 0.0;
+    double rttMinMs = 1e9;
+    double rttMaxMs = 0.0;
+
+    void addRtt(double ms) {
+        ++pongs;
+        rttSumMs += ms;
+        rttMinMs = std::min(rttMinMs, ms);
+        rttMaxMs = std::max(rttMaxMs, ms);
+    }
+};
+
+struct Bot {
+    int index = 0;
+    UDPsocket socket = nullptr;
+    uint32_t clientId = INVALID_CLIENT_ID; // assigned by the host in ACPT
+    uint32_t connectNonce = 0;
+    bool connected = false;
+    float connectTimer = 0.0f;
+    uint32_t inputSeq = 0;
+    std::deque<InputFrame> inputHistory; // newest first, resent with every input datagram
+    uint32_t pingSeq = 0;
+    std::mt19937 rng;
+
+    // Last known authoritative position (from snapshots)
+    float x = 0.0f;
+    float y = 0.0f;
+    bool hasPosition = false;
+
+    // Behaviour state
+    uint8_t moveFlags = 0;
+    float moveTimer = 0.0f;
+    float castTimer = 0.0f;
+    float boardTimer = 0.0f;
+    float equipTimer = 0.0f;
+    float afrqTimer = 0.0f;
+    uint8_t equipment = 0; // 0 = none, 1 = rod, 2 = harpoon
+    uint8_t pendingEquip = 1; // equip the rod on the first input
+
+    BotStats total;
+    BotStats window; // reset after each report
+};
+
+static uint64_t nowMicros() {
+    static const double toMicros = 1e6 / static_cast<double>(SDL_GetPerformanceFrequency());
+    return static_cast<uint64_t>(static_cast<double>(SDL_GetPerformanceCounter()) * toMicros);
+}
+
+static void printUsage() {
+    std::cout <<
+        "Usage: StrandedBot --connect <ip> <port> [options]\n"
+        "  --bots <n>            number of simulated clients (default 8)\n"
+        "  --duration <s>        run time in seconds, 0 = until Ctrl-C (default 60)\n"
+        "  --input-hz <hz>       input packets per second per bot (default 60)\n"
+        "  --ping-hz <hz>        latency probes per second per bot (default 2)\n"
+        "  --report <s>          seconds between progress reports (default 5)\n"
+        "  --afrq-interval <s>   mean seconds between attacking-fish requests, 0 = off (default 20)\n"
+        "  --seed <n>            behaviour RNG seed (default 1)\n"
+        "  --csv <path>          write the final per-bot summary as CSV\n"
+        "  --netsim <spec>       shape bot traffic: profile (lan, wan, intercontinental, lte, bad)\n"
+        "                        and/or latency=,jitter=,loss=,dup=,reorder=,kbps=,queue=,seed=\n";
+}
+
+static bool parseArgs(int argc, char* argv[], BotConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--connect" && i + 2 < argc) {
+            cfg.hostName = argv[++i];
+            cfg.port = std::stoi(argv[++i]);
+        } else if (arg == "--bots" && i + 1 < argc) {
+            cfg.botCount = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--duration" && i + 1 < argc) {
+            cfg.durationSeconds = std::stof(argv[++i]);
+        } else if (arg == "--input-hz" && i + 1 < argc) {
+            cfg.inputHz = std::max(1.0f, std::stof(argv[++i]));
+        } else if (arg == "--ping-hz" && i + 1 < argc) {
+            cfg.pingHz = std::max(0.0f, std::stof(argv[++i]));
+        } else if (arg == "--report" && i + 1 < argc) {
+            cfg.reportSeconds = std::max(0.5f, std::stof(argv[++i]));
+        } else if (arg == "--afrq-interval" && i + 1 < argc) {
+            cfg.afrqIntervalSeconds = std::max(0.0f, std::stof(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            cfg.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--csv" && i + 1 < argc) {
+            cfg.csvPath = argv[++i];
+        } else if (arg == "--netsim" && i + 1 < argc) {
+            cfg.netsimSpec = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else {
+            std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static float randRange(std::mt19937& rng, float lo, float hi) {
+    std::uniform_real_distribution<float> d(lo, hi);
+    return d(rng);
+}
+
+static void sendBytes(Bot& bot, UDPpacket* out, const IPaddress& host, const void* data, int len) {
+    std::memcpy(out->data, data, len);
+    out->len = len;
+    out->address = host;
+    if (NetSim::instance().send(bot.socket, out) > 0) {
+        bot.total.bytesOut += len; bot.window.bytesOut += len;
+        ++bot.total.packetsOut; ++bot.window.packetsOut;
+    }
+}
+
+// Advance the bot's behaviour by dt and emit one input frame (plus the redundant
+// older ones), mirroring sendInputPacket() in main.cpp
+static void sendInput(Bot& bot, UDPpacket* out, const IPaddress& host, float dt, const BotConfig& cfg) {
+    // Random walk: pick a new direction every 0.5-2s, sometimes standing still
+    bot.moveTimer -= dt;
+    if (bot.moveTimer <= 0.0f) {
+        bot.moveTimer = randRange(bot.rng, 0.5f, 2.0f);
+        std::uniform_int_distribution<int> dirDist(0, 15);
+        bot.moveFlags = static_cast<uint8_t>(dirDist(bot.rng));
+        // Opposing keys cancel out in Player::update; that is fine and realistic
+    }
+
+    InputFrame pkt{};
+    pkt.moveFlags = bot.moveFlags;
+
+    // Occasionally try to board or leave the boat (host ignores it when too far away)
+    bot.boardTimer -= dt;
+    if (bot.boardTimer <= 0.0f) {
+        bot.boardTimer = randRange(bot.rng, 8.0f, 25.0f);
+        pkt.boardBoat = 1;
+    }
+
+    // Swap between rod and harpoon every so often
+    bot.equipTimer -= dt;
+    if (bot.equipTimer <= 0.0f) {
+        bot.equipTimer = randRange(bot.rng, 10.0f, 30.0f);
+        bot.pendingEquip = (bot.equipment == 1) ? 2 : 1;
+    }
+    if (bot.pendingEquip) {
+        pkt.equipAction = bot.pendingEquip;
+        bot.equipment = bot.pendingEquip;
+        bot.pendingEquip = 0;
+    }
+
+    // Aim somewhere around the player
+    float angle = randRange(bot.rng, 0.0f, 6.2831853f);
+    float dist = randRange(bot.rng, 60.0f, 180.0f);
+    float targetX = bot.x + std::cos(angle) * dist;
+    float targetY = bot.y + std::sin(angle) * dist;
+    pkt.mouseX = static_cast<int32_t>(targetX);
+    pkt.mouseY = static_cast<int32_t>(targetY);
+    pkt.hookTargetX = static_cast<int32_t>(targetX);
+    pkt.hookTargetY = static_cast<int32_t>(targetY);
+    // Approximate rod tip: rod sits at local (-7,12) scaled x2 on the player
+    pkt.hookStartX = static_cast<int32_t>(bot.x - 7.0f + 8.0f);
+    pkt.hookStartY = static_cast<int32_t>(bot.y + 12.0f + 16.0f);
+
+    // Cast or fire (edge-triggered like the real client)
+    bot.castTimer -= dt;
+    if (bot.castTimer <= 0.0f) {
+        if (bot.equipment == 2) {
+            bot.castTimer = randRange(bot.rng, 0.6f, 2.5f);
+            pkt.mouseDown = 1;
+            pkt.fireWeapon = 1;
+            pkt.weaponTargetX = pkt.hookTargetX;
+            pkt.weaponTargetY = pkt.hookTargetY;
+        } else {
+            bot.castTimer = randRange(bot.rng, 3.0f, 8.0f);
+            pkt.mouseDown = 1;
+        }
+    }
+
+    bot.inputHistory.push_front(pkt);
+    if (bot.inputHistory.size() > INPUT_REDUNDANCY) bot.inputHistory.pop_back();
+    std::vector<uint8_t> bytes = buildInputPacket(bot.clientId, bot.inputSeq++, bot.inputHistory);
+    sendBytes(bot, out, host, bytes.data(), static_cast<int>(bytes.size()));
+
+    // Attacking fish requests (normally sent when the client rolls the attacking-fish minigame)
+    if (cfg.afrqIntervalSeconds > 0.0f) {
+        bot.afrqTimer -= dt;
+        if (bot.afrqTimer <= 0.0f) {
+            bot.afrqTimer = randRange(bot.rng, 0.5f, 1.5f) * cfg.afrqIntervalSeconds;
+            AttackingFishRequestPacket req{};
+            req.magic = MAGIC_AFRQ;
+            req.ownerId = bot.clientId;
+            req.x = targetX;
+            req.y = targetY;
+            sendBytes(bot, out, host, &req, sizeof(req));
+        }
+    }
+}
+
+// Repeat CONN every half second until the host accepts, like clientUpdateConnection() in main.cpp
+static void sendConnect(Bot& bot, UDPpacket* out, const IPaddress& host, float dt) {
+    bot.connectTimer -= dt;
+    if (bot.connectTimer > 0.0f) return;
+    bot.connectTimer = 0.5f;
+    ConnectPacket req{MAGIC_CONN, NET_PROTOCOL_VERSION, bot.connectNonce};
+    sendBytes(bot, out, host, &req, sizeof(req));
+}
+
+static void sendPing(Bot& bot, UDPpacket* out, const IPaddress& host) {
+    PingPacket ping{};
+    ping.magic = MAGIC_PING;
+    ping.clientId = bot.clientId;
+    ping.seq = bot.pingSeq++;
+    ping.sendTimeUs = nowMicros();
+    sendBytes(bot, out, host, &ping, sizeof(ping));
+}
+
+static void drainSocket(Bot& bot, UDPpacket* in) {
+    while (SDLNet_UDP_Recv(bot.socket, in) > 0) {
+        bot.total.bytesIn += in->len; bot.window.bytesIn += in->len;
+        ++bot.total.packetsIn; ++bot.window.packetsIn;
+        if (in->len < 4) continue;
+
+        uint32_t magic;
+        std::memcpy(&magic, in->data, sizeof(magic));
+        switch (magic) {
+            case MAGIC_PONG: {
+                if (in->len < static_cast<int>(sizeof(PingPacket))) break;
+                PingPacket pong;
+                std::memcpy(&pong, in->data, sizeof(pong));
+                double rttMs = static_cast<double>(nowMicros() - pong.sendTimeUs) / 1000.0;
+                bot.total.addRtt(rttMs);
+                bot.window.addRtt(rttMs);
+                break;
+            }
+            case MAGIC_PING: {
+                // The host probes every peer; answer like the game client does
+                if (in->len < static_cast<int>(sizeof(PingPacket))) break;
+                PingPacket ping;
+                std::memcpy(&ping, in->data, sizeof(ping));
+                ping.magic = MAGIC_PONG;
+                std::memcpy(in->data, &ping, sizeof(ping));
+                in->len = sizeof(ping);
+                if (NetSim::instance().send(bot.socket, in) > 0) {
+                    bot.total.bytesOut += in->len; bot.window.bytesOut += in->len;
+                    ++bot.total.packetsOut; ++bot.window.packetsOut;
+                }
+                break;
+            }
+            case MAGIC_ACPT: {
+                if (in->len < static_cast<int>(sizeof(AcceptPacket))) break;
+                AcceptPacket ack;
+                std::memcpy(&ack, in->data, sizeof(ack));
+                if (!bot.connected && ack.nonce == bot.connectNonce) {
+                    bot.clientId = ack.clientId;
+                    bot.connected = true;
+                }
+                break;
+            }
+            case MAGIC_DISC: {
+                if (in->len < static_cast<int>(sizeof(DisconnectPacket))) break;
+                DisconnectPacket disc;
+                std::memcpy(&disc, in->data, sizeof(disc));
+                if (disc.reason == DISCONNECT_VERSION_MISMATCH) {
+                    std::cerr << "Bot " << bot.index << ": host rejected protocol version " << NET_PROTOCOL_VERSION << "\n";
+                    g_stop = true;
+                } else if (disc.reason == DISCONNECT_HOST_SHUTDOWN || disc.clientId == bot.clientId) {
+                    // Session ended; start over with a fresh nonce
+                    bot.connected = false;
+                    bot.clientId = INVALID_CLIENT_ID;
+                    bot.connectNonce = bot.rng();
+                    bot.connectTimer = 0.0f;
+                    bot.inputHistory.clear();
+                }
+                break;
+            }
+            case MAGIC_SNAP: {
+                SnapshotPart part;
+                if (!parseSnapshotPart(in->data, static_cast<size_t>(in->len), part)) break;
+                // A tick may span several parts; count ticks by part 0 and bytes across all parts
+                if (part.header.partIndex == 0) { ++bot.total.snapshots; ++bot.window.snapshots; }
+                bot.total.snapshotBytes += in->len; bot.window.snapshotBytes += in->len;
+                for (const PlayerState& st : part.players) {
+                    if (st.id == bot.clientId) {
+                        bot.x = st.x;
+                        bot.y = st.y;
+                        bot.hasPosition = true;
+                        break;
+                    }
+                }
+                break;
+            }
+            case MAGIC_PART: case MAGIC_PPOS: case MAGIC_HKAR:
+            case MAGIC_AFSP: case MAGIC_FPRJ: case MAGIC_DAYT:
+            default:
+                break; // counted above; contents are irrelevant to the load test
+        }
+    }
+}
+
+static void printReport(const std::vector<Bot>& bots, double windowSeconds, double elapsed) {
+    uint64_t outBytes = 0, inBytes = 0, snaps = 0, pongs = 0;
+    double rttSum = 0.0, rttMax = 0.0;
+    size_t connected = 0;
+    for (const Bot& b : bots) {
+        if (b.connected) ++connected;
+        outBytes += b.window.bytesOut;
+        inBytes += b.window.bytesIn;
+        snaps += b.window.snapshots;
+        pongs += b.window.pongs;
+        rttSum += b.window.rttSumMs;
+        rttMax = std::max(rttMax, b.window.rttMaxMs);
+    }
+    double n = static_cast<double>(bots.size());
+    std::printf("[%7.1fs] bots=%zu/%zu  out=%7.1f kbps/bot  in=%8.1f kbps/bot  snapshots=%5.1f Hz/bot  rtt avg=%6.2f ms max=%6.2f ms\n",
+        elapsed, connected, bots.size(),
+        outBytes * 8.0 / 1000.0 / windowSeconds / n,
+        inBytes * 8.0 / 1000.0 / windowSeconds / n,
+        snaps / windowSeconds / n,
+        pongs ? rttSum / pongs : 0.0, rttMax);
+    std::fflush(stdout);
+}
+
+static void printSummary(const std::vector<Bot>& bots, double elapsed, const std::string& csvPath) {
+    std::printf("\n%-5s %-10s %10s %10s %9s %10s %9s %9s %9s\n",
+        "bot", "clientId", "out kbps", "in kbps", "snap Hz", "snap bytes", "rtt min", "rtt avg", "rtt max");
+    std::ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath);
+        csv << "bot,clientId,outKbps,inKbps,snapshotHz,avgSnapshotBytes,rttMinMs,rttAvgMs,rttMaxMs,packetsOut,packetsIn\n";
+    }
+    for (const Bot& b : bots) {
+        const BotStats& s = b.total;
+        double outKbps = s.bytesOut * 8.0 / 1000.0 / elapsed;
+        double inKbps = s.bytesIn * 8.0 / 1000.0 / elapsed;
+        double snapHz = s.snapshots / elapsed;
+        double snapBytes = s.snapshots ? static_cast<double>(s.snapshotBytes) / s.snapshots : 0.0;
+        double rttMin = s.pongs ? s.rttMinMs : 0.0;
+        double rttAvg = s.pongs ? s.rttSumMs / s.pongs : 0.0;
+        std::printf("%-5d %-10u %10.1f %10.1f %9.1f %10.0f %9.2f %9.2f %9.2f\n",
+            b.index, b.clientId, outKbps, inKbps, snapHz, snapBytes, rttMin, rttAvg, s.rttMaxMs);
+        if (csv.is_open()) {
+            csv << b.index << ',' << b.clientId << ',' << outKbps << ',' << inKbps << ',' << snapHz << ','
+                << snapBytes << ',' << rttMin << ',' << rttAvg << ',' << s.rttMaxMs << ','
+                << s.packetsOut << ',' << s.packetsIn << '\n';
+        }
+    }
+    if (csv.is_open()) std::cout << "Wrote " << csvPath << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    BotConfig cfg;
+    if (!parseArgs(argc, argv, cfg)) {
+        printUsage();
+        return 1;
+    }
+
+    SDL_SetMainReady();
+    if (!cfg.netsimSpec.empty()) {
+        if (!NetSim::instance().configure(cfg.netsimSpec)) return 1;
+        NetSim::instance().setSeed(cfg.seed);
+    }
+    if (SDLNet_Init() < 0) {
+        std::cerr << "SDLNet_Init failed: " << SDLNet_GetError() << "\n";
+        return 1;
+    }
+
+    IPaddress hostAddr;
+    if (SDLNet_ResolveHost(&hostAddr, cfg.hostName.c_str(), static_cast<Uint16>(cfg.port)) < 0) {
+        std::cerr << "ResolveHost failed: " << SDLNet_GetError() << "\n";
+        SDLNet_Quit();
+        return 1;
+    }
+
+    std::signal(SIGINT, [](int) { g_stop = true; });
+
+    std::vector<Bot> bots(cfg.botCount);
+    for (int i = 0; i < cfg.botCount; ++i) {
+        Bot& b = bots[i];
+        b.index = i;
+        b.rng.seed(cfg.seed * 7919u + static_cast<uint32_t>(i));
+        b.socket = SDLNet_UDP_Open(0);
+        if (!b.socket) {
+            std::cerr << "UDP_Open failed for bot " << i << ": " << SDLNet_GetError() << "\n";
+            bots.resize(i);
+            break;
+        }
+        b.connectNonce = b.rng();
+        // Stagger timers so bots do not act in lock-step
+        b.castTimer = randRange(b.rng, 0.5f, 4.0f);
+        b.boardTimer = randRange(b.rng, 2.0f, 20.0f);
+        b.equipTimer = randRange(b.rng, 5.0f, 30.0f);
+        b.afrqTimer = randRange(b.rng, 0.2f, 1.0f) * std::max(1.0f, cfg.afrqIntervalSeconds);
+    }
+    if (bots.empty()) {
+        SDLNet_Quit();
+        return 1;
+    }
+    std::cout << "Driving " << bots.size() << " bots against " << cfg.hostName << ":" << cfg.port
+              << " at " << cfg.inputHz << " Hz input\n";
+
+    UDPpacket* out = SDLNet_AllocPacket(NET_MTU);
+    UDPpacket* in = SDLNet_AllocPacket(NET_MTU);
+
+    const uint64_t start = nowMicros();
+    const uint64_t inputInterval = static_cast<uint64_t>(1e6 / cfg.inputHz);
+    const uint64_t pingInterval = cfg.pingHz > 0.0f ? static_cast<uint64_t>(1e6 / cfg.pingHz) : 0;
+    const uint64_t reportInterval = static_cast<uint64_t>(cfg.reportSeconds * 1e6);
+    uint64_t nextInput = start;
+    uint64_t nextPing = start;
+    uint64_t lastReport = start;
+    uint64_t lastInput = start;
+
+    while (!g_stop) {
+        uint64_t now = nowMicros();
+        double elapsed = (now - start) / 1e6;
+        if (cfg.durationSeconds > 0.0f && elapsed >= cfg.durationSeconds) break;
+
+        NetSim::instance().pump();
+        for (Bot& b : bots) drainSocket(b, in);
+
+        if (now >= nextInput) {
+            float dt = static_cast<float>((now - lastInput) / 1e6);
+            lastInput = now;
+            for (Bot& b : bots) {
+                if (b.connected) sendInput(b, out, hostAddr, dt, cfg);
+                else sendConnect(b, out, hostAddr, dt);
+            }
+            nextInput += inputInterval;
+            if (nextInput < now) nextInput = now + inputInterval; // fell behind; don't burst
+        }
+
+        if (pingInterval && now >= nextPing) {
+            for (Bot& b : bots) {
+                if (b.connected) sendPing(b, out, hostAddr);
+            }
+            nextPing += pingInterval;
+            if (nextPing < now) nextPing = now + pingInterval;
+        }
+
+        if (now - lastReport >= reportInterval) {
+            printReport(bots, (now - lastReport) / 1e6, elapsed);
+            for (Bot& b : bots) b.window = BotStats{};
+            lastReport = now;
+        }
+
+        SDL_Delay(1);
+    }
+
+    // Leave cleanly so the host frees our players right away
+    for (Bot& b : bots) {
+        if (!b.connected) continue;
+        DisconnectPacket disc{MAGIC_DISC, b.clientId, DISCONNECT_QUIT};
+        sendBytes(b, out, hostAddr, &disc, sizeof(disc));
+    }
+
+    NetSim::instance().flush();
+
+    double elapsed = std::max(1e-3, (nowMicros() - start) / 1e6);
+    printSummary(bots, elapsed, cfg.csvPath);
+    if (NetSim::instance().isEnabled()) std::cout << NetSim::instance().describe() << "\n";
+
+    SDLNet_FreePacket(in);
+    SDLNet_FreePacket(out);
+    for (Bot& b : bots) {
+        if (b.socket) SDLNet_UDP_Close(b.socket);
+    }
+    SDLNet_Quit();
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Stress benchmark for the job system: runs the same workloads with 0..N worker
+// threads and prints wall time and speedup against the main-thread-only run.
+//
+//   StrandedJobBench                 # worker counts 0, 1, 2, 4, ... up to cores - 1
+//   StrandedJobBench --workers 0,3,7 --rounds 20
+//
+// Workloads mirror what the game hands to the pool: chunk layout planning,
+// the collision pair tests, particle updates and a fan-out/fan-in dependency graph
+// of tiny jobs (scheduling overhead).
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/JobSystem.hpp"
+#include "game/Rectangle.hpp"
+#include "game/WorldGen.hpp"
+
+struct BenchConfig {
+    std::vector<int> workerCounts;
+    int rounds = 10;
+    int chunks = 64;          // chunk plans per round
+    int colliders = 3000;     // boxes in the pair test
+    int particles = 200000;   // particles stepped per round
+    int graphWidth = 2000;    // jobs per fan-out layer
+    int graphDepth = 8;
+    uint32_t seed = 1;
+};
+
+struct Workload {
+    const char* name;
+    std::function<void(JobSystem&, int round)> run;
+};
+
+// Planning logs every island candidate; the benchmark measures planning, not logging
+static void silentLog(void*, int, SDL_LogPriority, const char*) {}
+
+static double runTimed(JobSystem& jobs, const Workload& w, int rounds) {
+    w.run(jobs, -1); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) w.run(jobs, r);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--workers" && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                if (!item.empty()) cfg.workerCounts.push_back(std::max(0, std::stoi(item)));
+            }
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            cfg.rounds = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--chunks" && i + 1 < argc) {
+            cfg.chunks = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--colliders" && i + 1 < argc) {
+            cfg.colliders = std::max(2, std::stoi(argv[++i]));
+        } else if (arg == "--particles" && i + 1 < argc) {
+            cfg.particles = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            cfg.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--workers 0,1,2,...] [--rounds n] [--chunks n] [--colliders n] [--particles n] [--seed n]\n", argv[0]);
+            return 1;
+        }
+    }
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    if (cfg.workerCounts.empty()) {
+        cfg.workerCounts.push_back(0);
+        for (unsigned n = 1; n < hw; n *= 2) cfg.workerCounts.push_back(static_cast<int>(n));
+        if (hw > 1 && cfg.workerCounts.back() != static_cast<int>(hw - 1)) cfg.workerCounts.push_back(static_cast<int>(hw - 1));
+    }
+    SDL_LogSetOutputFunction(silentLog, nullptr);
+
+    // Shared inputs, generated once so every worker count sees the same data
+    std::mt19937 rng(cfg.seed);
+    std::uniform_real_distribution<float> coord(-4000.0f, 4000.0f);
+    std::uniform_real_distribution<float> extent(8.0f, 96.0f);
+    std::vector<Rectangle> boxes(cfg.colliders);
+    for (Rectangle& b : boxes) {
+        b.begin = {coord(rng), coord(rng)};
+        b.end = {b.begin.x + extent(rng), b.begin.y + extent(rng)};
+    }
+    struct BenchParticle { float x, y, vx, vy, age; };
+    std::vector<BenchParticle> particles(cfg.particles);
+    for (BenchParticle& p : particles) p = {coord(rng), coord(rng), extent(rng), extent(rng), 0.0f};
+
+    std::vector<size_t> planChecksums(cfg.chunks);
+    std::vector<uint64_t> pairCounts(boxes.size());
+    std::vector<Workload> workloads = {
+        {"chunk plans", [&](JobSystem& jobs, int round) {
+            std::vector<JobSystem::Handle> handles;
+            for (int i = 0; i < cfg.chunks; ++i) {
+                int cx = i % 8 + round * 8, cy = i / 8;
+                Rectangle area{{cx * 512.0f, cy * 512.0f}, {(cx + 1) * 512.0f, (cy + 1) * 512.0f}};
+                uint32_t seed = (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u) ^ 0x9E3779B9u ^ cfg.seed;
+                handles.push_back(jobs.submit([&planChecksums, i, area, seed] {
+                    ChunkPlan plan = planChunk(area, seed | 1u, 8, 8);
+                    planChecksums[i] = plan.tiles.size() + plan.islands.size();
+                }));
+            }
+            jobs.waitAll(handles);
+        }},
+        {"collision pairs", [&](JobSystem& jobs, int) {
+            jobs.parallelFor(boxes.size(), 16, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    uint64_t hits = 0;
+                    for (size_t j = i + 1; j < boxes.size(); ++j) {
+                        if (boxes[i].intersects(boxes[j])) ++hits;
+                    }
+                    pairCounts[i] = hits;
+                }
+            });
+        }},
+        {"particle update", [&](JobSystem& jobs, int) {
+            jobs.parallelFor(particles.size(), 256, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    BenchParticle& p = particles[i];
+                    p.age += 1.0f / 60.0f;
+                    float wobble = std::sin(p.age * 3.0f + p.x * 0.01f) * 4.0f;
+                    p.x += p.vx / 60.0f + wobble;
+                    p.y += p.vy / 60.0f - wobble;
+                }
+            });
+        }},
+        {"job graph", [&](JobSystem& jobs, int) {
+            std::vector<JobSystem::Handle> layer;
+            for (int d = 0; d < cfg.graphDepth; ++d) {
+                // Each layer fans out from a join of the previous one
+                JobSystem::Handle join = layer.empty() ? nullptr : jobs.submit([] {}, layer);
+                layer.clear();
+                for (int i = 0; i < cfg.graphWidth; ++i) {
+                    layer.push_back(jobs.submit([] {}, {join}));
+                }
+            }
+            jobs.waitAll(layer);
+        }},
+    };
+
+    std::printf("job system benchmark: %u hardware threads, %d rounds\n", hw, cfg.rounds);
+    std::printf("%-16s", "workload");
+    for (int w : cfg.workerCounts) std::printf("   %2d workers", w);
+    std::printf("\n");
+
+    for (const Workload& w : workloads) {
+        std::vector<double> ms;
+        for (int workers : cfg.workerCounts) {
+            JobSystem& jobs = JobSystem::instance();
+            jobs.start(workers);
+            ms.push_back(runTimed(jobs, w, cfg.rounds));
+            jobs.shutdown();
+        }
+        std::printf("%-16s", w.name);
+        for (double t : ms) std::printf(" %9.2f ms", t);
+        std::printf("\n%-16s", "  speedup");
+        for (double t : ms) std::printf("   %8.2fx", t > 0.0 ? ms[0] / t : 0.0);
+        std::printf("\n");
+    }
+
+    uint64_t checksum = 0;
+    for (size_t c : planChecksums) checksum += c;
+    for (uint64_t c : pairCounts) checksum += c;
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}